@@ -0,0 +1,481 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file HybridTransportBenchmark.cpp
+ * \brief Transfer a field from a deterministic mesh to a Monte Carlo mesh.
+ *
+ * The field is known at the cell centers and at the nodes of the deterministic
+ * mesh and is transferred to the cell centers of the Monte Carlo mesh with the
+ * nearest neighbor operator, the moving least squares operators with a linear
+ * and a quadratic basis, and the finite element interpolation. For each of
+ * them, the setup and the apply times, the bytes moved by an application and
+ * the error are appended to a file in the format read by
+ * scripts/performance_plot.py.
+ */
+//---------------------------------------------------------------------------//
+
+#include "DTK_Benchmark_DeterministicMesh.hpp"
+#include "DTK_Benchmark_MonteCarloMesh.hpp"
+
+#include <ArborX.hpp>
+#include <DTK_CellTypes.h>
+#include <DTK_Core.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_FETypes.h>
+#include <DTK_Interpolation.hpp>
+#include <DTK_Mesh.hpp>
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_DefaultMpiComm.hpp>
+
+#include <mpi.h>
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using DeviceType = Kokkos::View<DataTransferKit::Coordinate **>::device_type;
+using ExecutionSpace = DeviceType::execution_space;
+
+//---------------------------------------------------------------------------//
+// Field transferred between the meshes. It is trilinear so that the finite
+// element interpolation and the quadratic moving least squares reproduce it
+// exactly.
+KOKKOS_INLINE_FUNCTION double field( double x, double y, double z )
+{
+    return 1. + x + 2. * y + 3. * z + x * y;
+}
+
+//---------------------------------------------------------------------------//
+// Costs and accuracy of a transfer. The times are in microseconds and are
+// those of the slowest rank. The bytes are summed over all the ranks.
+struct Result
+{
+    std::string name;
+    double setup_time;
+    double apply_time;
+    double bytes;
+    double error;
+};
+
+//---------------------------------------------------------------------------//
+// Time spent by the slowest rank of comm in function.
+template <typename Function>
+double timeCollective( MPI_Comm comm, Function const &function )
+{
+    MPI_Barrier( comm );
+    auto const start = std::chrono::steady_clock::now();
+    function();
+    Kokkos::fence();
+    std::chrono::duration<double, std::micro> const elapsed =
+        std::chrono::steady_clock::now() - start;
+    double local_time = elapsed.count();
+    double time;
+    MPI_Allreduce( &local_time, &time, 1, MPI_DOUBLE, MPI_MAX, comm );
+    return time;
+}
+
+//---------------------------------------------------------------------------//
+// Value of the field at the points.
+Kokkos::View<double *, DeviceType>
+evaluateField( Kokkos::View<DataTransferKit::Coordinate **, DeviceType> points )
+{
+    int const n_points = points.extent( 0 );
+    Kokkos::View<double *, DeviceType> values(
+        Kokkos::ViewAllocateWithoutInitializing( "values" ), n_points );
+    Kokkos::parallel_for(
+        "evaluate_field", Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+        KOKKOS_LAMBDA( int i ) {
+            values( i ) =
+                field( points( i, 0 ), points( i, 1 ), points( i, 2 ) );
+        } );
+    Kokkos::fence();
+    return values;
+}
+
+//---------------------------------------------------------------------------//
+// Largest difference over all the ranks of comm between the values and the
+// field. values(i) is the value at the point point_ids(i). Negative ids,
+// i.e. points that were not found, are skipped.
+double
+maxError( MPI_Comm comm,
+          Kokkos::View<DataTransferKit::Coordinate **, DeviceType> points,
+          Kokkos::View<double *, Kokkos::LayoutStride, DeviceType> values,
+          Kokkos::View<int *, DeviceType> point_ids )
+{
+    double local_error = 0.;
+    Kokkos::parallel_reduce(
+        "compute_error",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, point_ids.extent( 0 ) ),
+        KOKKOS_LAMBDA( int i, double &error ) {
+            int const k = point_ids( i );
+            if ( k < 0 )
+                return;
+            double const diff =
+                values( i ) - field( points( k, 0 ), points( k, 1 ),
+                                     points( k, 2 ) );
+            double const abs_diff = diff < 0. ? -diff : diff;
+            if ( abs_diff > error )
+                error = abs_diff;
+        },
+        Kokkos::Max<double>( local_error ) );
+    double error;
+    MPI_Allreduce( &local_error, &error, 1, MPI_DOUBLE, MPI_MAX, comm );
+    return error;
+}
+
+//---------------------------------------------------------------------------//
+// Transfer the field from the source points to the target points with one of
+// the point cloud operators.
+template <typename Operator>
+Result benchmarkPointCloudOperator(
+    std::string const &name, MPI_Comm comm,
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> source_points,
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> target_points,
+    int num_applications )
+{
+    Result result;
+    result.name = name;
+
+    std::unique_ptr<Operator> op;
+    result.setup_time = timeCollective( comm, [&]() {
+        op.reset( new Operator( comm, source_points, target_points ) );
+    } );
+
+    auto source_values = evaluateField( source_points );
+    Kokkos::View<double *, DeviceType> target_values(
+        "target_values", target_points.extent( 0 ) );
+    auto const bytes_sent = op->statistics().bytes_sent;
+    auto const apply = [&]() {
+        for ( int i = 0; i < num_applications; ++i )
+            op->apply( source_values, target_values );
+    };
+    result.apply_time = timeCollective( comm, apply ) / num_applications;
+
+    double local_bytes =
+        static_cast<double>( op->statistics().bytes_sent - bytes_sent ) /
+        num_applications;
+    MPI_Allreduce( &local_bytes, &result.bytes, 1, MPI_DOUBLE, MPI_SUM, comm );
+
+    Kokkos::View<int *, DeviceType> point_ids(
+        Kokkos::ViewAllocateWithoutInitializing( "point_ids" ),
+        target_points.extent( 0 ) );
+    ArborX::iota( point_ids );
+    result.error = maxError( comm, target_points, target_values, point_ids );
+
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+// Interpolate the field known at the nodes of the source mesh with trilinear
+// finite elements.
+Result benchmarkInterpolation(
+    MPI_Comm comm, DataTransferKit::Benchmark::CartesianMesh const &source_mesh,
+    Kokkos::View<DataTransferKit::Coordinate **, DeviceType> target_points,
+    int num_applications )
+{
+    Result result;
+    result.name = "fe_interpolation";
+
+    auto const connectivity = source_mesh.localCellConnectivity();
+    int const n_cells = connectivity.extent( 0 );
+    int const n_nodes_per_cell = connectivity.extent( 1 );
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies(
+        "cell_topologies", n_cells );
+    Kokkos::deep_copy( cell_topologies, DTK_HEX_8 );
+    Kokkos::View<unsigned int *, DeviceType> cells(
+        "cells", n_cells * n_nodes_per_cell );
+    Kokkos::View<DataTransferKit::LocalOrdinal *, DeviceType> cell_dof_ids(
+        "cell_dof_ids", n_cells * n_nodes_per_cell );
+    Kokkos::parallel_for(
+        "flatten_connectivity",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
+        KOKKOS_LAMBDA( int i ) {
+            for ( int j = 0; j < n_nodes_per_cell; ++j )
+            {
+                cells( i * n_nodes_per_cell + j ) = connectivity( i, j );
+                cell_dof_ids( i * n_nodes_per_cell + j ) = connectivity( i, j );
+            }
+        } );
+    Kokkos::fence();
+    auto const nodes = source_mesh.localNodeCoordinates();
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies, cells, nodes );
+
+    std::unique_ptr<DataTransferKit::Interpolation<DeviceType>> interpolation;
+    result.setup_time = timeCollective( comm, [&]() {
+        interpolation.reset( new DataTransferKit::Interpolation<DeviceType>(
+            comm, mesh, target_points, cell_dof_ids, DTK_HGRAD ) );
+    } );
+
+    auto const node_values = evaluateField( nodes );
+    Kokkos::View<double **, DeviceType> source_values(
+        "source_values", node_values.extent( 0 ), 1 );
+    Kokkos::deep_copy( Kokkos::subview( source_values, Kokkos::ALL, 0 ),
+                       node_values );
+    Kokkos::View<double **, DeviceType> target_values(
+        "target_values", target_points.extent( 0 ), 1 );
+    Kokkos::View<int *, DeviceType> point_ids( "point_ids" );
+    auto const apply = [&]() {
+        for ( int i = 0; i < num_applications; ++i )
+            point_ids = interpolation->apply( source_values, target_values );
+    };
+    result.apply_time = timeCollective( comm, apply ) / num_applications;
+
+    // Each point found sends back its value and its id. The duplicates of the
+    // points found in several cells are not counted.
+    int n_found = 0;
+    Kokkos::parallel_reduce(
+        "count_found_points",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, point_ids.extent( 0 ) ),
+        KOKKOS_LAMBDA( int i, int &count ) {
+            if ( point_ids( i ) >= 0 )
+                ++count;
+        },
+        n_found );
+    double local_bytes = static_cast<double>( n_found ) *
+                         ( sizeof( double ) + sizeof( unsigned int ) );
+    MPI_Allreduce( &local_bytes, &result.bytes, 1, MPI_DOUBLE, MPI_SUM, comm );
+
+    result.error = maxError(
+        comm, target_points,
+        Kokkos::subview( target_values, Kokkos::ALL, 0 ), point_ids );
+
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+// Split the blocks of the Monte Carlo mesh evenly along the three directions.
+std::vector<std::vector<double>> boundaryMesh( int num_blocks, double length )
+{
+    std::vector<int> num_dir_blocks( 3, 1 );
+    for ( int factor = 2; num_blocks > 1; )
+    {
+        if ( num_blocks % factor != 0 )
+        {
+            ++factor;
+            continue;
+        }
+        auto dir =
+            std::min_element( num_dir_blocks.begin(), num_dir_blocks.end() );
+        *dir *= factor;
+        num_blocks /= factor;
+    }
+
+    std::vector<std::vector<double>> bnd_mesh( 3 );
+    for ( int d = 0; d < 3; ++d )
+        for ( int b = 0; b <= num_dir_blocks[d]; ++b )
+            bnd_mesh[d].push_back( b * length / num_dir_blocks[d] );
+    return bnd_mesh;
+}
+
+//---------------------------------------------------------------------------//
+// Append the results of a run to the file read by performance_plot.py. The
+// header holds the number of benchmarks, their titles, and the names of the
+// columns. Each run is a row with the commit hash, a row with the build
+// number, and a row per benchmark.
+void writeResults( std::string const &filename, std::string const &commit,
+                   std::string const &build, std::string const &description,
+                   std::vector<Result> const &results )
+{
+    std::ostringstream header;
+    header << results.size() << '\n';
+    for ( auto const &result : results )
+        header << result.name << ' ' << description << '\n';
+    header << "setup_time apply_time bytes error\n";
+
+    std::string existing_header;
+    {
+        std::ifstream file( filename );
+        std::string line;
+        for ( std::size_t i = 0;
+              i < results.size() + 2 && std::getline( file, line ); ++i )
+            existing_header += line + '\n';
+    }
+    // Benchmarks of different sizes cannot be plotted together.
+    DTK_INSIST( existing_header.empty() || existing_header == header.str() );
+
+    std::ofstream file( filename, std::ios::app );
+    DTK_INSIST( file.good() );
+    if ( existing_header.empty() )
+        file << header.str();
+    file << commit << '\n' << build << '\n';
+    for ( auto const &result : results )
+        file << result.setup_time << ',' << result.apply_time << ','
+             << result.bytes << ',' << result.error << '\n';
+}
+
+//---------------------------------------------------------------------------//
+void printUsage( char const *executable )
+{
+    std::cout
+        << "Usage: " << executable << " [options]\n"
+        << "  --deterministic-cells N  cells per direction of the "
+           "deterministic mesh (default 32)\n"
+        << "  --monte-carlo-cells N    cells per direction of the Monte "
+           "Carlo mesh (default 24)\n"
+        << "  --sets N                 replications of the Monte Carlo "
+           "mesh (default 1)\n"
+        << "  --applications N         applications timed per transfer "
+           "(default 10)\n"
+        << "  --output FILE            file the results are appended to "
+           "(default hybrid_transport_benchmark.txt)\n"
+        << "  --commit HASH            commit recorded with the results\n"
+        << "  --build NUMBER           build number recorded with the "
+           "results\n";
+}
+
+//---------------------------------------------------------------------------//
+int main( int argc, char *argv[] )
+{
+    MPI_Init( &argc, &argv );
+    DataTransferKit::initialize( &argc, &argv );
+
+    int deterministic_cells = 32;
+    int monte_carlo_cells = 24;
+    int num_sets = 1;
+    int num_applications = 10;
+    std::string output = "hybrid_transport_benchmark.txt";
+    std::string commit = "unknown";
+    std::string build = "0";
+
+    static option const long_options[] = {
+        {"deterministic-cells", required_argument, nullptr, 'd'},
+        {"monte-carlo-cells", required_argument, nullptr, 'm'},
+        {"sets", required_argument, nullptr, 's'},
+        {"applications", required_argument, nullptr, 'a'},
+        {"output", required_argument, nullptr, 'o'},
+        {"commit", required_argument, nullptr, 'c'},
+        {"build", required_argument, nullptr, 'b'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}};
+    int opt;
+    while ( ( opt = getopt_long( argc, argv, "d:m:s:a:o:c:b:h", long_options,
+                                 nullptr ) ) != -1 )
+    {
+        switch ( opt )
+        {
+        case 'd':
+            deterministic_cells = std::atoi( optarg );
+            break;
+        case 'm':
+            monte_carlo_cells = std::atoi( optarg );
+            break;
+        case 's':
+            num_sets = std::atoi( optarg );
+            break;
+        case 'a':
+            num_applications = std::atoi( optarg );
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 'c':
+            commit = optarg;
+            break;
+        case 'b':
+            build = optarg;
+            break;
+        default:
+            printUsage( argv[0] );
+            DataTransferKit::finalize();
+            MPI_Finalize();
+            return EXIT_FAILURE;
+        }
+    }
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    DTK_INSIST( deterministic_cells > 0 && monte_carlo_cells > 0 );
+    DTK_INSIST( num_sets > 0 && comm_size % num_sets == 0 );
+    DTK_INSIST( num_applications > 0 );
+
+    // Both meshes discretize the unit cube.
+    Teuchos::RCP<const Teuchos::Comm<int>> teuchos_comm =
+        Teuchos::rcp( new Teuchos::MpiComm<int>( comm ) );
+    double const deterministic_delta = 1. / deterministic_cells;
+    DataTransferKit::Benchmark::DeterministicMesh deterministic_mesh(
+        teuchos_comm, deterministic_cells, deterministic_cells,
+        deterministic_cells, deterministic_delta, deterministic_delta,
+        deterministic_delta );
+    auto const bnd_mesh = boundaryMesh( comm_size / num_sets, 1. );
+    double const monte_carlo_delta = 1. / monte_carlo_cells;
+    // The targets are only used through their cell centers.
+    bool const cell_centers_only = true;
+    DataTransferKit::Benchmark::MonteCarloMesh monte_carlo_mesh(
+        teuchos_comm, num_sets, monte_carlo_cells, monte_carlo_cells,
+        monte_carlo_cells, monte_carlo_delta, monte_carlo_delta,
+        monte_carlo_delta, bnd_mesh[0], bnd_mesh[1], bnd_mesh[2],
+        cell_centers_only );
+
+    auto const source_mesh = deterministic_mesh.cartesianMesh();
+    auto const source_points = source_mesh->localCellCenterCoordinates();
+    auto const target_points =
+        monte_carlo_mesh.cartesianMesh()->localCellCenterCoordinates();
+
+    using Wendland0 = DataTransferKit::Wendland<0>;
+    using Quadratic3 =
+        DataTransferKit::MultivariatePolynomialBasis<DataTransferKit::Quadratic,
+                                                     3>;
+    std::vector<Result> results;
+    results.push_back( benchmarkPointCloudOperator<
+                       DataTransferKit::NearestNeighborOperator<DeviceType>>(
+        "nearest_neighbor", comm, source_points, target_points,
+        num_applications ) );
+    results.push_back( benchmarkPointCloudOperator<
+                       DataTransferKit::MovingLeastSquaresOperator<DeviceType>>(
+        "moving_least_squares_linear", comm, source_points, target_points,
+        num_applications ) );
+    results.push_back(
+        benchmarkPointCloudOperator<DataTransferKit::MovingLeastSquaresOperator<
+            DeviceType, Wendland0, Quadratic3>>(
+            "moving_least_squares_quadratic", comm, source_points,
+            target_points, num_applications ) );
+    results.push_back( benchmarkInterpolation(
+        comm, *source_mesh, target_points, num_applications ) );
+
+    if ( comm_rank == 0 )
+    {
+        std::ostringstream description;
+        description << deterministic_cells << "^3 to " << monte_carlo_cells
+                    << "^3 cells on " << comm_size << " ranks with "
+                    << num_sets << " sets";
+        writeResults( output, commit, build, description.str(), results );
+
+        std::cout << "Transfer from " << description.str() << '\n';
+        for ( auto const &result : results )
+            std::cout << result.name << ": setup " << result.setup_time
+                      << " us, apply " << result.apply_time << " us, "
+                      << result.bytes << " bytes, error " << result.error
+                      << '\n';
+    }
+
+    DataTransferKit::finalize();
+    MPI_Finalize();
+    return EXIT_SUCCESS;
+}
+
+//---------------------------------------------------------------------------//
+// end HybridTransportBenchmark.cpp
+//---------------------------------------------------------------------------//
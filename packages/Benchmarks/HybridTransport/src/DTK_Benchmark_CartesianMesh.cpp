@@ -16,10 +16,142 @@
 
 #include "DTK_Benchmark_CartesianMesh.hpp"
 
+#include <string>
+
 namespace DataTransferKit
 {
 namespace Benchmark
 {
+//---------------------------------------------------------------------------//
+// The kernels are free functions because lambda functions cannot be defined
+// in a constructor in CUDA.
+//---------------------------------------------------------------------------//
+namespace
+{
+using ExecutionSpace = Kokkos::View<Coordinate *>::execution_space;
+
+// Iterate over an ijk box with the i index running fastest, like the local
+// numbering of the nodes and of the cells.
+using BoxPolicy = Kokkos::MDRangePolicy<
+    ExecutionSpace,
+    Kokkos::Rank<3, Kokkos::Iterate::Left, Kokkos::Iterate::Left>>;
+
+// Copy edges to the memory space of the mesh.
+Kokkos::View<Coordinate *> copyEdges( const std::string &label,
+                                      const std::vector<double> &edges )
+{
+    Kokkos::View<Coordinate *> view(
+        Kokkos::ViewAllocateWithoutInitializing( label ), edges.size() );
+    Kokkos::deep_copy(
+        view, Kokkos::View<const Coordinate *, Kokkos::HostSpace,
+                           Kokkos::MemoryUnmanaged>( edges.data(),
+                                                     edges.size() ) );
+    return view;
+}
+
+//---------------------------------------------------------------------------//
+// Compute the local node global ids and coordinates.
+void fillCartesianMeshNodes( Kokkos::View<Coordinate *> x_edges,
+                             Kokkos::View<Coordinate *> y_edges,
+                             Kokkos::View<Coordinate *> z_edges,
+                             const int x_global_num_node,
+                             const int y_global_num_node,
+                             const int x_edge_offset, const int y_edge_offset,
+                             const int z_edge_offset,
+                             Kokkos::View<GlobalOrdinal *> node_global_ids,
+                             Kokkos::View<Coordinate **> node_coords )
+{
+    const int x_local_num_node = x_edges.extent( 0 );
+    const int y_local_num_node = y_edges.extent( 0 );
+    const int z_local_num_node = z_edges.extent( 0 );
+    Kokkos::parallel_for(
+        "fill_cartesian_mesh_nodes",
+        BoxPolicy( {{0, 0, 0}}, {{x_local_num_node, y_local_num_node,
+                                  z_local_num_node}} ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            const int local_index =
+                i + x_local_num_node * ( j + y_local_num_node * k );
+            node_global_ids( local_index ) =
+                ( i + x_edge_offset ) +
+                static_cast<GlobalOrdinal>( x_global_num_node ) *
+                    ( ( j + y_edge_offset ) +
+                      static_cast<GlobalOrdinal>( y_global_num_node ) *
+                          ( k + z_edge_offset ) );
+            node_coords( local_index, 0 ) = x_edges( i );
+            node_coords( local_index, 1 ) = y_edges( j );
+            node_coords( local_index, 2 ) = z_edges( k );
+        } );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+// Compute the local cell global ids, connectivities, and cell center
+// coordinates. The global ids and the connectivities are skipped when their
+// views are empty.
+void fillCartesianMeshCells( Kokkos::View<Coordinate *> x_edges,
+                             Kokkos::View<Coordinate *> y_edges,
+                             Kokkos::View<Coordinate *> z_edges,
+                             const int x_global_num_cell,
+                             const int y_global_num_cell,
+                             const int x_edge_offset, const int y_edge_offset,
+                             const int z_edge_offset,
+                             Kokkos::View<GlobalOrdinal *> cell_global_ids,
+                             Kokkos::View<LocalOrdinal **> cell_connectivity,
+                             Kokkos::View<Coordinate **> cell_center_coords )
+{
+    const int x_local_num_node = x_edges.extent( 0 );
+    const int y_local_num_node = y_edges.extent( 0 );
+    const int x_local_num_cell = x_local_num_node - 1;
+    const int y_local_num_cell = y_local_num_node - 1;
+    const int z_local_num_cell = z_edges.extent_int( 0 ) - 1;
+    const bool with_ids = ( cell_global_ids.extent( 0 ) > 0 );
+    const bool with_connectivity = ( cell_connectivity.extent( 0 ) > 0 );
+    Kokkos::parallel_for(
+        "fill_cartesian_mesh_cells",
+        BoxPolicy( {{0, 0, 0}}, {{x_local_num_cell, y_local_num_cell,
+                                  z_local_num_cell}} ),
+        KOKKOS_LAMBDA( const int i, const int j, const int k ) {
+            const int local_index =
+                i + x_local_num_cell * ( j + y_local_num_cell * k );
+
+            if ( with_ids )
+                cell_global_ids( local_index ) =
+                    ( i + x_edge_offset ) +
+                    static_cast<GlobalOrdinal>( x_global_num_cell ) *
+                        ( ( j + y_edge_offset ) +
+                          static_cast<GlobalOrdinal>( y_global_num_cell ) *
+                              ( k + z_edge_offset ) );
+
+            // Set the cell connectivity. Connectivity is ordered for a hex-8
+            // cell in canonical ordering.
+            if ( with_connectivity )
+            {
+                const int node =
+                    i + x_local_num_node * ( j + y_local_num_node * k );
+                const int dj = x_local_num_node;
+                const int dk = x_local_num_node * y_local_num_node;
+                cell_connectivity( local_index, 0 ) = node;
+                cell_connectivity( local_index, 1 ) = node + 1;
+                cell_connectivity( local_index, 2 ) = node + 1 + dj;
+                cell_connectivity( local_index, 3 ) = node + dj;
+                cell_connectivity( local_index, 4 ) = node + dk;
+                cell_connectivity( local_index, 5 ) = node + 1 + dk;
+                cell_connectivity( local_index, 6 ) = node + 1 + dj + dk;
+                cell_connectivity( local_index, 7 ) = node + dj + dk;
+            }
+
+            // Set the cell center coordinates.
+            cell_center_coords( local_index, 0 ) =
+                ( x_edges( i ) + x_edges( i + 1 ) ) / 2.0;
+            cell_center_coords( local_index, 1 ) =
+                ( y_edges( j ) + y_edges( j + 1 ) ) / 2.0;
+            cell_center_coords( local_index, 2 ) =
+                ( z_edges( k ) + z_edges( k + 1 ) ) / 2.0;
+        } );
+    Kokkos::fence();
+}
+} // namespace
+
 //---------------------------------------------------------------------------//
 // Constructor.
 CartesianMesh::CartesianMesh(
@@ -30,7 +162,7 @@ CartesianMesh::CartesianMesh(
     const int y_edge_offset, const int z_edge_offset,
     const std::vector<double> &local_x_edges,
     const std::vector<double> &local_y_edges,
-    const std::vector<double> &local_z_edges )
+    const std::vector<double> &local_z_edges, const bool cell_centers_only )
 {
     // Set values.
     _comm = comm;
@@ -40,54 +172,33 @@ CartesianMesh::CartesianMesh(
     _num_j_blocks = num_j_blocks;
     _num_k_blocks = num_k_blocks;
 
+    // The mesh is generated directly in the memory space of the views.
+    auto x_edges = copyEdges( "x_edges", local_x_edges );
+    auto y_edges = copyEdges( "y_edges", local_y_edges );
+    auto z_edges = copyEdges( "z_edges", local_z_edges );
+
     // Compute the local number of nodes.
     int x_local_num_node = local_x_edges.size();
     int y_local_num_node = local_y_edges.size();
     int z_local_num_node = local_z_edges.size();
     int local_num_node = x_local_num_node * y_local_num_node * z_local_num_node;
 
-    // Local node indexer. Given a local ijk index compute a local cardinal
-    // node index.
-    auto local_node_index = [=]( const int i, const int j, const int k ) {
-        return i + x_local_num_node * j +
-               x_local_num_node * y_local_num_node * k;
-    };
-
-    // Global node indexer. Given a local ijk index compute a global cardinal
-    // node index.
-    auto global_node_index = [=]( const int i, const int j, const int k ) {
-        int i_global = i + x_edge_offset;
-        int j_global = j + y_edge_offset;
-        int k_global = k + z_edge_offset;
-        return i_global + x_global_num_node * j_global +
-               x_global_num_node * y_global_num_node * k_global;
-    };
-
     // Compute the local node global ids and coordinates.
     int space_dim = 3;
-    _local_node_global_ids =
-        Kokkos::View<GlobalOrdinal *>( "global_node_ids", local_num_node );
-    _local_node_coords =
-        Kokkos::View<Coordinate **>( "node_coords", local_num_node, space_dim );
-    for ( int k = 0; k < z_local_num_node; ++k )
+    _local_node_global_ids = Kokkos::View<GlobalOrdinal *>( "global_node_ids" );
+    _local_node_coords = Kokkos::View<Coordinate **>( "node_coords", 0, 0 );
+    if ( !cell_centers_only )
     {
-        for ( int j = 0; j < y_local_num_node; ++j )
-        {
-            for ( int i = 0; i < x_local_num_node; ++i )
-            {
-                // Compute local and global indices.
-                auto global_index = global_node_index( i, j, k );
-                auto local_index = local_node_index( i, j, k );
-
-                // Set the node global id.
-                _local_node_global_ids( local_index ) = global_index;
-
-                // Get the node coordinates from the edge arrays.
-                _local_node_coords( local_index, 0 ) = local_x_edges[i];
-                _local_node_coords( local_index, 1 ) = local_y_edges[j];
-                _local_node_coords( local_index, 2 ) = local_z_edges[k];
-            }
-        }
+        _local_node_global_ids = Kokkos::View<GlobalOrdinal *>(
+            Kokkos::ViewAllocateWithoutInitializing( "global_node_ids" ),
+            local_num_node );
+        _local_node_coords = Kokkos::View<Coordinate **>(
+            Kokkos::ViewAllocateWithoutInitializing( "node_coords" ),
+            local_num_node, space_dim );
+        fillCartesianMeshNodes( x_edges, y_edges, z_edges, x_global_num_node,
+                                y_global_num_node, x_edge_offset,
+                                y_edge_offset, z_edge_offset,
+                                _local_node_global_ids, _local_node_coords );
     }
 
     // Compute the local number of cells.
@@ -100,74 +211,29 @@ CartesianMesh::CartesianMesh(
     int x_global_num_cell = x_global_num_node - 1;
     int y_global_num_cell = y_global_num_node - 1;
 
-    // Local cell indexer. Given a local ijk index compute a local cardinal
-    // cell index.
-    auto local_cell_index = [=]( const int i, const int j, const int k ) {
-        return i + x_local_num_cell * j +
-               x_local_num_cell * y_local_num_cell * k;
-    };
-
-    // Global cell indexer. Given a local ijk index compute a global cardinal
-    // cell index.
-    auto global_cell_index = [=]( const int i, const int j, const int k ) {
-        int i_global = i + x_edge_offset;
-        int j_global = j + y_edge_offset;
-        int k_global = k + z_edge_offset;
-        return i_global + x_global_num_cell * j_global +
-               x_global_num_cell * y_global_num_cell * k_global;
-    };
-
     // Compute the local cell global ids, connectivities, and cell center
     // coordinates.
     int cell_num_node = 8;
-    _local_cell_global_ids =
-        Kokkos::View<GlobalOrdinal *>( "global_cell_ids", local_num_cell );
-    _local_cell_connectivity = Kokkos::View<LocalOrdinal **>(
-        "cell_connectivity", local_num_cell, cell_num_node );
-    _local_cell_center_coords =
-        Kokkos::View<Coordinate **>( "cell_coords", local_num_cell, space_dim );
-    for ( int k = 0; k < z_local_num_cell; ++k )
+    _local_cell_global_ids = Kokkos::View<GlobalOrdinal *>( "global_cell_ids" );
+    _local_cell_connectivity =
+        Kokkos::View<LocalOrdinal **>( "cell_connectivity", 0, 0 );
+    if ( !cell_centers_only )
     {
-        for ( int j = 0; j < y_local_num_cell; ++j )
-        {
-            for ( int i = 0; i < x_local_num_cell; ++i )
-            {
-                // Compute local and global indices.
-                auto global_index = global_cell_index( i, j, k );
-                auto local_index = local_cell_index( i, j, k );
-
-                // Set the cell global id.
-                _local_cell_global_ids( local_index ) = global_index;
-
-                // Set the cell connectivity. Connectivity is ordered for a
-                // hex-8 cell in canonical ordering.
-                _local_cell_connectivity( local_index, 0 ) =
-                    local_node_index( i, j, k );
-                _local_cell_connectivity( local_index, 1 ) =
-                    local_node_index( i + 1, j, k );
-                _local_cell_connectivity( local_index, 2 ) =
-                    local_node_index( i + 1, j + 1, k );
-                _local_cell_connectivity( local_index, 3 ) =
-                    local_node_index( i, j + 1, k );
-                _local_cell_connectivity( local_index, 4 ) =
-                    local_node_index( i, j, k + 1 );
-                _local_cell_connectivity( local_index, 5 ) =
-                    local_node_index( i + 1, j, k + 1 );
-                _local_cell_connectivity( local_index, 6 ) =
-                    local_node_index( i + 1, j + 1, k + 1 );
-                _local_cell_connectivity( local_index, 7 ) =
-                    local_node_index( i, j + 1, k + 1 );
-
-                // Set the cell center coordinates.
-                _local_cell_center_coords( local_index, 0 ) =
-                    ( local_x_edges[i] + local_x_edges[i + 1] ) / 2.0;
-                _local_cell_center_coords( local_index, 1 ) =
-                    ( local_y_edges[j] + local_y_edges[j + 1] ) / 2.0;
-                _local_cell_center_coords( local_index, 2 ) =
-                    ( local_z_edges[k] + local_z_edges[k + 1] ) / 2.0;
-            }
-        }
+        _local_cell_global_ids = Kokkos::View<GlobalOrdinal *>(
+            Kokkos::ViewAllocateWithoutInitializing( "global_cell_ids" ),
+            local_num_cell );
+        _local_cell_connectivity = Kokkos::View<LocalOrdinal **>(
+            Kokkos::ViewAllocateWithoutInitializing( "cell_connectivity" ),
+            local_num_cell, cell_num_node );
     }
+    _local_cell_center_coords = Kokkos::View<Coordinate **>(
+        Kokkos::ViewAllocateWithoutInitializing( "cell_coords" ),
+        local_num_cell, space_dim );
+    fillCartesianMeshCells( x_edges, y_edges, z_edges, x_global_num_cell,
+                            y_global_num_cell, x_edge_offset, y_edge_offset,
+                            z_edge_offset, _local_cell_global_ids,
+                            _local_cell_connectivity,
+                            _local_cell_center_coords );
 }
 
 //---------------------------------------------------------------------------//
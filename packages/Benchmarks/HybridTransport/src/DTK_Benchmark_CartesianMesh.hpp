@@ -71,6 +71,8 @@ namespace Benchmark
  *   array or the coordinates of their centers - these cells will be uniquely
  *   owned.
  *
+ * The mesh is generated in parallel directly in the default memory space.
+ *
  */
 class CartesianMesh
 {
@@ -107,6 +109,10 @@ class CartesianMesh
      *
      * \param local_z_edges The local edges of the mesh (node locations) in
      * the z direction.
+     *
+     * \param cell_centers_only If true, only the cell center coordinates are
+     * generated and the other views are left empty. This is all a point cloud
+     * transfer needs.
      */
     CartesianMesh( const Teuchos::RCP<const Teuchos::Comm<int>> &comm,
                    const int set_id, const int block_id, const int num_i_blocks,
@@ -116,7 +122,8 @@ class CartesianMesh
                    const int z_edge_offset,
                    const std::vector<double> &local_x_edges,
                    const std::vector<double> &local_y_edges,
-                   const std::vector<double> &local_z_edges );
+                   const std::vector<double> &local_z_edges,
+                   const bool cell_centers_only = false );
 
     // Destructor.
     virtual ~CartesianMesh() = default;
@@ -28,7 +28,7 @@ namespace Benchmark
 DeterministicMesh::DeterministicMesh(
     const Teuchos::RCP<const Teuchos::Comm<int>> &comm, const int num_cells_i,
     const int num_cells_j, const int num_cells_k, const double delta_x,
-    const double delta_y, const double delta_z )
+    const double delta_y, const double delta_z, const bool cell_centers_only )
 {
     // Create uniform global edge arrays.
     std::vector<double> global_x_edges( num_cells_i + 1 );
@@ -42,7 +42,8 @@ DeterministicMesh::DeterministicMesh(
         global_z_edges[n] = n * delta_z;
 
     // Partition the mesh.
-    partition( comm, global_x_edges, global_y_edges, global_z_edges );
+    partition( comm, global_x_edges, global_y_edges, global_z_edges,
+               cell_centers_only );
 }
 
 //---------------------------------------------------------------------------//
@@ -51,10 +52,11 @@ DeterministicMesh::DeterministicMesh(
     const Teuchos::RCP<const Teuchos::Comm<int>> &comm,
     const std::vector<double> &global_x_edges,
     const std::vector<double> &global_y_edges,
-    const std::vector<double> &global_z_edges )
+    const std::vector<double> &global_z_edges, const bool cell_centers_only )
 {
     // Partition the mesh.
-    partition( comm, global_x_edges, global_y_edges, global_z_edges );
+    partition( comm, global_x_edges, global_y_edges, global_z_edges,
+               cell_centers_only );
 }
 
 //---------------------------------------------------------------------------//
@@ -63,7 +65,7 @@ void DeterministicMesh::partition(
     const Teuchos::RCP<const Teuchos::Comm<int>> &comm,
     const std::vector<double> &global_x_edges,
     const std::vector<double> &global_y_edges,
-    const std::vector<double> &global_z_edges )
+    const std::vector<double> &global_z_edges, const bool cell_centers_only )
 {
     // Check that we have an even-sized communicator.
     DTK_REQUIRE( 1 == comm->getSize() || 0 == ( comm->getSize() % 2 ) );
@@ -153,7 +155,8 @@ void DeterministicMesh::partition(
     _cartesian_mesh = std::make_shared<CartesianMesh>(
         comm, set_id, block_id, num_i_blocks, num_j_blocks, num_k_blocks,
         global_x_edges.size(), global_y_edges.size(), i_offset, j_offset,
-        k_offset, local_x_edges, local_y_edges, global_z_edges );
+        k_offset, local_x_edges, local_y_edges, global_z_edges,
+        cell_centers_only );
 }
 
 //---------------------------------------------------------------------------//
@@ -66,11 +66,15 @@ class DeterministicMesh
      * \param delta_y The size of the mesh cells in the Y direction.
      *
      * \param delta_z The size of the mesh cells in the Z direction.
+     *
+     * \param cell_centers_only If true, only the cell center coordinates of
+     * the local mesh are generated.
      */
     DeterministicMesh( const Teuchos::RCP<const Teuchos::Comm<int>> &comm,
                        const int num_cells_i, const int num_cells_j,
                        const int num_cells_k, const double delta_x,
-                       const double delta_y, const double delta_z );
+                       const double delta_y, const double delta_z,
+                       const bool cell_centers_only = false );
 
     /*!
      * \brief Global edge constructor. A global list of node locations will be
@@ -83,11 +87,15 @@ class DeterministicMesh
      * \param global_y_edges Global list of node locations in the Y direction.
      *
      * \param global_z_edges Global list of node locations in the Z direction.
+     *
+     * \param cell_centers_only If true, only the cell center coordinates of
+     * the local mesh are generated.
      */
     DeterministicMesh( const Teuchos::RCP<const Teuchos::Comm<int>> &comm,
                        const std::vector<double> &global_x_edges,
                        const std::vector<double> &global_y_edges,
-                       const std::vector<double> &global_z_edges );
+                       const std::vector<double> &global_z_edges,
+                       const bool cell_centers_only = false );
 
     /*!
      * \brief Get the local Cartesian mesh owned by this process.
@@ -102,7 +110,8 @@ class DeterministicMesh
     void partition( const Teuchos::RCP<const Teuchos::Comm<int>> &comm,
                     const std::vector<double> &global_x_edges,
                     const std::vector<double> &global_y_edges,
-                    const std::vector<double> &global_z_edges );
+                    const std::vector<double> &global_z_edges,
+                    const bool cell_centers_only );
 
   private:
     // The Cartesian mesh owned by this process.
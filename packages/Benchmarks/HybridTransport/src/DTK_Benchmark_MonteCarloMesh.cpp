@@ -31,7 +31,7 @@ MonteCarloMesh::MonteCarloMesh(
     const double delta_x, const double delta_y, const double delta_z,
     const std::vector<double> &x_bnd_mesh,
     const std::vector<double> &y_bnd_mesh,
-    const std::vector<double> &z_bnd_mesh )
+    const std::vector<double> &z_bnd_mesh, const bool cell_centers_only )
 {
     // Create uniform global edge arrays.
     std::vector<double> global_x_edges( num_cells_i + 1 );
@@ -46,7 +46,7 @@ MonteCarloMesh::MonteCarloMesh(
 
     // Partition the mesh.
     partition( comm, num_sets, global_x_edges, global_y_edges, global_z_edges,
-               x_bnd_mesh, y_bnd_mesh, z_bnd_mesh );
+               x_bnd_mesh, y_bnd_mesh, z_bnd_mesh, cell_centers_only );
 }
 
 //---------------------------------------------------------------------------//
@@ -58,11 +58,11 @@ MonteCarloMesh::MonteCarloMesh(
     const std::vector<double> &global_z_edges,
     const std::vector<double> &x_bnd_mesh,
     const std::vector<double> &y_bnd_mesh,
-    const std::vector<double> &z_bnd_mesh )
+    const std::vector<double> &z_bnd_mesh, const bool cell_centers_only )
 {
     // Partition the mesh.
     partition( comm, num_sets, global_x_edges, global_y_edges, global_z_edges,
-               x_bnd_mesh, y_bnd_mesh, z_bnd_mesh );
+               x_bnd_mesh, y_bnd_mesh, z_bnd_mesh, cell_centers_only );
 }
 
 //---------------------------------------------------------------------------//
@@ -74,7 +74,7 @@ void MonteCarloMesh::partition(
     const std::vector<double> &global_z_edges,
     const std::vector<double> &x_bnd_mesh,
     const std::vector<double> &y_bnd_mesh,
-    const std::vector<double> &z_bnd_mesh )
+    const std::vector<double> &z_bnd_mesh, const bool cell_centers_only )
 {
     // Determine how many I, J, and K blocks there will be.
     int comm_size = comm->getSize();
@@ -129,7 +129,8 @@ void MonteCarloMesh::partition(
     _cartesian_mesh = std::make_shared<CartesianMesh>(
         comm, set_id, block_id, num_i_blocks, num_j_blocks, num_k_blocks,
         global_x_edges.size(), global_y_edges.size(), x_offset, y_offset,
-        z_offset, local_x_edges, local_y_edges, local_z_edges );
+        z_offset, local_x_edges, local_y_edges, local_z_edges,
+        cell_centers_only );
 }
 
 //---------------------------------------------------------------------------//
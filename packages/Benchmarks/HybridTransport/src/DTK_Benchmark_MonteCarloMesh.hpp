@@ -83,6 +83,9 @@ class MonteCarloMesh
      * \param y_bnd_mesh The boundary mesh node locations in the y direction.
      *
      * \param z_bnd_mesh The boundary mesh node locations in the z direction.
+     *
+     * \param cell_centers_only If true, only the cell center coordinates of
+     * the local mesh are generated.
      */
     MonteCarloMesh( const Teuchos::RCP<const Teuchos::Comm<int>> &comm,
                     const int num_sets, const int num_cells_i,
@@ -90,7 +93,8 @@ class MonteCarloMesh
                     const double delta_x, const double delta_y,
                     const double delta_z, const std::vector<double> &x_bnd_mesh,
                     const std::vector<double> &y_bnd_mesh,
-                    const std::vector<double> &z_bnd_mesh );
+                    const std::vector<double> &z_bnd_mesh,
+                    const bool cell_centers_only = false );
 
     /*!
      * \brief Global edge constructor. A global list of node locations will be
@@ -113,6 +117,9 @@ class MonteCarloMesh
      * \param y_bnd_mesh The boundary mesh node locations in the y direction.
      *
      * \param z_bnd_mesh The boundary mesh node locations in the z direction.
+     *
+     * \param cell_centers_only If true, only the cell center coordinates of
+     * the local mesh are generated.
      */
     MonteCarloMesh( const Teuchos::RCP<const Teuchos::Comm<int>> &comm,
                     const int num_sets,
@@ -121,7 +128,8 @@ class MonteCarloMesh
                     const std::vector<double> &global_z_edges,
                     const std::vector<double> &x_bnd_mesh,
                     const std::vector<double> &y_bnd_mesh,
-                    const std::vector<double> &z_bnd_mesh );
+                    const std::vector<double> &z_bnd_mesh,
+                    const bool cell_centers_only = false );
 
     /*!
      * \brief Get the local Cartesian mesh owned by this process.
@@ -140,7 +148,8 @@ class MonteCarloMesh
                     const std::vector<double> &global_z_edges,
                     const std::vector<double> &x_bnd_mesh,
                     const std::vector<double> &y_bnd_mesh,
-                    const std::vector<double> &z_bnd_mesh );
+                    const std::vector<double> &z_bnd_mesh,
+                    const bool cell_centers_only );
 
     // Calculate local edge arrays.
     void computeLocalEdges( const std::vector<double> &global_edges,
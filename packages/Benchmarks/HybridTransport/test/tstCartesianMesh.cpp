@@ -239,7 +239,8 @@ TEUCHOS_UNIT_TEST( CartesianMesh, cartesian_mesh )
     TEST_EQUALITY( mesh.blockId(), block_id );
 
     // Check the global ids of the nodes with an ijk indexer.
-    auto node_ids = mesh.localNodeGlobalIds();
+    auto node_ids = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), mesh.localNodeGlobalIds() );
     TEST_EQUALITY( Teuchos::as<int>( node_ids.extent( 0 ) ), local_num_node );
     auto local_node_id = [=]( const int i, const int j, const int k ) {
         return i + j * x_local_num_node +
@@ -263,7 +264,8 @@ TEUCHOS_UNIT_TEST( CartesianMesh, cartesian_mesh )
     }
 
     // Check the local coordinates of the nodes.
-    auto node_coords = mesh.localNodeCoordinates();
+    auto node_coords = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), mesh.localNodeCoordinates() );
     for ( int k = 0; k < z_local_num_node; ++k )
     {
         for ( int j = 0; j < y_local_num_node; ++j )
@@ -280,7 +282,8 @@ TEUCHOS_UNIT_TEST( CartesianMesh, cartesian_mesh )
     }
 
     // Check the global ids of the cells.
-    auto cell_ids = mesh.localCellGlobalIds();
+    auto cell_ids = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), mesh.localCellGlobalIds() );
     TEST_EQUALITY( Teuchos::as<int>( cell_ids.extent( 0 ) ), local_num_cell );
     auto local_cell_id = [=]( const int i, const int j, const int k ) {
         return i + j * x_local_num_cell +
@@ -305,8 +308,10 @@ TEUCHOS_UNIT_TEST( CartesianMesh, cartesian_mesh )
 
     // Check the coordinates of the cell centers and the connectivity of the
     // cells.
-    auto cell_conn = mesh.localCellConnectivity();
-    auto cell_coords = mesh.localCellCenterCoordinates();
+    auto cell_conn = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), mesh.localCellConnectivity() );
+    auto cell_coords = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), mesh.localCellCenterCoordinates() );
     for ( int k = 0; k < z_local_num_cell; ++k )
     {
         for ( int j = 0; j < y_local_num_cell; ++j )
@@ -393,6 +398,22 @@ TEUCHOS_UNIT_TEST( CartesianMesh, cartesian_mesh )
             }
         }
     }
+
+    // Only the cell centers are generated when requested.
+    DataTransferKit::Benchmark::CartesianMesh centers_mesh(
+        comm, set_id, block_id, num_i_blocks, num_j_blocks, num_k_blocks,
+        x_global_num_node, y_global_num_node, x_offset, y_offset, z_offset,
+        local_x_edges, local_y_edges, local_z_edges, true );
+    TEST_EQUALITY( centers_mesh.localNodeGlobalIds().extent( 0 ), 0u );
+    TEST_EQUALITY( centers_mesh.localNodeCoordinates().extent( 0 ), 0u );
+    TEST_EQUALITY( centers_mesh.localCellGlobalIds().extent( 0 ), 0u );
+    TEST_EQUALITY( centers_mesh.localCellConnectivity().extent( 0 ), 0u );
+    auto centers = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), centers_mesh.localCellCenterCoordinates() );
+    TEST_EQUALITY( centers.extent( 0 ), cell_coords.extent( 0 ) );
+    for ( unsigned int c = 0; c < centers.extent( 0 ); ++c )
+        for ( int d = 0; d < 3; ++d )
+            TEST_EQUALITY( centers( c, d ), cell_coords( c, d ) );
 }
 
 //---------------------------------------------------------------------------//
@@ -98,7 +98,8 @@ void checkResults( const DataTransferKit::Benchmark::CartesianMesh &mesh,
 
     // Check that the local cell partitions are of the right size (i.e. the
     // local cell sizes add up to the global mesh sizes).
-    auto cell_ids = mesh.localCellGlobalIds();
+    auto cell_ids = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), mesh.localCellGlobalIds() );
     int local_num_cell = cell_ids.extent( 0 );
     int global_num_cell = 0;
     Teuchos::reduceAll( *comm, Teuchos::REDUCE_SUM, local_num_cell,
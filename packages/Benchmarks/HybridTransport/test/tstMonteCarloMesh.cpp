@@ -143,7 +143,8 @@ void checkResults( const int num_sets,
 
     // Start by getting the local number of cells in the mesh and then summing
     // to get the global unique+ghosted number.
-    auto cell_ids = mesh.localCellGlobalIds();
+    auto cell_ids = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), mesh.localCellGlobalIds() );
     int local_num_cell = cell_ids.extent( 0 );
     int global_num_cell = 0;
     Teuchos::reduceAll( *comm, Teuchos::REDUCE_SUM, local_num_cell,
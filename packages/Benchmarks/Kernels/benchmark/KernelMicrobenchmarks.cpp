@@ -0,0 +1,569 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file KernelMicrobenchmarks.cpp
+ * \brief Throughput of the moving least squares and finite element kernels.
+ *
+ * Each kernel runs in isolation on synthetic inputs generated on the device.
+ * As in Google Benchmark, a kernel is repeated until it has run for a minimum
+ * time. The number of items processed per second is reported along with the
+ * bandwidth computed from the bytes that the kernel has to read and write.
+ * The items are the target points for the moving least squares kernels and
+ * the points for the finite element kernels.
+ *
+ * The batch size is swept for every kernel, together with:
+ *  - the polynomial basis for computeMoments, invertMoments,
+ *    computePolynomialCoefficients, and computeTargetValues,
+ *  - the radial basis function for computeWeights,
+ *  - the topology for Functor::PointInCell and Functor::HgradInterpolation.
+ * Kokkos cannot change the number of threads once it is initialized so the
+ * thread count is swept by running the driver with different values of
+ * --kokkos-threads. The concurrency of the execution space is reported with
+ * each result.
+ */
+//---------------------------------------------------------------------------//
+
+#include <DTK_CompactlySupportedRadialBasisFunctions.hpp>
+#include <DTK_Core.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_DetailsMovingLeastSquaresOperatorImpl.hpp>
+#include <DTK_DetailsSetupArena.hpp>
+#include <DTK_FE.hpp>
+#include <DTK_InterpolationFunctor.hpp>
+#include <DTK_MultivariatePolynomialBasis.hpp>
+#include <DTK_PointInCellFunctor.hpp>
+#include <DTK_Topology.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+
+using DeviceType = Kokkos::View<DataTransferKit::Coordinate **>::device_type;
+using ExecutionSpace = DeviceType::execution_space;
+using Impl =
+    DataTransferKit::Details::MovingLeastSquaresOperatorImpl<DeviceType>;
+using Arena = DataTransferKit::Details::SetupArena<DeviceType>;
+using DataTransferKit::Coordinate;
+using DataTransferKit::LocalOrdinal;
+
+//---------------------------------------------------------------------------//
+// Options shared by all the benchmarks.
+struct Options
+{
+    // Minimum time, in seconds, during which a kernel is timed.
+    double min_time = 0.5;
+    // Smallest and largest batch sizes. The batch size is multiplied by 10
+    // between two runs.
+    int min_batch = 1000;
+    int max_batch = 100000;
+    // Only the kernels whose name contains the filter are run.
+    std::string filter;
+};
+
+//---------------------------------------------------------------------------//
+// Repeat the kernel until it has been timed for at least min_time seconds.
+// Return the number of iterations and the time per iteration in seconds.
+template <typename Kernel>
+std::pair<int, double> timeKernel( double min_time, Kernel &kernel )
+{
+    int const max_iterations = 1000000000;
+
+    // Warm up.
+    kernel();
+    Kokkos::fence();
+
+    int iterations = 1;
+    while ( true )
+    {
+        auto const start = std::chrono::steady_clock::now();
+        for ( int i = 0; i < iterations; ++i )
+            kernel();
+        Kokkos::fence();
+        std::chrono::duration<double> const elapsed =
+            std::chrono::steady_clock::now() - start;
+        if ( elapsed.count() >= min_time || iterations >= max_iterations )
+            return std::make_pair( iterations, elapsed.count() / iterations );
+
+        // Like Google Benchmark, aim 40% above the minimum time but grow the
+        // number of iterations by a factor between 2 and 10.
+        double factor =
+            elapsed.count() > 0. ? 1.4 * min_time / elapsed.count() : 10.;
+        factor = std::min( 10., std::max( 2., factor ) );
+        iterations = static_cast<int>(
+            std::min<double>( max_iterations, iterations * factor ) );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Time the kernel and write a line of results. The bytes are those read and
+// written by one call of the kernel.
+template <typename Kernel>
+void benchmark( Options const &options, std::ostream &results,
+                std::string const &name, std::string const &variant,
+                int batch, double bytes, Kernel kernel )
+{
+    if ( name.find( options.filter ) == std::string::npos )
+        return;
+
+    auto const timing = timeKernel( options.min_time, kernel );
+    double const seconds = timing.second;
+    results << name << ',' << variant << ',' << batch << ','
+            << ExecutionSpace::concurrency() << ',' << timing.first << ','
+            << seconds * 1e6 << ',' << batch / seconds << ','
+            << bytes / seconds * 1e-9 << '\n';
+}
+
+//---------------------------------------------------------------------------//
+// Pseudo-random number in [0, 1) that only depends on the key, so that the
+// inputs are the same for all the backends.
+KOKKOS_INLINE_FUNCTION
+double hashToUnit( unsigned long long key )
+{
+    // Finalizer of splitmix64.
+    key += 0x9e3779b97f4a7c15ull;
+    key = ( key ^ ( key >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+    key = ( key ^ ( key >> 27 ) ) * 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return ( key >> 11 ) * ( 1. / 9007199254740992. );
+}
+
+//---------------------------------------------------------------------------//
+// Nodes of the reference hexahedron and of the reference tetrahedron of
+// Intrepid2.
+KOKKOS_INLINE_FUNCTION
+double referenceNode( bool const hexahedron, int const node, int const dim )
+{
+    if ( !hexahedron )
+        return node == dim + 1 ? 1. : 0.;
+    int const corner = node % 4;
+    if ( dim == 0 )
+        return corner == 1 || corner == 2 ? 1. : -1.;
+    if ( dim == 1 )
+        return corner >= 2 ? 1. : -1.;
+    return node >= 4 ? 1. : -1.;
+}
+
+//---------------------------------------------------------------------------//
+// Offsets of a batch of target points with n_neighbors source points each.
+Kokkos::View<int *, DeviceType> makeOffset( int const n_targets,
+                                            int const n_neighbors )
+{
+    Kokkos::View<int *, DeviceType> offset( "offset", n_targets + 1 );
+    Kokkos::parallel_for(
+        "make_offset", Kokkos::RangePolicy<ExecutionSpace>( 0, n_targets + 1 ),
+        KOKKOS_LAMBDA( int const i ) { offset( i ) = i * n_neighbors; } );
+    return offset;
+}
+
+//---------------------------------------------------------------------------//
+// Source points relative to their target point, in [-0.5, 0.5)^3.
+Kokkos::View<Coordinate **, DeviceType>
+makeRelativeSourcePoints( int const n_sources )
+{
+    Kokkos::View<Coordinate **, DeviceType> points( "source_points", n_sources,
+                                                    3 );
+    Kokkos::parallel_for( "make_source_points",
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_sources ),
+                          KOKKOS_LAMBDA( int const i ) {
+                              for ( int d = 0; d < 3; ++d )
+                                  points( i, d ) =
+                                      hashToUnit( 3 * i + d ) - 0.5;
+                          } );
+    return points;
+}
+
+//---------------------------------------------------------------------------//
+// One cell per item: the reference cell scaled by 0.5 and translated along x,
+// with its nodes perturbed so that the cells are distorted.
+Kokkos::View<Coordinate ***, DeviceType> makeCells( int const n_cells,
+                                                    bool const hexahedron )
+{
+    int const n_nodes = hexahedron ? 8 : 4;
+    Kokkos::View<Coordinate ***, DeviceType> cells( "cells", n_cells, n_nodes,
+                                                    3 );
+    Kokkos::parallel_for(
+        "make_cells", Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
+        KOKKOS_LAMBDA( int const i ) {
+            for ( int n = 0; n < n_nodes; ++n )
+                for ( int d = 0; d < 3; ++d )
+                    cells( i, n, d ) =
+                        0.5 * referenceNode( hexahedron, n, d ) +
+                        ( d == 0 ? 2. * i : 0. ) +
+                        0.05 * ( hashToUnit( ( i * n_nodes + n ) * 3 + d ) -
+                                 0.5 );
+        } );
+    return cells;
+}
+
+//---------------------------------------------------------------------------//
+// Assign each physical point to a random cell, as the coarse search would,
+// and place it close to the centroid of the cell.
+void makePhysicalPoints(
+    Kokkos::View<Coordinate ***, DeviceType> cells,
+    Kokkos::View<int *, DeviceType> coarse_search_output_cells,
+    Kokkos::View<Coordinate **, DeviceType> physical_points )
+{
+    int const n_cells = cells.extent( 0 );
+    int const n_nodes = cells.extent( 1 );
+    Kokkos::parallel_for(
+        "make_physical_points",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, physical_points.extent( 0 ) ),
+        KOKKOS_LAMBDA( int const i ) {
+            int const cell = static_cast<int>( hashToUnit( i ) * n_cells );
+            coarse_search_output_cells( i ) = cell;
+            for ( int d = 0; d < 3; ++d )
+            {
+                double centroid = 0.;
+                for ( int n = 0; n < n_nodes; ++n )
+                    centroid += cells( cell, n, d );
+                physical_points( i, d ) =
+                    centroid / n_nodes +
+                    0.02 * ( hashToUnit( 3 * i + d + 1 ) - 0.5 );
+            }
+        } );
+}
+
+//---------------------------------------------------------------------------//
+// Reference points inside the reference cell, the degrees of freedom of their
+// cell chosen at random, and the values of the degrees of freedom.
+void makeInterpolationInputs(
+    bool const hexahedron, Kokkos::View<Coordinate **, DeviceType> ref_points,
+    Kokkos::View<LocalOrdinal **, DeviceType> cell_dofs_ids,
+    Kokkos::View<double **, DeviceType> dof_values )
+{
+    int const n_basis = cell_dofs_ids.extent( 1 );
+    int const n_dofs = dof_values.extent( 0 );
+    Kokkos::parallel_for(
+        "make_interpolation_inputs",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, ref_points.extent( 0 ) ),
+        KOKKOS_LAMBDA( int const i ) {
+            for ( int d = 0; d < 3; ++d )
+            {
+                double const u = hashToUnit( 3 * i + d );
+                ref_points( i, d ) = hexahedron ? 2. * u - 1. : u / 3.;
+            }
+            for ( int j = 0; j < n_basis; ++j )
+                cell_dofs_ids( i, j ) = static_cast<LocalOrdinal>(
+                    hashToUnit( i * n_basis + j + 1 ) * n_dofs );
+        } );
+    Kokkos::deep_copy( dof_values, 1. );
+}
+
+//---------------------------------------------------------------------------//
+// computeWeights with the radial basis function RBF.
+template <typename RBF>
+void benchmarkWeights( Options const &options, std::ostream &results,
+                       std::string const &rbf_name, int const n_targets )
+{
+    // The number of neighbors is the size of the linear basis.
+    int const n_neighbors =
+        DataTransferKit::MultivariatePolynomialBasis<DataTransferKit::Linear,
+                                                     3>::size;
+    int const n_sources = n_targets * n_neighbors;
+    auto offset = makeOffset( n_targets, n_neighbors );
+    auto source_points = makeRelativeSourcePoints( n_sources );
+    auto radius = Impl::computeRadius( source_points, offset );
+
+    // The weights are taken from an arena so that only the kernel is timed.
+    Arena arena( Arena::requiredSize<double *>( n_sources ) );
+    auto kernel = [&]() {
+        arena.rewind();
+        Impl::computeWeights( source_points, radius, RBF(), &arena );
+    };
+    benchmark(
+        options, results, "compute_weights", rbf_name, n_targets,
+        n_sources * ( 3. * sizeof( Coordinate ) + 2. * sizeof( double ) ),
+        kernel );
+}
+
+//---------------------------------------------------------------------------//
+// The kernels of the moving least squares operator that depend on the
+// polynomial basis. Each target point has as many neighbors as there are
+// polynomials in the basis, as in the operator.
+template <typename PolynomialBasis>
+void benchmarkMovingLeastSquares( Options const &options,
+                                  std::ostream &results,
+                                  std::string const &basis_name,
+                                  int const n_targets )
+{
+    int const size = PolynomialBasis::size;
+    int const n_sources = n_targets * size;
+    double const n_moments = 1. * n_targets * size * size;
+    double const offset_bytes = ( n_targets + 1. ) * sizeof( int );
+
+    auto offset = makeOffset( n_targets, size );
+    auto source_points = makeRelativeSourcePoints( n_sources );
+    auto radius = Impl::computeRadius( source_points, offset );
+    auto p = Impl::computeVandermonde( source_points, PolynomialBasis() );
+    auto phi = Impl::computeWeights( source_points, radius,
+                                     DataTransferKit::Wendland<0>() );
+    auto a = Impl::computeMoments( offset, p, phi );
+    auto inv_a = std::get<0>( Impl::invertMoments( a, size ) );
+    Kokkos::View<double const *, DeviceType> coeffs =
+        Impl::computePolynomialCoefficients( offset, inv_a, p, phi, size );
+    Kokkos::View<double *, DeviceType> values( "source_values", n_sources );
+    Kokkos::deep_copy( values, 1. );
+    Kokkos::View<double const *, DeviceType> source_values = values;
+
+    // The moments, their inverse, and the workspace of the SVD are taken from
+    // an arena, as in the setup of the operator, so that only the kernels are
+    // timed.
+    Arena arena(
+        Arena::requiredSize<double *>( n_targets * size * size ) +
+        Arena::requiredSize<double **>( size, 3 * n_targets * size ) );
+
+    auto compute_moments = [&]() {
+        arena.rewind();
+        Impl::computeMoments( offset, p, phi, &arena );
+    };
+    benchmark( options, results, "compute_moments", basis_name, n_targets,
+               offset_bytes + n_sources * ( size + 1. ) * sizeof( double ) +
+                   n_moments * sizeof( double ),
+               compute_moments );
+
+    // The SVD reads the moments, writes their inverse, and goes through its
+    // workspace of three matrices per target.
+    auto invert_moments = [&]() {
+        arena.rewind();
+        Impl::invertMoments( a, size, &arena );
+    };
+    benchmark( options, results, "invert_moments", basis_name, n_targets,
+               5. * n_moments * sizeof( double ), invert_moments );
+
+    // Only the first row of the inverse is read.
+    auto compute_coefficients = [&]() {
+        Impl::computePolynomialCoefficients( offset, inv_a, p, phi, size );
+    };
+    benchmark( options, results, "compute_polynomial_coefficients",
+               basis_name, n_targets,
+               offset_bytes + n_targets * size * sizeof( double ) +
+                   n_sources * ( size + 2. ) * sizeof( double ),
+               compute_coefficients );
+
+    auto compute_values = [&]() {
+        Impl::computeTargetValues( offset, coeffs, source_values );
+    };
+    benchmark( options, results, "compute_target_values", basis_name,
+               n_targets,
+               offset_bytes + 2. * n_sources * sizeof( double ) +
+                   n_targets * sizeof( double ),
+               compute_values );
+}
+
+//---------------------------------------------------------------------------//
+// Functor::PointInCell on distorted cells of the given topology.
+template <typename CellType>
+void benchmarkPointInCell( Options const &options, std::ostream &results,
+                           std::string const &topology_name,
+                           bool const hexahedron, int const n_points )
+{
+    auto cells = makeCells( n_points, hexahedron );
+    int const n_nodes = cells.extent( 1 );
+    Kokkos::View<int *, DeviceType> coarse_search_output_cells(
+        "coarse_search_output_cells", n_points );
+    Kokkos::View<Coordinate **, DeviceType> physical_points(
+        "physical_points", n_points, 3 );
+    makePhysicalPoints( cells, coarse_search_output_cells, physical_points );
+    Kokkos::View<Coordinate **, DeviceType> reference_points(
+        "reference_points", n_points, 3 );
+    Kokkos::View<bool *, DeviceType> point_in_cell( "point_in_cell",
+                                                    n_points );
+
+    DataTransferKit::Functor::PointInCell<CellType, DeviceType> functor(
+        1e-6, physical_points, cells, coarse_search_output_cells,
+        reference_points, point_in_cell );
+    auto kernel = [&]() {
+        Kokkos::parallel_for(
+            "point_in_cell",
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ), functor );
+    };
+    benchmark( options, results, "point_in_cell", topology_name, n_points,
+               n_points * ( sizeof( int ) +
+                            ( n_nodes + 2. ) * 3 * sizeof( Coordinate ) +
+                            sizeof( bool ) ),
+               kernel );
+}
+
+//---------------------------------------------------------------------------//
+// Functor::HgradInterpolation of one field with the basis FEType.
+template <typename FEType>
+void benchmarkInterpolation( Options const &options, std::ostream &results,
+                             std::string const &fe_name, int const n_basis,
+                             bool const hexahedron, int const n_points )
+{
+    Kokkos::View<Coordinate **, DeviceType> ref_points( "ref_points",
+                                                        n_points, 3 );
+    Kokkos::View<LocalOrdinal **, DeviceType> cell_dofs_ids(
+        "cell_dofs_ids", n_points, n_basis );
+    Kokkos::View<double **, DeviceType> dof_values( "dof_values", n_points, 1 );
+    makeInterpolationInputs( hexahedron, ref_points, cell_dofs_ids,
+                             dof_values );
+    Kokkos::View<double **, DeviceType> output( "output", n_points, 1 );
+
+    DataTransferKit::Functor::HgradInterpolation<
+        double, typename FEType::feop_type, DeviceType>
+        functor( ref_points, cell_dofs_ids, dof_values, output );
+    auto kernel = [&]() {
+        Kokkos::parallel_for(
+            "interpolate",
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ), functor );
+    };
+    // The values of the basis functions are written to a buffer before being
+    // used and the output is accumulated.
+    benchmark( options, results, "hgrad_interpolation", fe_name, n_points,
+               n_points * ( 3. * sizeof( Coordinate ) +
+                            n_basis * ( 2. * sizeof( Coordinate ) +
+                                        sizeof( LocalOrdinal ) ) +
+                            2. * sizeof( double ) ),
+               kernel );
+}
+
+//---------------------------------------------------------------------------//
+void printUsage( char const *executable )
+{
+    std::cout
+        << "Usage: " << executable << " [options]\n"
+        << "  --min-time SECONDS     minimum time per kernel (default 0.5)\n"
+        << "  --min-batch N          smallest batch size (default 1000)\n"
+        << "  --max-batch N          largest batch size (default 100000)\n"
+        << "  --kernel NAME          only run the kernels whose name contains "
+           "NAME\n"
+        << "  --output FILE          file the results are written to "
+           "(default standard output)\n"
+        << "The number of threads is set with --kokkos-threads.\n";
+}
+
+//---------------------------------------------------------------------------//
+int main( int argc, char *argv[] )
+{
+    MPI_Init( &argc, &argv );
+    DataTransferKit::initialize( &argc, &argv );
+
+    Options options;
+    std::string output;
+
+    static option const long_options[] = {
+        {"min-time", required_argument, nullptr, 't'},
+        {"min-batch", required_argument, nullptr, 'n'},
+        {"max-batch", required_argument, nullptr, 'N'},
+        {"kernel", required_argument, nullptr, 'k'},
+        {"output", required_argument, nullptr, 'o'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}};
+    int opt;
+    while ( ( opt = getopt_long( argc, argv, "t:n:N:k:o:h", long_options,
+                                 nullptr ) ) != -1 )
+    {
+        switch ( opt )
+        {
+        case 't':
+            options.min_time = std::atof( optarg );
+            break;
+        case 'n':
+            options.min_batch = std::atoi( optarg );
+            break;
+        case 'N':
+            options.max_batch = std::atoi( optarg );
+            break;
+        case 'k':
+            options.filter = optarg;
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        default:
+            printUsage( argv[0] );
+            DataTransferKit::finalize();
+            MPI_Finalize();
+            return EXIT_FAILURE;
+        }
+    }
+    DTK_INSIST( options.min_time > 0. );
+    DTK_INSIST( 0 < options.min_batch &&
+                options.min_batch <= options.max_batch );
+
+    int comm_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &comm_rank );
+
+    std::ostringstream results;
+    results << "kernel,variant,batch,threads,iterations,time,items_per_second,"
+               "bandwidth\n";
+
+    using DataTransferKit::Linear;
+    using DataTransferKit::MultivariatePolynomialBasis;
+    using DataTransferKit::Quadratic;
+    for ( int batch = options.min_batch; batch <= options.max_batch;
+          batch *= 10 )
+    {
+        benchmarkWeights<DataTransferKit::Wendland<0>>( options, results,
+                                                        "Wendland<0>", batch );
+        benchmarkWeights<DataTransferKit::Wendland<6>>( options, results,
+                                                        "Wendland<6>", batch );
+        benchmarkWeights<DataTransferKit::Wu<2>>( options, results, "Wu<2>",
+                                                  batch );
+        benchmarkWeights<DataTransferKit::Buhmann<3>>( options, results,
+                                                       "Buhmann<3>", batch );
+
+        benchmarkMovingLeastSquares<MultivariatePolynomialBasis<Linear, 3>>(
+            options, results, "Linear", batch );
+        benchmarkMovingLeastSquares<
+            MultivariatePolynomialBasis<Quadratic, 3>>( options, results,
+                                                        "Quadratic", batch );
+
+        benchmarkPointInCell<DataTransferKit::HEX_8>(
+            options, results, "HEX_8", true, batch );
+        benchmarkPointInCell<DataTransferKit::TET_4>(
+            options, results, "TET_4", false, batch );
+
+        benchmarkInterpolation<DataTransferKit::HEX_HGRAD_1>(
+            options, results, "HEX_HGRAD_1", 8, true, batch );
+        benchmarkInterpolation<DataTransferKit::HEX_HGRAD_2>(
+            options, results, "HEX_HGRAD_2", 27, true, batch );
+        benchmarkInterpolation<DataTransferKit::TET_HGRAD_1>(
+            options, results, "TET_HGRAD_1", 4, false, batch );
+        benchmarkInterpolation<DataTransferKit::TET_HGRAD_2>(
+            options, results, "TET_HGRAD_2", 10, false, batch );
+    }
+
+    if ( comm_rank == 0 )
+    {
+        if ( output.empty() )
+        {
+            std::cout << results.str();
+        }
+        else
+        {
+            std::ofstream file( output );
+            DTK_INSIST( file.good() );
+            file << results.str();
+        }
+    }
+
+    DataTransferKit::finalize();
+    MPI_Finalize();
+    return EXIT_SUCCESS;
+}
+
+//---------------------------------------------------------------------------//
+// end KernelMicrobenchmarks.cpp
+//---------------------------------------------------------------------------//
@@ -14,9 +14,12 @@
 
 #include <DTK_Topology.hpp>
 
+#include <Kokkos_Array.hpp>
 #include <Kokkos_Macros.hpp>
 #include <Kokkos_View.hpp>
 
+#include <array>
+
 namespace DataTransferKit
 {
 namespace Discretization
@@ -168,16 +171,20 @@ struct MeshOffsets
 
         unsigned int const n_cells = mesh.cell_topologies.extent( 0 );
 
+        // The node offset does not depend on the topology so it is computed
+        // once and shared by all the topologies.
+        Kokkos::View<unsigned int *, DeviceType> node_offset( "node_offset",
+                                                              n_cells );
+        computeNodeOffset( mesh.cell_topologies, n_nodes_per_topo,
+                           node_offset );
+
         for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
         {
             offsets[topo_id] = Kokkos::View<unsigned int *, DeviceType>(
                 "offset_" + std::to_string( topo_id ), n_cells );
             computeOffset( mesh.cell_topologies, topo_id, offsets[topo_id] );
 
-            node_offsets[topo_id] = Kokkos::View<unsigned int *, DeviceType>(
-                "node_offset", n_cells );
-            computeNodeOffset( mesh.cell_topologies, n_nodes_per_topo,
-                               node_offsets[topo_id] );
+            node_offsets[topo_id] = node_offset;
         }
     }
 
@@ -187,6 +194,104 @@ struct MeshOffsets
     Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> n_nodes_per_topo;
 };
 
+/**
+ * Access the coordinates of the nodes of the cells stored in block_cells, i.e.,
+ * the coordinates are duplicated for each cell (n_cells, n_nodes, dim). The
+ * cells are indexed by topology.
+ */
+template <typename DeviceType>
+struct BlockCellNodes
+{
+    BlockCellNodes(
+        std::array<Kokkos::View<double ***, DeviceType>, DTK_N_TOPO> const
+            &block_cells_ )
+    {
+        for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+            block_cells[topo_id] = block_cells_[topo_id];
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    double operator()( unsigned int const topo_id, int const cell,
+                       int const node, int const d ) const
+    {
+        return block_cells[topo_id]( cell, node, d );
+    }
+
+    Kokkos::Array<Kokkos::View<double ***, DeviceType>, DTK_N_TOPO>
+        block_cells;
+};
+
+/**
+ * Access the coordinates of the nodes of the cells through the connectivity of
+ * the mesh. cell_node_offsets gives, for each cell of a given topology, the
+ * position of its first node in cells.
+ */
+template <typename DeviceType>
+struct ConnectivityCellNodes
+{
+    ConnectivityCellNodes(
+        Kokkos::View<unsigned int *, DeviceType> cells_,
+        std::array<Kokkos::View<unsigned int *, DeviceType>, DTK_N_TOPO> const
+            &cell_node_offsets_,
+        Kokkos::View<double **, DeviceType> nodes_coordinates_ )
+        : cells( cells_ )
+        , nodes_coordinates( nodes_coordinates_ )
+    {
+        for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+            cell_node_offsets[topo_id] = cell_node_offsets_[topo_id];
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    double operator()( unsigned int const topo_id, int const cell,
+                       int const node, int const d ) const
+    {
+        return nodes_coordinates(
+            cells( cell_node_offsets[topo_id]( cell ) + node ), d );
+    }
+
+    Kokkos::View<unsigned int *, DeviceType> cells;
+    Kokkos::Array<Kokkos::View<unsigned int *, DeviceType>, DTK_N_TOPO>
+        cell_node_offsets;
+    Kokkos::View<double **, DeviceType> nodes_coordinates;
+};
+
+/**
+ * Compute, for each topology, the offset in mesh.cells of the first node of
+ * each cell of that topology. This allows to access the nodes of the cells
+ * without duplicating their coordinates.
+ */
+template <typename DeviceType>
+void computeCellNodeOffsets(
+    Mesh<DeviceType> const &mesh, MeshOffsets<DeviceType> const &mesh_offsets,
+    std::array<Kokkos::View<unsigned int *, DeviceType>, DTK_N_TOPO>
+        &cell_node_offsets )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+    {
+        DTK_REQUIRE( mesh_offsets.offsets[topo_id].extent( 0 ) ==
+                     mesh.cell_topologies.extent( 0 ) );
+
+        if ( cell_node_offsets[topo_id].extent( 0 ) == 0 )
+            continue;
+
+        unsigned int const n_cells = mesh.cell_topologies.extent( 0 );
+        auto cell_node_offsets_topo = cell_node_offsets[topo_id];
+        auto node_offset = mesh_offsets.node_offsets[topo_id];
+        auto offset = mesh_offsets.offsets[topo_id];
+
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "build_cell_node_offsets_" +
+                             std::to_string( topo_id ) ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
+            KOKKOS_LAMBDA( int const i ) {
+                if ( mesh.cell_topologies( i ) == topo_id )
+                    cell_node_offsets_topo( offset( i ) ) = node_offset( i );
+            } );
+        Kokkos::fence();
+    }
+}
+
 template <typename DeviceType>
 KOKKOS_FUNCTION void
 buildBlockCells( unsigned int const dim, int const i,
@@ -341,6 +446,75 @@ void createBoundingBoxes(
         Kokkos::fence();
     }
 }
+/**
+ * Build the bounding boxes associated to the cell and the map between the
+ * bounding boxes and the flat array of cells. Same as above but the
+ * coordinates of the nodes are read through the connectivity of the mesh and
+ * block_cells is not needed.
+ */
+template <typename DeviceType>
+void createBoundingBoxes(
+    Mesh<DeviceType> const &mesh, MeshOffsets<DeviceType> const &mesh_offsets,
+    Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes,
+    Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell )
+{
+    DTK_REQUIRE( bounding_boxes.extent( 0 ) ==
+                 mesh.cell_topologies.extent( 0 ) );
+
+    using ExecutionSpace = typename DeviceType::execution_space;
+    unsigned int const dim = mesh.nodes_coordinates.extent( 1 );
+    unsigned int const n_cells = mesh.cell_topologies.extent( 0 );
+    // The node offset is the same for all the topologies
+    auto node_offset = mesh_offsets.node_offsets[0];
+    auto n_nodes_per_topo = mesh_offsets.n_nodes_per_topo;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "build_bounding_boxes" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
+        KOKKOS_LAMBDA( int const i ) {
+            unsigned int const topo_id = mesh.cell_topologies( i );
+            ArborX::Box bounding_box;
+            // If dim == 2, we need to set bounding_box.minCorner()[2] and
+            // bounding_box.maxCorner[2].
+            if ( dim == 2 )
+            {
+                bounding_box.minCorner()[2] = 0;
+                bounding_box.maxCorner()[2] = 1;
+            }
+            unsigned int const n_nodes = n_nodes_per_topo( topo_id );
+            for ( unsigned int node = 0; node < n_nodes; ++node )
+            {
+                unsigned int const n = node_offset( i ) + node;
+                for ( unsigned int d = 0; d < dim; ++d )
+                {
+                    double const x =
+                        mesh.nodes_coordinates( mesh.cells( n ), d );
+                    if ( x < bounding_box.minCorner()[d] )
+                        bounding_box.minCorner()[d] = x;
+                    if ( x > bounding_box.maxCorner()[d] )
+                        bounding_box.maxCorner()[d] = x;
+                }
+            }
+            bounding_boxes( i ) = bounding_box;
+        } );
+    Kokkos::fence();
+
+    // Build map between BoundingBoxes and the cells sorted by topology
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+    {
+        auto offset = mesh_offsets.offsets[topo_id];
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "build_bounding_boxes_to_cells_" +
+                             std::to_string( topo_id ) ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_cells ),
+            KOKKOS_LAMBDA( int const i ) {
+                if ( mesh.cell_topologies( i ) == topo_id )
+                {
+                    bounding_box_to_cell( i, topo_id ) = offset( i );
+                }
+            } );
+        Kokkos::fence();
+    }
+}
 } // namespace Helpers
 } // namespace Discretization
 } // namespace DataTransferKit
@@ -0,0 +1,287 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_HALF_SPACE_FILTER_FUNCTOR_HPP
+#define DTK_HALF_SPACE_FILTER_FUNCTOR_HPP
+
+#include <DTK_CellTypes.h>
+#include <DTK_ConfigDefs.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <array>
+#include <cmath> // sqrt
+#include <vector>
+
+namespace DataTransferKit
+{
+namespace Functor
+{
+/**
+ * Cheap conservative rejection test performed before the Newton solve of
+ * PointInCell. For each face of the cell, we build a direction from the face
+ * vertices and reject the point if it lies further along that direction than
+ * every vertex of the cell. Since the cell is contained in the convex hull of
+ * its vertices for linear topologies, this never rejects a point that is
+ * inside the cell, whatever the quality of the face normal. For cells with
+ * planar faces the test is exact. Quadratic topologies may bulge outside of
+ * the convex hull of their nodes, so their candidates are always kept. The
+ * faces of all the topologies are stored together so that candidates of
+ * different topologies can be tested in the same kernel.
+ */
+template <typename DeviceType>
+class HalfSpaceFilter
+{
+  public:
+    HalfSpaceFilter( double threshold, unsigned int dim )
+        : _threshold( threshold )
+        , _dim( dim )
+        , _faces( "faces" )
+        , _face_offsets( "face_offsets" )
+        , _n_vertices( "n_vertices" )
+    {
+        std::vector<std::array<int, 4>> faces;
+        auto face_offsets_host = Kokkos::create_mirror_view( _face_offsets );
+        auto n_vertices_host = Kokkos::create_mirror_view( _n_vertices );
+        for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+        {
+            face_offsets_host( topo_id ) = faces.size();
+            n_vertices_host( topo_id ) = appendFaces(
+                static_cast<DTK_CellTopology>( topo_id ), faces );
+        }
+        face_offsets_host( DTK_N_TOPO ) = faces.size();
+        Kokkos::deep_copy( _face_offsets, face_offsets_host );
+        Kokkos::deep_copy( _n_vertices, n_vertices_host );
+
+        unsigned int const n_faces = faces.size();
+        _faces = Kokkos::View<int * [4], DeviceType>( "faces", n_faces );
+        auto faces_host = Kokkos::create_mirror_view( _faces );
+        for ( unsigned int f = 0; f < n_faces; ++f )
+            for ( unsigned int k = 0; k < 4; ++k )
+                faces_host( f, k ) = faces[f][k];
+        Kokkos::deep_copy( _faces, faces_host );
+    }
+
+    /**
+     * Return true if \p point is trivially outside of the cell of topology
+     * \p topo_id whose nodes are given by \p nodes (n_nodes, dim).
+     */
+    template <typename NodesView>
+    KOKKOS_INLINE_FUNCTION bool isOutside( unsigned int const topo_id,
+                                           NodesView const &nodes,
+                                           double const point[3] ) const
+    {
+        unsigned int const n_vertices = _n_vertices( topo_id );
+        unsigned int const first_face = _face_offsets( topo_id );
+        unsigned int const last_face = _face_offsets( topo_id + 1 );
+        if ( first_face == last_face )
+            return false;
+
+        // Centroid and size of the cell. The size is used to scale the
+        // inclusion tolerance of PointInCell to the physical frame.
+        double centroid[3] = {0., 0., 0.};
+        double min_corner[3] = {0., 0., 0.};
+        double max_corner[3] = {0., 0., 0.};
+        for ( unsigned int d = 0; d < _dim; ++d )
+        {
+            min_corner[d] = nodes( 0, d );
+            max_corner[d] = nodes( 0, d );
+        }
+        for ( unsigned int v = 0; v < n_vertices; ++v )
+            for ( unsigned int d = 0; d < _dim; ++d )
+            {
+                double const x = nodes( v, d );
+                centroid[d] += x / n_vertices;
+                if ( x < min_corner[d] )
+                    min_corner[d] = x;
+                if ( x > max_corner[d] )
+                    max_corner[d] = x;
+            }
+        double diameter = 0.;
+        for ( unsigned int d = 0; d < _dim; ++d )
+            diameter += ( max_corner[d] - min_corner[d] ) *
+                        ( max_corner[d] - min_corner[d] );
+        double const tolerance = _threshold * sqrt( diameter );
+
+        for ( unsigned int f = first_face; f < last_face; ++f )
+        {
+            double normal[3] = {0., 0., 0.};
+            faceNormal( nodes, f, normal );
+
+            double norm = 0.;
+            for ( unsigned int d = 0; d < _dim; ++d )
+                norm += normal[d] * normal[d];
+            norm = sqrt( norm );
+            // Degenerate face, we cannot say anything.
+            if ( norm == 0. )
+                continue;
+
+            // Orient the normal away from the centroid. If the orientation is
+            // wrong, the test is weaker but still conservative.
+            double const centroid_height = dot( normal, centroid );
+            double const face_height = dot( normal, nodes, _faces( f, 0 ) );
+            if ( face_height < centroid_height )
+                for ( unsigned int d = 0; d < _dim; ++d )
+                    normal[d] = -normal[d];
+
+            double max_height = dot( normal, nodes, 0 );
+            for ( unsigned int v = 1; v < n_vertices; ++v )
+            {
+                double const height = dot( normal, nodes, v );
+                if ( height > max_height )
+                    max_height = height;
+            }
+
+            if ( dot( normal, point ) > max_height + tolerance * norm )
+                return true;
+        }
+
+        return false;
+    }
+
+  private:
+    /**
+     * Append the faces of the topology to \p faces and return its number of
+     * vertices. Faces are given by their vertices. Edges of 2D cells and
+     * triangular faces are padded with -1. Higher-order cells have no faces,
+     * they are not filtered.
+     */
+    static unsigned int appendFaces( DTK_CellTopology cell_topo,
+                                     std::vector<std::array<int, 4>> &faces )
+    {
+        switch ( cell_topo )
+        {
+        case DTK_TRI_3:
+        {
+            faces.insert( faces.end(), {{{0, 1, -1, -1}},
+                                        {{1, 2, -1, -1}},
+                                        {{2, 0, -1, -1}}} );
+            return 3;
+        }
+        case DTK_QUAD_4:
+        {
+            faces.insert( faces.end(), {{{0, 1, -1, -1}},
+                                        {{1, 2, -1, -1}},
+                                        {{2, 3, -1, -1}},
+                                        {{3, 0, -1, -1}}} );
+            return 4;
+        }
+        case DTK_TET_4:
+        {
+            faces.insert( faces.end(), {{{0, 1, 3, -1}},
+                                        {{1, 2, 3, -1}},
+                                        {{0, 3, 2, -1}},
+                                        {{0, 2, 1, -1}}} );
+            return 4;
+        }
+        case DTK_HEX_8:
+        {
+            faces.insert( faces.end(),
+                          {{{0, 1, 5, 4}}, {{1, 2, 6, 5}}, {{2, 3, 7, 6}},
+                           {{0, 4, 7, 3}}, {{0, 3, 2, 1}}, {{4, 5, 6, 7}}} );
+            return 8;
+        }
+        case DTK_PYRAMID_5:
+        {
+            faces.insert( faces.end(), {{{0, 1, 4, -1}},
+                                        {{1, 2, 4, -1}},
+                                        {{2, 3, 4, -1}},
+                                        {{0, 4, 3, -1}},
+                                        {{0, 3, 2, 1}}} );
+            return 5;
+        }
+        case DTK_WEDGE_6:
+        {
+            faces.insert( faces.end(), {{{0, 1, 4, 3}},
+                                        {{1, 2, 5, 4}},
+                                        {{0, 3, 5, 2}},
+                                        {{0, 2, 1, -1}},
+                                        {{3, 4, 5, -1}}} );
+            return 6;
+        }
+        default:
+        {
+            return 0;
+        }
+        }
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    double dot( double const normal[3], double const x[3] ) const
+    {
+        double result = 0.;
+        for ( unsigned int d = 0; d < _dim; ++d )
+            result += normal[d] * x[d];
+        return result;
+    }
+
+    template <typename NodesView>
+    KOKKOS_INLINE_FUNCTION double dot( double const normal[3],
+                                       NodesView const &nodes,
+                                       int const vertex ) const
+    {
+        double result = 0.;
+        for ( unsigned int d = 0; d < _dim; ++d )
+            result += normal[d] * nodes( vertex, d );
+        return result;
+    }
+
+    template <typename NodesView>
+    KOKKOS_INLINE_FUNCTION void faceNormal( NodesView const &nodes,
+                                            unsigned int const f,
+                                            double normal[3] ) const
+    {
+        if ( _dim == 2 )
+        {
+            // Normal of the edge (v0, v1) in the plane.
+            int const v0 = _faces( f, 0 );
+            int const v1 = _faces( f, 1 );
+            normal[0] = nodes( v1, 1 ) - nodes( v0, 1 );
+            normal[1] = nodes( v0, 0 ) - nodes( v1, 0 );
+            return;
+        }
+
+        // For triangles use two edges, for quadrilaterals use the diagonals
+        // so that non-planar faces get an averaged normal.
+        double a[3];
+        double b[3];
+        int const v0 = _faces( f, 0 );
+        int const v1 = _faces( f, 1 );
+        int const v2 = _faces( f, 2 );
+        int const v3 = _faces( f, 3 );
+        for ( unsigned int d = 0; d < 3; ++d )
+        {
+            if ( v3 == -1 )
+            {
+                a[d] = nodes( v1, d ) - nodes( v0, d );
+                b[d] = nodes( v2, d ) - nodes( v0, d );
+            }
+            else
+            {
+                a[d] = nodes( v2, d ) - nodes( v0, d );
+                b[d] = nodes( v3, d ) - nodes( v1, d );
+            }
+        }
+        normal[0] = a[1] * b[2] - a[2] * b[1];
+        normal[1] = a[2] * b[0] - a[0] * b[2];
+        normal[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    double _threshold;
+    unsigned int _dim;
+    Kokkos::View<int * [4], DeviceType> _faces;
+    Kokkos::View<unsigned int[DTK_N_TOPO + 1], DeviceType> _face_offsets;
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> _n_vertices;
+};
+} // namespace Functor
+} // namespace DataTransferKit
+
+#endif
@@ -18,7 +18,9 @@
 #include <DTK_FETypes.h>
 #include <DTK_InterpolationFunctor.hpp>
 #include <DTK_Mesh.hpp>
+#include <DTK_MeshIndex.hpp>
 #include <DTK_PointSearch.hpp>
+#include <DTK_StructuredMesh.hpp>
 #include <DTK_Topology.hpp>
 
 #include <Intrepid2_FunctionSpaceTools.hpp>
@@ -54,6 +56,40 @@ class Interpolation
                    Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids,
                    DTK_FEType fe_type );
 
+    /**
+     * Constructor. Same as above but reuse a MeshIndex that was previously
+     * built.
+     * @param mesh_index index of the mesh of the domain of interest
+     * @param points_coordinates coordinates in the physical frame of the points
+     * that we are looking for (n phys points, dim)
+     * @param cell_dof_ids degrees of freedom indices associated to each cell (n
+     * cells * n dofs per cell)
+     * @param fe_type type of the finite element (DTK_HGRAD, DTK_HDIV, or
+     * DTK_CURL)
+     */
+    Interpolation( MeshIndex<DeviceType> const &mesh_index,
+                   Kokkos::View<double **, DeviceType> points_coordinates,
+                   Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids,
+                   DTK_FEType fe_type );
+
+    /**
+     * Constructor for rectilinear meshes. The points are located without
+     * building a search tree, see the corresponding constructor of
+     * PointSearch.
+     * @param comm communicator of size mesh.numBlocks()
+     * @param mesh rectilinear mesh of the domain of interest
+     * @param points_coordinates coordinates in the physical frame of the points
+     * that we are looking for (n phys points, dim)
+     * @param cell_dof_ids degrees of freedom indices associated to each local
+     * cell (n cells * n dofs per cell)
+     * @param fe_type type of the finite element (DTK_HGRAD, DTK_HDIV, or
+     * DTK_CURL)
+     */
+    Interpolation( MPI_Comm comm, StructuredMesh<DeviceType> const &mesh,
+                   Kokkos::View<double **, DeviceType> points_coordinates,
+                   Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids,
+                   DTK_FEType fe_type );
+
     /**
      * This function performs the interpolation.
      * @param [in] X (n dofs, n fields)
@@ -61,6 +97,11 @@ class Interpolation
      * @return View of size Y.extent(0) with the ID associated associated to
      * each physical points. This can be used to know if a point was not found
      * and which one it was.
+     *
+     * The buffers used to gather the values of the reference points and to
+     * send them back to the ranks of the physical points are allocated at
+     * each call. The kernels run on the default instance of the execution
+     * space, followed by global fences.
      */
     template <typename Scalar>
     Kokkos::View<int *, DeviceType>
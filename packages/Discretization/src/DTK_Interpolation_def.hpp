@@ -22,6 +22,32 @@ Interpolation<DeviceType>::Interpolation(
     MPI_Comm comm, Mesh<DeviceType> const &mesh,
     Kokkos::View<double **, DeviceType> points_coordinates,
     Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids, DTK_FEType fe_type )
+    : Interpolation( MeshIndex<DeviceType>( comm, mesh ), points_coordinates,
+                     cell_dof_ids, fe_type )
+{
+}
+
+template <typename DeviceType>
+Interpolation<DeviceType>::Interpolation(
+    MeshIndex<DeviceType> const &mesh_index,
+    Kokkos::View<double **, DeviceType> points_coordinates,
+    Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids, DTK_FEType fe_type )
+    : _point_search( mesh_index, points_coordinates )
+{
+    // Fill up _finite_element, i.e., fill up a map between topo_id and FE
+    Topologies topologies;
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+        _finite_elements[topo_id] = getFE( topologies[topo_id].topo, fe_type );
+
+    // Change the format of cell_dofs_ids
+    filter_dofs_ids( mesh_index._cell_topologies, cell_dof_ids, fe_type );
+}
+
+template <typename DeviceType>
+Interpolation<DeviceType>::Interpolation(
+    MPI_Comm comm, StructuredMesh<DeviceType> const &mesh,
+    Kokkos::View<double **, DeviceType> points_coordinates,
+    Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids, DTK_FEType fe_type )
     : _point_search( comm, mesh, points_coordinates )
 {
     // Fill up _finite_element, i.e., fill up a map between topo_id and FE
@@ -29,8 +55,15 @@ Interpolation<DeviceType>::Interpolation(
     for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
         _finite_elements[topo_id] = getFE( topologies[topo_id].topo, fe_type );
 
+    // All the local cells have the same topology
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies(
+        "cell_topologies", mesh.numLocalCells( comm_rank ) );
+    Kokkos::deep_copy( cell_topologies, mesh.topology() );
+
     // Change the format of cell_dofs_ids
-    filter_dofs_ids( mesh.cell_topologies, cell_dof_ids, fe_type );
+    filter_dofs_ids( cell_topologies, cell_dof_ids, fe_type );
 }
 
 template <typename DeviceType>
@@ -71,7 +104,7 @@ void Interpolation<DeviceType>::filter_dofs_ids(
               i < _point_search._query_ids[topo_id].extent( 0 ); ++i )
         {
             unsigned int const cell_id =
-                _point_search._cell_indices_map
+                ( *_point_search._cell_indices_map )
                     [topo_id][_point_search._cell_indices[topo_id]( i )];
             unsigned int const offset = dof_offset[cell_id];
             std::vector<unsigned int> current_cell_dof_ids( n_dofs_per_cell );
@@ -0,0 +1,103 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_MESH_INDEX_DECL_HPP
+#define DTK_MESH_INDEX_DECL_HPP
+
+#include "DTK_ConfigDefs.hpp"
+#include <ArborX.hpp>
+#include <DTK_CellTypes.h>
+#include <DTK_Mesh.hpp>
+
+#include <Kokkos_View.hpp>
+
+#include <mpi.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace DataTransferKit
+{
+template <typename DeviceType>
+class PointSearch;
+
+/**
+ * How the coordinates of the nodes of the cells are stored in the MeshIndex.
+ * BLOCK duplicates the coordinates of the nodes for each cell which gives
+ * contiguous accesses during the search. CONNECTIVITY reads the coordinates
+ * through the connectivity of the mesh which reduces the memory footprint, in
+ * particular for high-order meshes.
+ */
+enum class CellStorage {
+    BLOCK,
+    CONNECTIVITY
+};
+
+/**
+ * This class holds the data structures built from the source mesh that are
+ * required to locate points in it: the cells sorted by topology, their
+ * bounding boxes, and the distributed search tree. It can be built once and
+ * used to locate several sets of points. Copies are shallow.
+ */
+template <typename DeviceType>
+class MeshIndex
+{
+  public:
+    /**
+     * Constructor.
+     * @param comm
+     * @param mesh mesh of the domain of interest
+     * @param cell_storage how the coordinates of the nodes of the cells are
+     * stored. With CellStorage::CONNECTIVITY, the views of \p mesh are kept
+     * and must not be modified while the index is in use.
+     */
+    MeshIndex( MPI_Comm comm, Mesh<DeviceType> const &mesh,
+               CellStorage cell_storage = CellStorage::BLOCK );
+
+    /**
+     * Locate the points in the mesh. Only the query side of the search is
+     * performed, the mesh index is reused as is.
+     * @param points_coordinates coordinates in the physical frame of the points
+     * that we are looking for.
+     */
+    PointSearch<DeviceType>
+    locate( Kokkos::View<double **, DeviceType> points_coordinates ) const;
+
+  private:
+    template <typename T>
+    friend class PointSearch;
+
+    template <typename T>
+    friend class Interpolation;
+
+    MPI_Comm _comm;
+    unsigned int _dim;
+    CellStorage _cell_storage;
+    std::array<unsigned int, DTK_N_TOPO> _n_cells_per_topo;
+    Kokkos::View<DTK_CellTopology *, DeviceType> _cell_topologies;
+    // Used with CellStorage::BLOCK
+    std::array<Kokkos::View<double ***, DeviceType>, DTK_N_TOPO> _block_cells;
+    // Used with CellStorage::CONNECTIVITY
+    Kokkos::View<unsigned int *, DeviceType> _cells;
+    Kokkos::View<double **, DeviceType> _nodes_coordinates;
+    std::array<Kokkos::View<unsigned int *, DeviceType>, DTK_N_TOPO>
+        _cell_node_offsets;
+    Kokkos::View<unsigned int **, DeviceType> _bounding_box_to_cell;
+    Kokkos::View<ArborX::Box *, DeviceType> _bounding_boxes;
+    std::shared_ptr<ArborX::DistributedSearchTree<DeviceType>>
+        _distributed_tree;
+    std::shared_ptr<std::array<std::vector<unsigned int>, DTK_N_TOPO>>
+        _cell_indices_map;
+};
+} // namespace DataTransferKit
+
+#endif
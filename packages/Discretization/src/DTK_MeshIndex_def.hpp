@@ -0,0 +1,115 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_MESH_INDEX_DEF_HPP
+#define DTK_MESH_INDEX_DEF_HPP
+
+#include <ArborX.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_DiscretizationHelpers.hpp>
+#include <DTK_PointSearch.hpp>
+#include <DTK_Topology.hpp>
+
+namespace DataTransferKit
+{
+template <typename DeviceType>
+MeshIndex<DeviceType>::MeshIndex( MPI_Comm comm, Mesh<DeviceType> const &mesh,
+                                  CellStorage cell_storage )
+    : _comm( comm )
+    , _dim( mesh.nodes_coordinates.extent( 1 ) )
+    , _cell_storage( cell_storage )
+    , _cell_topologies( mesh.cell_topologies )
+{
+    // Compute the number of cells of each of the supported topologies.
+    _n_cells_per_topo = Discretization::Helpers::computeNCellsPerTopology(
+        mesh.cell_topologies );
+
+    // Compute the topology and node offset
+    Discretization::Helpers::MeshOffsets<DeviceType> mesh_offsets( mesh );
+
+    // Initialize bounding_box_to_cell to an invalid state
+    _bounding_box_to_cell = Kokkos::View<unsigned int **, DeviceType>(
+        "bounding_box_to_cell", mesh.cell_topologies.extent( 0 ), DTK_N_TOPO );
+    Kokkos::deep_copy( _bounding_box_to_cell,
+                       static_cast<unsigned int>( -1 ) );
+
+    _bounding_boxes = Kokkos::View<ArborX::Box *, DeviceType>(
+        "bounding_boxes", mesh.cell_topologies.extent( 0 ) );
+
+    if ( _cell_storage == CellStorage::BLOCK )
+    {
+        // Convert the cells and cell_nodes_coordinates View to block_cells
+        auto n_nodes_per_topo_host =
+            Kokkos::create_mirror_view( mesh_offsets.n_nodes_per_topo );
+        Kokkos::deep_copy( n_nodes_per_topo_host,
+                           mesh_offsets.n_nodes_per_topo );
+        for ( int i = 0; i < DTK_N_TOPO; ++i )
+        {
+            _block_cells[i] = Kokkos::View<double ***, DeviceType>(
+                "block_cells_" + std::to_string( i ), _n_cells_per_topo[i],
+                n_nodes_per_topo_host( i ), _dim );
+        }
+        Discretization::Helpers::convertMesh( mesh, mesh_offsets,
+                                              _block_cells );
+
+        Discretization::Helpers::createBoundingBoxes(
+            mesh, mesh_offsets, _block_cells, _bounding_boxes,
+            _bounding_box_to_cell );
+    }
+    else
+    {
+        // Keep the connectivity of the mesh and only store, for each cell,
+        // the offset of its first node.
+        _cells = mesh.cells;
+        _nodes_coordinates = mesh.nodes_coordinates;
+        for ( int i = 0; i < DTK_N_TOPO; ++i )
+        {
+            _cell_node_offsets[i] = Kokkos::View<unsigned int *, DeviceType>(
+                "cell_node_offsets_" + std::to_string( i ),
+                _n_cells_per_topo[i] );
+        }
+        Discretization::Helpers::computeCellNodeOffsets( mesh, mesh_offsets,
+                                                         _cell_node_offsets );
+
+        Discretization::Helpers::createBoundingBoxes(
+            mesh, mesh_offsets, _bounding_boxes, _bounding_box_to_cell );
+    }
+
+    // Build the distributed search tree over the bounding boxes
+    _distributed_tree =
+        std::make_shared<ArborX::DistributedSearchTree<DeviceType>>(
+            _comm, _bounding_boxes );
+
+    // Build a map between the cell_indices sorted by topology and the flat View
+    // given to the constructor
+    _cell_indices_map =
+        std::make_shared<std::array<std::vector<unsigned int>, DTK_N_TOPO>>();
+    auto cell_topologies_host =
+        Kokkos::create_mirror_view( mesh.cell_topologies );
+    Kokkos::deep_copy( cell_topologies_host, mesh.cell_topologies );
+    unsigned int const size = cell_topologies_host.extent( 0 );
+    for ( unsigned int i = 0; i < size; ++i )
+        ( *_cell_indices_map )[cell_topologies_host( i )].push_back( i );
+}
+
+template <typename DeviceType>
+PointSearch<DeviceType> MeshIndex<DeviceType>::locate(
+    Kokkos::View<double **, DeviceType> points_coordinates ) const
+{
+    return PointSearch<DeviceType>( *this, points_coordinates );
+}
+} // namespace DataTransferKit
+
+// Explicit instantiation macro
+#define DTK_MESHINDEX_INSTANT( NODE )                                          \
+    template class MeshIndex<typename NODE::device_type>;
+
+#endif
@@ -12,6 +12,11 @@
 #ifndef DTK_POINT_IN_CELL_FUNCTOR_HPP
 #define DTK_POINT_IN_CELL_FUNCTOR_HPP
 
+#include <ArborX.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_HalfSpaceFilterFunctor.hpp>
+#include <DTK_Topology.hpp>
+
 #include <Intrepid2_CellTools_Serial.hpp>
 #include <Kokkos_Macros.hpp>
 #include <Kokkos_View.hpp>
@@ -70,6 +75,171 @@ class PointInCell
     Kokkos::View<Coordinate **, DeviceType> _reference_points;
     Kokkos::View<bool *, DeviceType> _point_in_cell;
 };
+
+/**
+ * Compute the position in the reference frame of candidates of all the
+ * topologies in a single kernel. The candidates are visited through \p
+ * permutation which sorts them by topology, so that consecutive threads take
+ * the same branch of the switch. The nodes of the cell are gathered in a small
+ * local buffer through CellNodes (see Discretization::Helpers::BlockCellNodes
+ * and ConnectivityCellNodes). Candidates trivially outside of their cell are
+ * rejected by the half-space test before the Newton solve.
+ */
+template <typename DeviceType, typename CellNodes>
+class MultiTopologyPointInCell
+{
+  public:
+    // HEX_27 is the topology with the largest number of nodes
+    static unsigned int constexpr max_n_nodes = 27;
+
+    MultiTopologyPointInCell(
+        double threshold, unsigned int dim, CellNodes cells,
+        HalfSpaceFilter<DeviceType> half_space_filter,
+        Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> n_nodes_per_topo,
+        Kokkos::View<unsigned int *, DeviceType> permutation,
+        Kokkos::View<unsigned int *, DeviceType> topo,
+        Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell,
+        Kokkos::View<int *, DeviceType> coarse_search_output_cells,
+        Kokkos::View<ArborX::Point *, DeviceType> physical_points,
+        Kokkos::View<int *, DeviceType> cell_indices,
+        Kokkos::View<Coordinate **, DeviceType> reference_points,
+        Kokkos::View<bool *, DeviceType> point_in_cell,
+        Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> n_points_in_cell,
+        Kokkos::View<unsigned int, DeviceType> n_pruned )
+        : _threshold( threshold )
+        , _dim( dim )
+        , _cells( cells )
+        , _half_space_filter( half_space_filter )
+        , _n_nodes_per_topo( n_nodes_per_topo )
+        , _permutation( permutation )
+        , _topo( topo )
+        , _bounding_box_to_cell( bounding_box_to_cell )
+        , _coarse_search_output_cells( coarse_search_output_cells )
+        , _physical_points( physical_points )
+        , _cell_indices( cell_indices )
+        , _reference_points( reference_points )
+        , _point_in_cell( point_in_cell )
+        , _n_points_in_cell( n_points_in_cell )
+        , _n_pruned( n_pruned )
+    {
+        DTK_REQUIRE( _dim <= 3 );
+    }
+
+    KOKKOS_INLINE_FUNCTION
+    void operator()( unsigned int const j ) const
+    {
+        // Extract the candidate and its cell in the numbering of its topology
+        unsigned int const i = _permutation( j );
+        unsigned int const topo_id = _topo( i );
+        int const cell_index = _bounding_box_to_cell(
+            _coarse_search_output_cells( i ), topo_id );
+        _cell_indices( j ) = cell_index;
+
+        // Gather the nodes of the cell (nodes, dim) and the physical point
+        using ExecutionSpace = typename DeviceType::execution_space;
+        using UnmanagedView =
+            Kokkos::View<Coordinate **, Kokkos::LayoutRight, ExecutionSpace,
+                         Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+        unsigned int const n_nodes = _n_nodes_per_topo( topo_id );
+        Coordinate nodes_buffer[max_n_nodes * 3];
+        for ( unsigned int node = 0; node < n_nodes; ++node )
+            for ( unsigned int d = 0; d < _dim; ++d )
+                nodes_buffer[node * _dim + d] =
+                    _cells( topo_id, cell_index, node, d );
+        UnmanagedView nodes( nodes_buffer, n_nodes, _dim );
+        Coordinate phys_buffer[3] = {0., 0., 0.};
+        for ( unsigned int d = 0; d < _dim; ++d )
+            phys_buffer[d] = _physical_points( i )[d];
+
+        if ( _half_space_filter.isOutside( topo_id, nodes, phys_buffer ) )
+        {
+            _point_in_cell( j ) = false;
+            Kokkos::atomic_increment( &_n_pruned() );
+            return;
+        }
+
+        // Compute the reference point and check if the point is inside the
+        // cell
+        Coordinate ref_buffer[3] = {0., 0., 0.};
+        Kokkos::View<Coordinate *, ExecutionSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+            ref_point( ref_buffer, _dim );
+        Kokkos::View<Coordinate *, ExecutionSpace,
+                     Kokkos::MemoryTraits<Kokkos::Unmanaged>>
+            phys_point( phys_buffer, _dim );
+        bool in_cell = false;
+        switch ( topo_id )
+        {
+        case DTK_HEX_8:
+            in_cell = pointInCell<HEX_8>( ref_point, phys_point, nodes );
+            break;
+        case DTK_HEX_27:
+            in_cell = pointInCell<HEX_27>( ref_point, phys_point, nodes );
+            break;
+        case DTK_PYRAMID_5:
+            in_cell = pointInCell<PYRAMID_5>( ref_point, phys_point, nodes );
+            break;
+        case DTK_QUAD_4:
+            in_cell = pointInCell<QUAD_4>( ref_point, phys_point, nodes );
+            break;
+        case DTK_QUAD_9:
+            in_cell = pointInCell<QUAD_9>( ref_point, phys_point, nodes );
+            break;
+        case DTK_TET_4:
+            in_cell = pointInCell<TET_4>( ref_point, phys_point, nodes );
+            break;
+        case DTK_TET_10:
+            in_cell = pointInCell<TET_10>( ref_point, phys_point, nodes );
+            break;
+        case DTK_TRI_3:
+            in_cell = pointInCell<TRI_3>( ref_point, phys_point, nodes );
+            break;
+        case DTK_TRI_6:
+            in_cell = pointInCell<TRI_6>( ref_point, phys_point, nodes );
+            break;
+        case DTK_WEDGE_6:
+            in_cell = pointInCell<WEDGE_6>( ref_point, phys_point, nodes );
+            break;
+        case DTK_WEDGE_18:
+            in_cell = pointInCell<WEDGE_18>( ref_point, phys_point, nodes );
+            break;
+        }
+
+        for ( unsigned int d = 0; d < _dim; ++d )
+            _reference_points( j, d ) = ref_buffer[d];
+        _point_in_cell( j ) = in_cell;
+        if ( in_cell )
+            Kokkos::atomic_increment( &_n_points_in_cell( topo_id ) );
+    }
+
+  private:
+    template <typename CellType, typename PointView, typename NodesView>
+    KOKKOS_INLINE_FUNCTION bool pointInCell( PointView const &ref_point,
+                                             PointView const &phys_point,
+                                             NodesView const &nodes ) const
+    {
+        Intrepid2::Impl::CellTools::Serial::mapToReferenceFrame<
+            typename CellType::basis_type>( ref_point, phys_point, nodes );
+        return CellType::topo_type::checkPointInclusion( ref_point,
+                                                         _threshold );
+    }
+
+    double _threshold;
+    unsigned int _dim;
+    CellNodes _cells;
+    HalfSpaceFilter<DeviceType> _half_space_filter;
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> _n_nodes_per_topo;
+    Kokkos::View<unsigned int *, DeviceType> _permutation;
+    Kokkos::View<unsigned int *, DeviceType> _topo;
+    Kokkos::View<unsigned int **, DeviceType> _bounding_box_to_cell;
+    Kokkos::View<int *, DeviceType> _coarse_search_output_cells;
+    Kokkos::View<ArborX::Point *, DeviceType> _physical_points;
+    Kokkos::View<int *, DeviceType> _cell_indices;
+    Kokkos::View<Coordinate **, DeviceType> _reference_points;
+    Kokkos::View<bool *, DeviceType> _point_in_cell;
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> _n_points_in_cell;
+    Kokkos::View<unsigned int, DeviceType> _n_pruned;
+};
 } // namespace Functor
 } // namespace DataTransferKit
 
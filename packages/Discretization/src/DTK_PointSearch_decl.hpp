@@ -16,12 +16,15 @@
 #include <ArborX.hpp>
 #include <DTK_CellTypes.h>
 #include <DTK_Mesh.hpp>
+#include <DTK_MeshIndex.hpp>
+#include <DTK_StructuredMesh.hpp>
 
 #include <Kokkos_View.hpp>
 
 #include <mpi.h>
 
 #include <array>
+#include <memory>
 #include <tuple>
 
 namespace DataTransferKit
@@ -48,6 +51,31 @@ class PointSearch
     PointSearch( MPI_Comm comm, Mesh<DeviceType> const &mesh,
                  Kokkos::View<double **, DeviceType> points_coordinates );
 
+    /**
+     * Constructor. Same as above but reuse a MeshIndex that was previously
+     * built. Only the query side of the search is performed.
+     * @param mesh_index index of the mesh of the domain of interest
+     * @param points_coordinates coordinates in the physical frame of the points
+     * that we are looking for.
+     */
+    PointSearch( MeshIndex<DeviceType> const &mesh_index,
+                 Kokkos::View<double **, DeviceType> points_coordinates );
+
+    /**
+     * Constructor for rectilinear meshes. The cells containing the points are
+     * found by a binary search along each axis, the reference coordinates are
+     * computed in closed form, and the owning ranks are deduced from the
+     * block decomposition. No bounding box, search tree, or Newton solve is
+     * needed. A point on a face shared by several cells is only associated to
+     * one of them.
+     * @param comm communicator of size mesh.numBlocks()
+     * @param mesh rectilinear mesh of the domain of interest
+     * @param points_coordinates coordinates in the physical frame of the points
+     * that we are looking for.
+     */
+    PointSearch( MPI_Comm comm, StructuredMesh<DeviceType> const &mesh,
+                 Kokkos::View<double **, DeviceType> points_coordinates );
+
     /**
      * Return the result of the search. The tuple contains the rank where the
      * points are found, the cell indices associated to the points (local IDs),
@@ -59,6 +87,21 @@ class PointSearch
                Kokkos::View<unsigned int *, DeviceType>>
     getSearchResults() const;
 
+    /**
+     * Return the number of candidates (point, cell) pairs received from the
+     * distributed search.
+     */
+    unsigned int getNumberOfCandidates() const { return _n_candidates; }
+
+    /**
+     * Return the number of candidates that were rejected by the cheap
+     * geometric test before the Newton solve of PointInCell.
+     */
+    unsigned int getNumberOfPrunedCandidates() const
+    {
+        return _n_pruned_candidates;
+    }
+
     /**
      * Perform the distributed search and sends the points and the cell indices
      * to the processors owning the cells.
@@ -71,40 +114,40 @@ class PointSearch
                Kokkos::View<int *, DeviceType>>
     performDistributedSearch(
         Kokkos::View<double **, DeviceType> points_coord,
-        Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes );
+        ArborX::DistributedSearchTree<DeviceType> const &distributed_tree );
 
     /**
-     * Keep cell_indices, points, query_ids, and ranks that satisfy a given
-     * topology.
+     * Locate the points in a rectilinear mesh and send the reference
+     * coordinates, the local cell indices, and the query ids to the processors
+     * owning the cells.
      *
      * @note This function should be <b>private</b> but lambda functions can
      * only be called from a public function in CUDA.
      */
-    std::tuple<Kokkos::View<int *, DeviceType>,
-               Kokkos::View<double **, DeviceType>,
-               Kokkos::View<int *, DeviceType>, Kokkos::View<int *, DeviceType>>
-    filterTopology(
-        Kokkos::View<unsigned int *, DeviceType> topo, unsigned int topo_id,
-        unsigned int size,
-        Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell,
-        Kokkos::View<int *, DeviceType> cell_indices,
-        Kokkos::View<ArborX::Point *, DeviceType> points,
-        Kokkos::View<int *, DeviceType> query_ids,
-        Kokkos::View<int *, DeviceType> ranks );
+    std::tuple<Kokkos::View<Coordinate **, DeviceType>,
+               Kokkos::View<int *, DeviceType>, Kokkos::View<int *, DeviceType>,
+               Kokkos::View<int *, DeviceType>>
+    performStructuredSearch(
+        StructuredMesh<DeviceType> const &mesh,
+        Kokkos::View<double **, DeviceType> points_coord );
 
     /**
-     * Keep data corresponding to points found inside the reference cell.
+     * Sort the candidates by topology and compute their position in the
+     * reference frame with a single kernel for all the topologies. Only the
+     * candidates found inside of their cell are kept. Return, for each
+     * topology, the ranks of the processors that own the points.
      *
      * @note This function should be <b>private</b> but lambda functions can
      * only be called from a public function in CUDA.
      */
-    Kokkos::View<int *, DeviceType> filterInCell(
-        Kokkos::View<bool *, DeviceType> filtered_per_topo_point_in_cell,
-        Kokkos::View<double **, DeviceType> filtered_per_topo_reference_points,
-        Kokkos::View<int *, DeviceType> filtered_per_topo_cell_indices,
-        Kokkos::View<int *, DeviceType> filtered_per_topo_query_ids,
-        Kokkos::View<int *, DeviceType> filtered_per_topo_ranks,
-        unsigned int topo_id );
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> performPointInCell(
+        MeshIndex<DeviceType> const &mesh_index,
+        Kokkos::View<int *, DeviceType> imported_cell_indices,
+        Kokkos::View<ArborX::Point *, DeviceType> imported_points,
+        Kokkos::View<int *, DeviceType> imported_query_ids,
+        Kokkos::View<int *, DeviceType> imported_ranks,
+        Kokkos::View<unsigned int *, DeviceType> topo,
+        Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> topo_size );
 
   private:
     /**
@@ -113,20 +156,6 @@ class PointSearch
     std::array<unsigned int, DTK_N_TOPO> computeNCellsPerTopology(
         Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies );
 
-    /**
-     * Compute the position in the reference frame of candidates found by the
-     * search.
-     */
-    Kokkos::View<int *, DeviceType> performPointInCell(
-        Kokkos::View<double ***, DeviceType> cells,
-        Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell,
-        Kokkos::View<int *, DeviceType> imported_cell_indices,
-        Kokkos::View<ArborX::Point *, DeviceType> imported_points,
-        Kokkos::View<int *, DeviceType> imported_query_ids,
-        Kokkos::View<int *, DeviceType> imported_ranks,
-        Kokkos::View<unsigned int *, DeviceType> topo, unsigned int topo_id,
-        unsigned int size );
-
     /**
      * Build the target-to-source distributor.
      */
@@ -143,7 +172,10 @@ class PointSearch
         _reference_points;
     std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> _query_ids;
     std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> _cell_indices;
-    std::array<std::vector<unsigned int>, DTK_N_TOPO> _cell_indices_map;
+    std::shared_ptr<std::array<std::vector<unsigned int>, DTK_N_TOPO>>
+        _cell_indices_map;
+    unsigned int _n_candidates;
+    unsigned int _n_pruned_candidates;
 };
 } // namespace DataTransferKit
 
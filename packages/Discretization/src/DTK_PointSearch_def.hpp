@@ -15,11 +15,15 @@
 #include <ArborX.hpp>
 #include <DTK_DBC.hpp>
 #include <DTK_DiscretizationHelpers.hpp>
+#include <DTK_HalfSpaceFilterFunctor.hpp>
 #include <DTK_PointInCell.hpp>
+#include <DTK_PointInCellFunctor.hpp>
 #include <DTK_Topology.hpp>
 
 #include <mpi.h>
 
+#include <numeric>
+
 namespace DataTransferKit
 {
 namespace internal
@@ -85,6 +89,93 @@ void buildTopo( Kokkos::View<int *, DeviceType> imported_cell_indices,
 #endif
 }
 
+template <typename DeviceType, typename CellNodes>
+void multiTopologyPointInCell(
+    CellNodes cells, unsigned int dim,
+    Kokkos::View<unsigned int *, DeviceType> permutation,
+    Kokkos::View<unsigned int *, DeviceType> topo,
+    Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell,
+    Kokkos::View<int *, DeviceType> coarse_search_output_cells,
+    Kokkos::View<ArborX::Point *, DeviceType> physical_points,
+    Kokkos::View<int *, DeviceType> cell_indices,
+    Kokkos::View<Coordinate **, DeviceType> reference_points,
+    Kokkos::View<bool *, DeviceType> point_in_cell,
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> n_points_in_cell,
+    Kokkos::View<unsigned int, DeviceType> n_pruned )
+{
+    Topologies topologies;
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> n_nodes_per_topo(
+        "n_nodes_per_topo" );
+    auto n_nodes_per_topo_host = Kokkos::create_mirror_view( n_nodes_per_topo );
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+        n_nodes_per_topo_host( topo_id ) = topologies[topo_id].n_nodes;
+    Kokkos::deep_copy( n_nodes_per_topo, n_nodes_per_topo_host );
+
+    using ExecutionSpace = typename DeviceType::execution_space;
+    unsigned int const n_candidates = permutation.extent( 0 );
+    Functor::HalfSpaceFilter<DeviceType> half_space_filter(
+        PointInCell<DeviceType>::threshold, dim );
+    Functor::MultiTopologyPointInCell<DeviceType, CellNodes> search_functor(
+        PointInCell<DeviceType>::threshold, dim, cells, half_space_filter,
+        n_nodes_per_topo, permutation, topo, bounding_box_to_cell,
+        coarse_search_output_cells, physical_points, cell_indices,
+        reference_points, point_in_cell, n_points_in_cell, n_pruned );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "point_in_cell" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_candidates ),
+        search_functor );
+    Kokkos::fence();
+}
+
+// Return the index of the cell [edges(i), edges(i+1)) containing x or -1 if x
+// is outside of the edges. Points outside of the edges but within threshold
+// (relative to the size of the first or last cell) are kept.
+template <typename ViewType>
+KOKKOS_INLINE_FUNCTION int findCell( ViewType edges, double const x,
+                                     double const threshold )
+{
+    int const n_cells = edges.extent( 0 ) - 1;
+    if ( x < edges( 0 ) )
+        return ( edges( 0 ) - x <= threshold * ( edges( 1 ) - edges( 0 ) ) )
+                   ? 0
+                   : -1;
+    if ( x >= edges( n_cells ) )
+        return ( x - edges( n_cells ) <=
+                 threshold * ( edges( n_cells ) - edges( n_cells - 1 ) ) )
+                   ? n_cells - 1
+                   : -1;
+
+    // Binary search with the invariant edges(first) <= x < edges(last)
+    int first = 0;
+    int last = n_cells;
+    while ( last - first > 1 )
+    {
+        int const middle = ( first + last ) / 2;
+        if ( edges( middle ) <= x )
+            first = middle;
+        else
+            last = middle;
+    }
+    return first;
+}
+
+// Return the block b such that block_offsets(b) <= cell < block_offsets(b+1)
+template <typename ViewType>
+KOKKOS_INLINE_FUNCTION int findBlock( ViewType block_offsets, int const cell )
+{
+    int first = 0;
+    int last = block_offsets.extent( 0 ) - 1;
+    while ( last - first > 1 )
+    {
+        int const middle = ( first + last ) / 2;
+        if ( block_offsets( middle ) <= cell )
+            first = middle;
+        else
+            last = middle;
+    }
+    return first;
+}
+
 template <typename ViewType>
 void sendDataAcrossNetwork( ArborX::Details::Distributor const &distributor,
                             std::pair<ViewType, ViewType> data )
@@ -151,12 +242,16 @@ moveDataFromSourceToTarget( MPI_Comm comm,
     Kokkos::deep_copy( exported_ranks, comm_rank );
 
     Kokkos::View<ArborX::Point *, DeviceType> imported_points(
-        "imported_points", n_imports );
-    Kokkos::View<int *, DeviceType> imported_cell_indices( "imported_indices",
-                                                           n_imports );
-    Kokkos::View<int *, DeviceType> imported_query_ids( "imported_query_ids",
-                                                        n_imports );
-    Kokkos::View<int *, DeviceType> imported_ranks( "ranks", n_imports );
+        Kokkos::ViewAllocateWithoutInitializing( "imported_points" ),
+        n_imports );
+    Kokkos::View<int *, DeviceType> imported_cell_indices(
+        Kokkos::ViewAllocateWithoutInitializing( "imported_indices" ),
+        n_imports );
+    Kokkos::View<int *, DeviceType> imported_query_ids(
+        Kokkos::ViewAllocateWithoutInitializing( "imported_query_ids" ),
+        n_imports );
+    Kokkos::View<int *, DeviceType> imported_ranks(
+        Kokkos::ViewAllocateWithoutInitializing( "ranks" ), n_imports );
 
     sendDataAcrossNetwork(
         source_to_target_distributor,
@@ -174,47 +269,25 @@ template <typename DeviceType>
 PointSearch<DeviceType>::PointSearch(
     MPI_Comm comm, Mesh<DeviceType> const &mesh,
     Kokkos::View<double **, DeviceType> points_coordinates )
-    : _comm( comm )
-    , _target_to_source_distributor( _comm )
+    : PointSearch( MeshIndex<DeviceType>( comm, mesh ), points_coordinates )
 {
-    DTK_REQUIRE( points_coordinates.extent( 1 ) ==
-                 mesh.nodes_coordinates.extent( 1 ) );
-    _dim = points_coordinates.extent( 1 );
-
-    // Compute the number of cells of each of the supported topologies.
-    std::array<unsigned int, DTK_N_TOPO> n_cells_per_topo =
-        Discretization::Helpers::computeNCellsPerTopology(
-            mesh.cell_topologies );
-
-    // Compute the topology and node offset
-    Discretization::Helpers::MeshOffsets<DeviceType> mesh_offsets( mesh );
-
-    // Convert the cells and cell_nodes_coordinates View to block_cells
-    auto n_nodes_per_topo_host =
-        Kokkos::create_mirror_view( mesh_offsets.n_nodes_per_topo );
-    Kokkos::deep_copy( n_nodes_per_topo_host, mesh_offsets.n_nodes_per_topo );
-    std::array<Kokkos::View<double ***, DeviceType>, DTK_N_TOPO> block_cells;
-    for ( int i = 0; i < DTK_N_TOPO; ++i )
-    {
-        block_cells[i] = Kokkos::View<double ***, DeviceType>(
-            "block_cells_" + std::to_string( i ), n_cells_per_topo[i],
-            n_nodes_per_topo_host( i ), _dim );
-    }
-    Discretization::Helpers::convertMesh( mesh, mesh_offsets, block_cells );
-
-    // Initialize bounding_box_to_cell to an invalid state
-    Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell(
-        "bounding_box_to_cell", mesh.cell_topologies.extent( 0 ), DTK_N_TOPO );
-    Kokkos::deep_copy( bounding_box_to_cell, static_cast<unsigned int>( -1 ) );
+}
 
-    Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes(
-        "bounding_boxes", mesh.cell_topologies.extent( 0 ) );
-    Discretization::Helpers::createBoundingBoxes(
-        mesh, mesh_offsets, block_cells, bounding_boxes, bounding_box_to_cell );
+template <typename DeviceType>
+PointSearch<DeviceType>::PointSearch(
+    MeshIndex<DeviceType> const &mesh_index,
+    Kokkos::View<double **, DeviceType> points_coordinates )
+    : _comm( mesh_index._comm )
+    , _target_to_source_distributor( _comm )
+    , _dim( mesh_index._dim )
+    , _cell_indices_map( mesh_index._cell_indices_map )
+    , _n_candidates( 0 )
+    , _n_pruned_candidates( 0 )
+{
+    DTK_REQUIRE( points_coordinates.extent( 1 ) == _dim );
 
     // Perform the distributed search. At the end of the distributed search the
     // points are moved from the "source processors" to the "target processors".
-    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> per_topo_ranks;
     Kokkos::View<ArborX::Point *, DeviceType> imported_points;
     Kokkos::View<int *, DeviceType> imported_query_ids;
     Kokkos::View<int *, DeviceType> imported_cell_indices;
@@ -224,41 +297,63 @@ PointSearch<DeviceType>::PointSearch(
         performDistributedSearch(
             ( _dim == 3 ) ? points_coordinates
                           : internal::convertPointDim( points_coordinates ),
-            bounding_boxes );
+            *mesh_index._distributed_tree );
 
-    // We need to separate the data for the different topologies because of
-    // Intrepid2. Because a point can be found in multiple cells, we need to
-    // compute the number of cells of each topology.
+    // Because a point can be found in multiple cells, we need to compute the
+    // topology of each candidate and the number of candidates of each
+    // topology.
     unsigned int const n_imports = imported_points.extent( 0 );
     Kokkos::View<unsigned int *, DeviceType> topo( "topo", n_imports );
     Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> topo_size( "topo_size" );
-    internal::buildTopo( imported_cell_indices, bounding_box_to_cell, topo,
-                         topo_size );
-    auto topo_size_host = Kokkos::create_mirror_view( topo_size );
-    Kokkos::deep_copy( topo_size_host, topo_size );
+    internal::buildTopo( imported_cell_indices,
+                         mesh_index._bounding_box_to_cell, topo, topo_size );
 
-    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> filtered_ranks;
     // Check if the points are in the cells
-    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
-        if ( block_cells[topo_id].extent( 0 ) != 0 )
-        {
-            filtered_ranks[topo_id] = performPointInCell(
-                block_cells[topo_id], bounding_box_to_cell,
-                imported_cell_indices, imported_points, imported_query_ids,
-                imported_ranks, topo, topo_id, topo_size_host( topo_id ) );
-        }
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> filtered_ranks =
+        performPointInCell( mesh_index, imported_cell_indices, imported_points,
+                            imported_query_ids, imported_ranks, topo,
+                            topo_size );
 
     // Build the _source_to_target_distributor
     build_distributor( filtered_ranks );
+}
 
-    // Build a map between the cell_indices sorted by topology and the flat View
-    // given to the constructor
-    auto cell_topologies_host =
-        Kokkos::create_mirror_view( mesh.cell_topologies );
-    Kokkos::deep_copy( cell_topologies_host, mesh.cell_topologies );
-    unsigned int const size = cell_topologies_host.extent( 0 );
-    for ( unsigned int i = 0; i < size; ++i )
-        _cell_indices_map[cell_topologies_host( i )].push_back( i );
+template <typename DeviceType>
+PointSearch<DeviceType>::PointSearch(
+    MPI_Comm comm, StructuredMesh<DeviceType> const &mesh,
+    Kokkos::View<double **, DeviceType> points_coordinates )
+    : _comm( comm )
+    , _target_to_source_distributor( _comm )
+    , _dim( mesh.dim() )
+    , _cell_indices_map(
+          std::make_shared<
+              std::array<std::vector<unsigned int>, DTK_N_TOPO>>() )
+    , _n_candidates( 0 )
+    , _n_pruned_candidates( 0 )
+{
+    DTK_REQUIRE( points_coordinates.extent( 1 ) == _dim );
+    int comm_size;
+    MPI_Comm_size( _comm, &comm_size );
+    DTK_REQUIRE( static_cast<int>( mesh.numBlocks() ) == comm_size );
+
+    // All the cells have the same topology. The results are directly moved to
+    // the processors owning the cells.
+    unsigned int const topo_id = mesh.topology();
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> filtered_ranks;
+    std::tie( _reference_points[topo_id], _cell_indices[topo_id],
+              _query_ids[topo_id], filtered_ranks[topo_id] ) =
+        performStructuredSearch( mesh, points_coordinates );
+    _n_candidates = _query_ids[topo_id].extent( 0 );
+
+    // The local cells are already numbered contiguously
+    int comm_rank;
+    MPI_Comm_rank( _comm, &comm_rank );
+    auto &cell_indices_map = ( *_cell_indices_map )[topo_id];
+    cell_indices_map.resize( mesh.numLocalCells( comm_rank ) );
+    std::iota( cell_indices_map.begin(), cell_indices_map.end(), 0 );
+
+    // Build the _source_to_target_distributor
+    build_distributor( filtered_ranks );
 }
 
 template <typename DeviceType>
@@ -267,72 +362,75 @@ std::tuple<Kokkos::View<int *, DeviceType>, Kokkos::View<int *, DeviceType>,
            Kokkos::View<unsigned int *, DeviceType>>
 PointSearch<DeviceType>::getSearchResults() const
 {
-    // Flatten the results
+    // Flatten the results. The results of all the topologies are copied by a
+    // single kernel.
     using ExecutionSpace = typename DeviceType::execution_space;
-    unsigned int n_ref_pts = 0;
+    Kokkos::Array<unsigned int, DTK_N_TOPO + 1> topo_offsets;
+    Kokkos::Array<Kokkos::View<Coordinate **, DeviceType>, DTK_N_TOPO>
+        topo_ref_pts;
+    Kokkos::Array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> topo_query_ids;
+    Kokkos::Array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO>
+        topo_cell_indices;
+    topo_offsets[0] = 0;
     for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
-        n_ref_pts += _reference_points[topo_id].extent( 0 );
+    {
+        topo_offsets[topo_id + 1] =
+            topo_offsets[topo_id] + _reference_points[topo_id].extent( 0 );
+        topo_ref_pts[topo_id] = _reference_points[topo_id];
+        topo_query_ids[topo_id] = _query_ids[topo_id];
+        topo_cell_indices[topo_id] = _cell_indices[topo_id];
+    }
+    unsigned int const n_ref_pts = topo_offsets[DTK_N_TOPO];
 
     Kokkos::View<int *, DeviceType> ranks( "ranks", n_ref_pts );
     int comm_rank;
     MPI_Comm_rank( _comm, &comm_rank );
     Kokkos::deep_copy( ranks, comm_rank );
     Kokkos::View<int *, DeviceType> cell_indices( "cell_indices", n_ref_pts );
-    auto cell_indices_host = Kokkos::create_mirror_view( cell_indices );
     Kokkos::View<unsigned int *, DeviceType> query_ids( "query_ids",
                                                         n_ref_pts );
     Kokkos::View<ArborX::Point *, DeviceType> ref_pts( "ref_pts", n_ref_pts );
-    unsigned int n_copied_pts = 0;
+    unsigned int const dim = _dim;
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "flatten_results" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_ref_pts ),
+        KOKKOS_LAMBDA( int const i ) {
+            unsigned int topo_id = 0;
+            while ( static_cast<unsigned int>( i ) >=
+                    topo_offsets[topo_id + 1] )
+                ++topo_id;
+            unsigned int const k = i - topo_offsets[topo_id];
+            query_ids( i ) = topo_query_ids[topo_id]( k );
+            cell_indices( i ) = topo_cell_indices[topo_id]( k );
+            for ( unsigned int d = 0; d < dim; ++d )
+                ref_pts( i )[d] = topo_ref_pts[topo_id]( k, d );
+        } );
+    Kokkos::fence();
+
+    // Convert the cell indices of each topology to the indices of the mesh.
+    // This has to be done on the host because _cell_indices_map only exists
+    // on the host.
+    auto cell_indices_host = Kokkos::create_mirror_view( cell_indices );
+    Kokkos::deep_copy( cell_indices_host, cell_indices );
     for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
-    {
-        unsigned int const size = _query_ids[topo_id].extent( 0 );
-
-        // First fill cell_indices. This has to be done on the host because
-        // _cell_indices_map only exists on the host.
-        auto topo_cell_indices_host =
-            Kokkos::create_mirror_view( _cell_indices[topo_id] );
-        Kokkos::deep_copy( topo_cell_indices_host, _cell_indices[topo_id] );
-        for ( unsigned int i = 0; i < size; ++i )
-        {
-            cell_indices_host( i + n_copied_pts ) =
-                _cell_indices_map[topo_id][topo_cell_indices_host( i )];
-        }
-
-        // Fill query_ids
-        auto topo_query_ids = _query_ids[topo_id];
-        Kokkos::parallel_for( DTK_MARK_REGION( "query_ids" ),
-                              Kokkos::RangePolicy<ExecutionSpace>( 0, size ),
-                              KOKKOS_LAMBDA( int const i ) {
-                                  query_ids( i + n_copied_pts ) =
-                                      topo_query_ids( i );
-                              } );
-        Kokkos::fence();
-
-        // Fill ref_pts
-        unsigned int dim = _dim;
-        auto topo_ref_pts = _reference_points[topo_id];
-        Kokkos::parallel_for( DTK_MARK_REGION( "fill_ref_pts" ),
-                              Kokkos::RangePolicy<ExecutionSpace>( 0, size ),
-                              KOKKOS_LAMBDA( int const i ) {
-                                  for ( unsigned int d = 0; d < dim; ++d )
-                                      ref_pts( i + n_copied_pts )[d] =
-                                          topo_ref_pts( i, d );
-                              } );
-        Kokkos::fence();
-
-        n_copied_pts += size;
-    }
+        for ( unsigned int i = topo_offsets[topo_id];
+              i < topo_offsets[topo_id + 1]; ++i )
+            cell_indices_host( i ) =
+                ( *_cell_indices_map )[topo_id][cell_indices_host( i )];
     Kokkos::deep_copy( cell_indices, cell_indices_host );
 
     // Communicate the results
     unsigned int n_imports =
         _target_to_source_distributor.getTotalReceiveLength();
-    Kokkos::View<int *, DeviceType> imported_ranks( "imported_ranks",
-                                                    n_imports );
+    Kokkos::View<int *, DeviceType> imported_ranks(
+        Kokkos::ViewAllocateWithoutInitializing( "imported_ranks" ),
+        n_imports );
     Kokkos::View<int *, DeviceType> imported_cell_indices(
-        "imported_cell_indices", n_imports );
+        Kokkos::ViewAllocateWithoutInitializing( "imported_cell_indices" ),
+        n_imports );
     Kokkos::View<ArborX::Point *, DeviceType> imported_ref_pts(
-        "imported_ref_pts", n_imports );
+        Kokkos::ViewAllocateWithoutInitializing( "imported_ref_pts" ),
+        n_imports );
     Kokkos::View<unsigned int *, DeviceType> imported_query_ids(
         "imported_query_ids", n_imports );
 
@@ -376,13 +474,10 @@ std::tuple<Kokkos::View<ArborX::Point *, DeviceType>,
            Kokkos::View<int *, DeviceType>>
 PointSearch<DeviceType>::performDistributedSearch(
     Kokkos::View<double **, DeviceType> points_coord,
-    Kokkos::View<ArborX::Box *, DeviceType> bounding_boxes )
+    ArborX::DistributedSearchTree<DeviceType> const &distributed_tree )
 {
     DTK_REQUIRE( points_coord.extent( 1 ) == 3 );
 
-    ArborX::DistributedSearchTree<DeviceType> distributed_tree(
-        _comm, bounding_boxes );
-
     unsigned int const n_points = points_coord.extent( 0 );
 
     // Build the queries
@@ -410,166 +505,287 @@ PointSearch<DeviceType>::performDistributedSearch(
 }
 
 template <typename DeviceType>
-std::tuple<Kokkos::View<int *, DeviceType>, Kokkos::View<double **, DeviceType>,
-           Kokkos::View<int *, DeviceType>, Kokkos::View<int *, DeviceType>>
-PointSearch<DeviceType>::filterTopology(
-    Kokkos::View<unsigned int *, DeviceType> topo, unsigned int topo_id,
-    unsigned int size,
-    Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell,
-    Kokkos::View<int *, DeviceType> cell_indices,
-    Kokkos::View<ArborX::Point *, DeviceType> points,
-    Kokkos::View<int *, DeviceType> query_ids,
-    Kokkos::View<int *, DeviceType> ranks )
+std::tuple<Kokkos::View<Coordinate **, DeviceType>,
+           Kokkos::View<int *, DeviceType>, Kokkos::View<int *, DeviceType>,
+           Kokkos::View<int *, DeviceType>>
+PointSearch<DeviceType>::performStructuredSearch(
+    StructuredMesh<DeviceType> const &mesh,
+    Kokkos::View<double **, DeviceType> points_coord )
 {
-    DTK_REQUIRE( topo.extent( 0 ) == ranks.extent( 0 ) );
-    DTK_REQUIRE( query_ids.extent( 0 ) == ranks.extent( 0 ) );
-    DTK_REQUIRE( bounding_box_to_cell.extent( 1 ) > topo_id );
+    DTK_REQUIRE( points_coord.extent( 1 ) == _dim );
 
     using ExecutionSpace = typename DeviceType::execution_space;
-    unsigned int const n_imports = topo.extent( 0 );
-    Kokkos::View<unsigned int *, DeviceType> offset( "offset", n_imports );
-    Discretization::Helpers::computeOffset( topo, topo_id, offset );
-
-    // Create Kokkos::View with the points and the cell indices associated
-    // with cells of topo_id topology. Also transform 3D points back to 2D
-    // points.
-    Kokkos::View<double **, DeviceType> filtered_per_topo_points(
-        "filtered_per_topo_points", size, _dim );
-    Kokkos::View<int *, DeviceType> filtered_per_topo_cell_indices(
-        "filtered_per_topo_cell_indices_" + std::to_string( topo_id ), size );
-    Kokkos::View<int *, DeviceType> filtered_per_topo_query_ids(
-        "filtered_per_topo_query_ids_" + std::to_string( topo_id ), size );
-    Kokkos::View<int *, DeviceType> filtered_per_topo_ranks(
-        "filtered_per_topo_ranks_" + std::to_string( topo_id ), size );
-    unsigned int dim = _dim;
+    unsigned int const n_points = points_coord.extent( 0 );
+    unsigned int const dim = _dim;
+    double const threshold = PointInCell<DeviceType>::threshold;
+    // We cannot use the members of mesh in a lambda function with CUDA
+    auto x_edges = mesh.x_edges;
+    auto y_edges = mesh.y_edges;
+    auto z_edges = mesh.z_edges;
+    auto x_block_offsets = mesh.x_block_offsets;
+    auto y_block_offsets = mesh.y_block_offsets;
+    auto z_block_offsets = mesh.z_block_offsets;
+    int const n_x_blocks = x_block_offsets.extent( 0 ) - 1;
+    int const n_y_blocks = y_block_offsets.extent( 0 ) - 1;
+
+    // Find the cell, the owning rank, and the position in the reference cell
+    // [-1, 1]^dim of each point
+    Kokkos::View<bool *, DeviceType> found( "found", n_points );
+    Kokkos::View<int *, DeviceType> owners( "owners", n_points );
+    Kokkos::View<int *, DeviceType> cell_indices( "cell_indices", n_points );
+    Kokkos::View<ArborX::Point *, DeviceType> reference_points(
+        "reference_points", n_points );
     Kokkos::parallel_for(
-        "filter_data", Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+        DTK_MARK_REGION( "structured_search" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
         KOKKOS_LAMBDA( int const i ) {
-            if ( topo( i ) == topo_id )
+            int cell[3] = {0, 0, 0};
+            int block[3] = {0, 0, 0};
+            int n_block_cells[3] = {1, 1, 1};
+            for ( unsigned int d = 0; d < dim; ++d )
+            {
+                auto edges =
+                    ( d == 0 ) ? x_edges : ( ( d == 1 ) ? y_edges : z_edges );
+                auto block_offsets =
+                    ( d == 0 ) ? x_block_offsets
+                               : ( ( d == 1 ) ? y_block_offsets
+                                              : z_block_offsets );
+                double const x = points_coord( i, d );
+                int const global_cell =
+                    internal::findCell( edges, x, threshold );
+                if ( global_cell == -1 )
+                {
+                    found( i ) = false;
+                    return;
+                }
+                block[d] = internal::findBlock( block_offsets, global_cell );
+                cell[d] = global_cell - block_offsets( block[d] );
+                n_block_cells[d] =
+                    block_offsets( block[d] + 1 ) - block_offsets( block[d] );
+                reference_points( i )[d] =
+                    2. * ( x - edges( global_cell ) ) /
+                        ( edges( global_cell + 1 ) - edges( global_cell ) ) -
+                    1.;
+            }
+            found( i ) = true;
+            owners( i ) =
+                block[0] + n_x_blocks * ( block[1] + n_y_blocks * block[2] );
+            cell_indices( i ) =
+                cell[0] +
+                n_block_cells[0] * ( cell[1] + n_block_cells[1] * cell[2] );
+        } );
+    Kokkos::fence();
+
+    // Only send the points that were found
+    int n_found = 0;
+    Kokkos::parallel_reduce(
+        DTK_MARK_REGION( "count_found_points" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+        KOKKOS_LAMBDA( int i, int &partial_sum ) {
+            if ( found( i ) == true )
+                partial_sum += 1;
+        },
+        n_found );
+    Kokkos::View<unsigned int *, DeviceType> offset( "offset", n_points );
+    Discretization::Helpers::computeOffset( found, true, offset );
+
+    Kokkos::View<int *, DeviceType> exported_owners( "exported_owners",
+                                                     n_found );
+    Kokkos::View<int *, DeviceType> exported_cell_indices(
+        "exported_cell_indices", n_found );
+    Kokkos::View<ArborX::Point *, DeviceType> exported_reference_points(
+        "exported_reference_points", n_found );
+    Kokkos::View<int *, DeviceType> exported_query_ids( "exported_query_ids",
+                                                        n_found );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "filter_found_points" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
+        KOKKOS_LAMBDA( int const i ) {
+            if ( found( i ) )
             {
                 unsigned int const k = offset( i );
-                filtered_per_topo_cell_indices( k ) =
-                    bounding_box_to_cell( cell_indices( i ), topo_id );
-                for ( unsigned int j = 0; j < dim; ++j )
-                    filtered_per_topo_points( k, j ) = points( i )[j];
-                filtered_per_topo_query_ids( k ) = query_ids( i );
-                filtered_per_topo_ranks( k ) = ranks( i );
+                exported_owners( k ) = owners( i );
+                exported_cell_indices( k ) = cell_indices( i );
+                exported_reference_points( k ) = reference_points( i );
+                exported_query_ids( k ) = i;
             }
         } );
     Kokkos::fence();
 
-    return std::make_tuple(
-        filtered_per_topo_cell_indices, filtered_per_topo_points,
-        filtered_per_topo_query_ids, filtered_per_topo_ranks );
-}
+    Kokkos::View<int *, DeviceType> exported_ranks( "exported_ranks",
+                                                    n_found );
+    int comm_rank;
+    MPI_Comm_rank( _comm, &comm_rank );
+    Kokkos::deep_copy( exported_ranks, comm_rank );
 
-template <typename DeviceType>
-Kokkos::View<int *, DeviceType> PointSearch<DeviceType>::filterInCell(
-    Kokkos::View<bool *, DeviceType> filtered_per_topo_point_in_cell,
-    Kokkos::View<double **, DeviceType> filtered_per_topo_reference_points,
-    Kokkos::View<int *, DeviceType> filtered_per_topo_cell_indices,
-    Kokkos::View<int *, DeviceType> filtered_per_topo_query_ids,
-    Kokkos::View<int *, DeviceType> filtered_per_topo_ranks,
-    unsigned int topo_id )
-{
-    using ExecutionSpace = typename DeviceType::execution_space;
-    unsigned int dim = _dim;
+    // Send the results to the processors owning the cells
+    auto exported_owners_host = Kokkos::create_mirror_view( exported_owners );
+    Kokkos::deep_copy( exported_owners_host, exported_owners );
+    ArborX::Details::Distributor source_to_target_distributor( _comm );
+    unsigned int const n_imports =
+        source_to_target_distributor.createFromSends( exported_owners_host );
 
-    Kokkos::View<int *, DeviceType> filtered_ranks;
-    unsigned int n_ref_points = filtered_per_topo_point_in_cell.extent( 0 );
-    if ( n_ref_points != 0 )
-    {
-        int n_filtered_ref_points = 0;
-        Kokkos::View<bool *, DeviceType> pt_in_cell =
-            filtered_per_topo_point_in_cell;
-        Kokkos::parallel_reduce(
-            DTK_MARK_REGION( "compute_n_ref_pts" ),
-            Kokkos::RangePolicy<ExecutionSpace>( 0, n_ref_points ),
-            KOKKOS_LAMBDA( int i, int &partial_sum ) {
-                if ( pt_in_cell[i] == true )
-                    partial_sum += 1;
-            },
-            n_filtered_ref_points );
-
-        // We are only interested in points that belong to the cells. So we
-        // need to filter out all the points that were false positive of
-        // the distributed search.
-        Kokkos::realloc( _reference_points[topo_id], n_filtered_ref_points,
-                         _dim );
-        Kokkos::realloc( _query_ids[topo_id], n_filtered_ref_points );
-        Kokkos::realloc( _cell_indices[topo_id], n_filtered_ref_points );
-        Kokkos::realloc( filtered_ranks, n_filtered_ref_points );
+    Kokkos::View<int *, DeviceType> imported_cell_indices(
+        Kokkos::ViewAllocateWithoutInitializing( "imported_cell_indices" ),
+        n_imports );
+    Kokkos::View<ArborX::Point *, DeviceType> imported_points(
+        Kokkos::ViewAllocateWithoutInitializing( "imported_points" ),
+        n_imports );
+    Kokkos::View<int *, DeviceType> imported_query_ids(
+        Kokkos::ViewAllocateWithoutInitializing( "imported_query_ids" ),
+        n_imports );
+    Kokkos::View<int *, DeviceType> imported_ranks(
+        Kokkos::ViewAllocateWithoutInitializing( "imported_ranks" ),
+        n_imports );
+    internal::sendDataAcrossNetwork(
+        source_to_target_distributor,
+        std::make_pair( exported_cell_indices, imported_cell_indices ),
+        std::make_pair( exported_reference_points, imported_points ),
+        std::make_pair( exported_query_ids, imported_query_ids ),
+        std::make_pair( exported_ranks, imported_ranks ) );
 
-        // We cannot use private member in a lambda function with CUDA
-        Kokkos::View<Coordinate **, DeviceType> ref_points =
-            _reference_points[topo_id];
-        Kokkos::View<int *, DeviceType> query_ids = _query_ids[topo_id];
-        Kokkos::View<int *, DeviceType> cell_indices = _cell_indices[topo_id];
-
-        Kokkos::View<unsigned int *, DeviceType> offset( "offset",
-                                                         n_ref_points );
-        Discretization::Helpers::computeOffset( pt_in_cell, true, offset );
-        Kokkos::parallel_for(
-            DTK_MARK_REGION( "filter" ),
-            Kokkos::RangePolicy<ExecutionSpace>( 0, n_ref_points ),
-            KOKKOS_LAMBDA( int const i ) {
-                if ( pt_in_cell[i] )
-                {
-                    unsigned int k = offset( i );
-                    for ( unsigned int d = 0; d < dim; ++d )
-                        ref_points( k, d ) =
-                            filtered_per_topo_reference_points( i, d );
-                    query_ids( k ) = filtered_per_topo_query_ids( i );
-                    cell_indices( k ) = filtered_per_topo_cell_indices( i );
-                    filtered_ranks( k ) = filtered_per_topo_ranks( i );
-                }
-            } );
-        Kokkos::fence();
-    }
+    Kokkos::View<Coordinate **, DeviceType> imported_reference_points(
+        Kokkos::ViewAllocateWithoutInitializing( "imported_reference_points" ),
+        n_imports, dim );
+    Kokkos::parallel_for( DTK_MARK_REGION( "convert_reference_points" ),
+                          Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+                          KOKKOS_LAMBDA( int const i ) {
+                              for ( unsigned int d = 0; d < dim; ++d )
+                                  imported_reference_points( i, d ) =
+                                      imported_points( i )[d];
+                          } );
+    Kokkos::fence();
 
-    return filtered_ranks;
+    return std::make_tuple( imported_reference_points, imported_cell_indices,
+                            imported_query_ids, imported_ranks );
 }
 
 template <typename DeviceType>
-Kokkos::View<int *, DeviceType> PointSearch<DeviceType>::performPointInCell(
-    Kokkos::View<double ***, DeviceType> cells,
-    Kokkos::View<unsigned int **, DeviceType> bounding_box_to_cell,
+std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO>
+PointSearch<DeviceType>::performPointInCell(
+    MeshIndex<DeviceType> const &mesh_index,
     Kokkos::View<int *, DeviceType> imported_cell_indices,
     Kokkos::View<ArborX::Point *, DeviceType> imported_points,
     Kokkos::View<int *, DeviceType> imported_query_ids,
     Kokkos::View<int *, DeviceType> imported_ranks,
-    Kokkos::View<unsigned int *, DeviceType> topo, unsigned int topo_id,
-    unsigned int size )
+    Kokkos::View<unsigned int *, DeviceType> topo,
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> topo_size )
 {
-    // Filter the data for a given topology
-    Kokkos::View<double **, DeviceType> filtered_per_topo_points;
-    Kokkos::View<int *, DeviceType> filtered_per_topo_cell_indices;
-    Kokkos::View<int *, DeviceType> filtered_per_topo_query_ids;
-    Kokkos::View<int *, DeviceType> filtered_per_topo_ranks;
-    std::tie( filtered_per_topo_cell_indices, filtered_per_topo_points,
-              filtered_per_topo_query_ids, filtered_per_topo_ranks ) =
-        filterTopology( topo, topo_id, size, bounding_box_to_cell,
-                        imported_cell_indices, imported_points,
-                        imported_query_ids, imported_ranks );
-
-    // Perform the PointInCell search
-    Topologies topologies;
-    Kokkos::View<double **, DeviceType> filtered_per_topo_reference_points(
-        "filtered_per_topo_reference_points_" + std::to_string( topo_id ), size,
-        _dim );
-    Kokkos::View<bool *, DeviceType> filtered_per_topo_point_in_cell(
-        "filtered_per_topo_point_in_cell_" + std::to_string( topo_id ), size );
-    PointInCell<DeviceType>::search(
-        filtered_per_topo_points, cells, filtered_per_topo_cell_indices,
-        topologies[topo_id].topo, filtered_per_topo_reference_points,
-        filtered_per_topo_point_in_cell );
-
-    // Filter the points. Only keep the points that are in cell
-    Kokkos::View<int *, DeviceType> filtered_ranks;
-    filtered_ranks = filterInCell(
-        filtered_per_topo_point_in_cell, filtered_per_topo_reference_points,
-        filtered_per_topo_cell_indices, filtered_per_topo_query_ids,
-        filtered_per_topo_ranks, topo_id );
+    DTK_REQUIRE( topo.extent( 0 ) == imported_cell_indices.extent( 0 ) );
+
+    using ExecutionSpace = typename DeviceType::execution_space;
+    unsigned int const n_imports = topo.extent( 0 );
+
+    // Sort the candidates by topology. The candidates of a given topology are
+    // contiguous but their order inside of the segment is not specified.
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> segment_offsets(
+        "segment_offsets" );
+    ArborX::exclusivePrefixSum( topo_size, segment_offsets );
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> segment_sizes(
+        "segment_sizes" );
+    Kokkos::View<unsigned int *, DeviceType> permutation( "permutation",
+                                                          n_imports );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "sort_by_topology" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+        KOKKOS_LAMBDA( int const i ) {
+            unsigned int const topo_id = topo( i );
+            unsigned int const j =
+                segment_offsets( topo_id ) +
+                Kokkos::atomic_fetch_add( &segment_sizes( topo_id ), 1u );
+            permutation( j ) = i;
+        } );
+    Kokkos::fence();
+
+    // Perform the PointInCell search for all the topologies at once
+    Kokkos::View<int *, DeviceType> cell_indices( "cell_indices", n_imports );
+    Kokkos::View<Coordinate **, DeviceType> reference_points(
+        "reference_points", n_imports, _dim );
+    Kokkos::View<bool *, DeviceType> point_in_cell( "point_in_cell",
+                                                    n_imports );
+    Kokkos::View<unsigned int[DTK_N_TOPO], DeviceType> n_points_in_cell(
+        "n_points_in_cell" );
+    Kokkos::View<unsigned int, DeviceType> n_pruned( "n_pruned" );
+    if ( mesh_index._cell_storage == CellStorage::BLOCK )
+        internal::multiTopologyPointInCell(
+            Discretization::Helpers::BlockCellNodes<DeviceType>(
+                mesh_index._block_cells ),
+            _dim, permutation, topo, mesh_index._bounding_box_to_cell,
+            imported_cell_indices, imported_points, cell_indices,
+            reference_points, point_in_cell, n_points_in_cell, n_pruned );
+    else
+        internal::multiTopologyPointInCell(
+            Discretization::Helpers::ConnectivityCellNodes<DeviceType>(
+                mesh_index._cells, mesh_index._cell_node_offsets,
+                mesh_index._nodes_coordinates ),
+            _dim, permutation, topo, mesh_index._bounding_box_to_cell,
+            imported_cell_indices, imported_points, cell_indices,
+            reference_points, point_in_cell, n_points_in_cell, n_pruned );
+
+    auto n_points_in_cell_host = Kokkos::create_mirror_view( n_points_in_cell );
+    Kokkos::deep_copy( n_points_in_cell_host, n_points_in_cell );
+    auto n_pruned_host = Kokkos::create_mirror_view( n_pruned );
+    Kokkos::deep_copy( n_pruned_host, n_pruned );
+    _n_candidates = n_imports;
+    _n_pruned_candidates = n_pruned_host();
+
+    // We are only interested in points that belong to the cells. So we need to
+    // filter out all the points that were false positive of the distributed
+    // search. Since the candidates are sorted by topology, the position of a
+    // point in the results of its topology is its position among all the
+    // points found minus the number of points found in the previous
+    // topologies.
+    std::array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> filtered_ranks;
+    Kokkos::Array<unsigned int, DTK_N_TOPO> topo_offsets;
+    Kokkos::Array<Kokkos::View<Coordinate **, DeviceType>, DTK_N_TOPO>
+        topo_ref_points;
+    Kokkos::Array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> topo_query_ids;
+    Kokkos::Array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO>
+        topo_cell_indices;
+    Kokkos::Array<Kokkos::View<int *, DeviceType>, DTK_N_TOPO> topo_ranks;
+    unsigned int n_found = 0;
+    for ( unsigned int topo_id = 0; topo_id < DTK_N_TOPO; ++topo_id )
+    {
+        unsigned int const size = n_points_in_cell_host( topo_id );
+        _reference_points[topo_id] = Kokkos::View<Coordinate **, DeviceType>(
+            "reference_points_" + std::to_string( topo_id ), size, _dim );
+        _query_ids[topo_id] = Kokkos::View<int *, DeviceType>(
+            "query_ids_" + std::to_string( topo_id ), size );
+        _cell_indices[topo_id] = Kokkos::View<int *, DeviceType>(
+            "cell_indices_" + std::to_string( topo_id ), size );
+        filtered_ranks[topo_id] = Kokkos::View<int *, DeviceType>(
+            "filtered_ranks_" + std::to_string( topo_id ), size );
+
+        // We cannot use private member in a lambda function with CUDA
+        topo_offsets[topo_id] = n_found;
+        topo_ref_points[topo_id] = _reference_points[topo_id];
+        topo_query_ids[topo_id] = _query_ids[topo_id];
+        topo_cell_indices[topo_id] = _cell_indices[topo_id];
+        topo_ranks[topo_id] = filtered_ranks[topo_id];
+        n_found += size;
+    }
+
+    unsigned int const dim = _dim;
+    Kokkos::View<unsigned int *, DeviceType> offset( "offset", n_imports );
+    Discretization::Helpers::computeOffset( point_in_cell, true, offset );
+    Kokkos::parallel_for(
+        DTK_MARK_REGION( "filter" ),
+        Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+        KOKKOS_LAMBDA( int const j ) {
+            if ( point_in_cell( j ) )
+            {
+                unsigned int const i = permutation( j );
+                unsigned int const topo_id = topo( i );
+                unsigned int const k = offset( j ) - topo_offsets[topo_id];
+                for ( unsigned int d = 0; d < dim; ++d )
+                    topo_ref_points[topo_id]( k, d ) =
+                        reference_points( j, d );
+                topo_query_ids[topo_id]( k ) = imported_query_ids( i );
+                topo_cell_indices[topo_id]( k ) = cell_indices( j );
+                topo_ranks[topo_id]( k ) = imported_ranks( i );
+            }
+        } );
+    Kokkos::fence();
 
     return filtered_ranks;
 }
@@ -0,0 +1,119 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_STRUCTURED_MESH_HPP
+#define DTK_STRUCTURED_MESH_HPP
+
+#include <DTK_CellTypes.h>
+#include <DTK_DBC.hpp>
+
+#include <Kokkos_Core.hpp>
+
+namespace DataTransferKit
+{
+/**
+ * Description of a rectilinear (Cartesian) mesh decomposed in blocks. The
+ * global mesh is given by the edges (node locations) along each axis and the
+ * decomposition by the index of the first cell of each block along each axis.
+ * The block (bi, bj, bk) is owned by the rank bi + n_x_blocks * (bj +
+ * n_y_blocks * bk) and its cells are numbered locally with the x index running
+ * fastest. The cells are QUAD_4 in 2D and HEX_8 in 3D. In 2D, the z views are
+ * empty.
+ */
+template <typename DeviceType>
+struct StructuredMesh
+{
+  public:
+    StructuredMesh( Kokkos::View<double *, DeviceType> x_edges_,
+                    Kokkos::View<double *, DeviceType> y_edges_,
+                    Kokkos::View<double *, DeviceType> z_edges_,
+                    Kokkos::View<int *, DeviceType> x_block_offsets_,
+                    Kokkos::View<int *, DeviceType> y_block_offsets_,
+                    Kokkos::View<int *, DeviceType> z_block_offsets_ )
+        : x_edges( x_edges_ )
+        , y_edges( y_edges_ )
+        , z_edges( z_edges_ )
+        , x_block_offsets( x_block_offsets_ )
+        , y_block_offsets( y_block_offsets_ )
+        , z_block_offsets( z_block_offsets_ )
+    {
+        DTK_REQUIRE( x_edges.extent( 0 ) > 1 );
+        DTK_REQUIRE( y_edges.extent( 0 ) > 1 );
+        DTK_REQUIRE( x_block_offsets.extent( 0 ) > 1 );
+        DTK_REQUIRE( y_block_offsets.extent( 0 ) > 1 );
+        DTK_REQUIRE( ( z_edges.extent( 0 ) == 0 &&
+                       z_block_offsets.extent( 0 ) == 0 ) ||
+                     ( z_edges.extent( 0 ) > 1 &&
+                       z_block_offsets.extent( 0 ) > 1 ) );
+    }
+
+    /// Dimension of the mesh
+    unsigned int dim() const { return ( z_edges.extent( 0 ) == 0 ) ? 2 : 3; }
+
+    /// Topology of the cells of the mesh
+    DTK_CellTopology topology() const
+    {
+        return ( dim() == 2 ) ? DTK_QUAD_4 : DTK_HEX_8;
+    }
+
+    /// Number of blocks, i.e., number of ranks over which the mesh is
+    /// distributed
+    unsigned int numBlocks() const
+    {
+        unsigned int n_blocks = ( x_block_offsets.extent( 0 ) - 1 ) *
+                                ( y_block_offsets.extent( 0 ) - 1 );
+        if ( dim() == 3 )
+            n_blocks *= z_block_offsets.extent( 0 ) - 1;
+        return n_blocks;
+    }
+
+    /// Number of cells in the block owned by \p comm_rank
+    unsigned int numLocalCells( int comm_rank ) const
+    {
+        auto n_cells = []( Kokkos::View<int *, DeviceType> offsets,
+                           int block ) {
+            auto offsets_host = Kokkos::create_mirror_view( offsets );
+            Kokkos::deep_copy( offsets_host, offsets );
+            return offsets_host( block + 1 ) - offsets_host( block );
+        };
+        int const n_x_blocks = x_block_offsets.extent( 0 ) - 1;
+        int const n_y_blocks = y_block_offsets.extent( 0 ) - 1;
+        unsigned int n_local_cells =
+            n_cells( x_block_offsets, comm_rank % n_x_blocks ) *
+            n_cells( y_block_offsets, ( comm_rank / n_x_blocks ) % n_y_blocks );
+        if ( dim() == 3 )
+            n_local_cells *= n_cells( z_block_offsets,
+                                      comm_rank / ( n_x_blocks * n_y_blocks ) );
+        return n_local_cells;
+    }
+
+    /// Edges of the mesh in the x direction sorted in increasing order (n x
+    /// nodes)
+    Kokkos::View<double *, DeviceType> x_edges;
+    /// Edges of the mesh in the y direction sorted in increasing order (n y
+    /// nodes)
+    Kokkos::View<double *, DeviceType> y_edges;
+    /// Edges of the mesh in the z direction sorted in increasing order (n z
+    /// nodes)
+    Kokkos::View<double *, DeviceType> z_edges;
+    /// Index of the first cell of each block in the x direction followed by
+    /// the number of cells in the x direction (n x blocks + 1)
+    Kokkos::View<int *, DeviceType> x_block_offsets;
+    /// Index of the first cell of each block in the y direction followed by
+    /// the number of cells in the y direction (n y blocks + 1)
+    Kokkos::View<int *, DeviceType> y_block_offsets;
+    /// Index of the first cell of each block in the z direction followed by
+    /// the number of cells in the z direction (n z blocks + 1)
+    Kokkos::View<int *, DeviceType> z_block_offsets;
+};
+} // namespace DataTransferKit
+
+#endif
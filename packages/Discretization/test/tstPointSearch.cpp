@@ -11,7 +11,9 @@
 
 #include "MeshGenerator.hpp"
 #include <DTK_Mesh.hpp>
+#include <DTK_MeshIndex.hpp>
 #include <DTK_PointSearch.hpp>
+#include <DTK_StructuredMesh.hpp>
 
 #include <Teuchos_UnitTestHarness.hpp>
 
@@ -317,6 +319,10 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, one_topo_three_dim, DeviceType )
     checkReferencePoints<dim, DeviceType>( ranks, cell_indices,
                                            reference_points, query_ids, ref_sol,
                                            success, out );
+
+    // The cells are aligned with the axes so the bounding boxes match the
+    // cells and no candidate can be rejected before the Newton solve.
+    TEST_EQUALITY( pt_search.getNumberOfPrunedCandidates(), 0 );
 }
 
 TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch,
@@ -443,6 +449,292 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, two_topo_two_dim, DeviceType )
                                            success, out );
 }
 
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, mesh_index, DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    unsigned int constexpr dim = 3;
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies_view;
+    Kokkos::View<unsigned int *, DeviceType> cells;
+    Kokkos::View<double **, DeviceType> coordinates;
+    std::vector<unsigned int> n_subdivisions = {{5, 5, 3}};
+    std::tie( cell_topologies_view, cells, coordinates ) =
+        buildStructuredMesh<DeviceType>( comm, n_subdivisions );
+
+    // Build the index of the mesh once
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies_view, cells,
+                                            coordinates );
+    DataTransferKit::MeshIndex<DeviceType> mesh_index( comm, mesh );
+
+    // Use it to locate a first set of points
+    Kokkos::View<double * [dim], DeviceType> points_coord =
+        getPointsCoord3D<DeviceType>( comm );
+    auto pt_search = mesh_index.locate( points_coord );
+    Kokkos::View<int *, DeviceType> ranks;
+    Kokkos::View<int *, DeviceType> cell_indices;
+    Kokkos::View<ArborX::Point *, DeviceType> reference_points;
+    Kokkos::View<unsigned int *, DeviceType> query_ids;
+    std::tie( ranks, cell_indices, reference_points, query_ids ) =
+        pt_search.getSearchResults();
+
+    // The results must be the same as the ones obtained without reusing the
+    // index
+    DataTransferKit::PointSearch<DeviceType> ref_pt_search( comm, mesh,
+                                                            points_coord );
+    Kokkos::View<int *, DeviceType> ref_ranks;
+    Kokkos::View<int *, DeviceType> ref_cell_indices;
+    Kokkos::View<ArborX::Point *, DeviceType> ref_reference_points;
+    Kokkos::View<unsigned int *, DeviceType> ref_query_ids;
+    std::tie( ref_ranks, ref_cell_indices, ref_reference_points,
+              ref_query_ids ) = ref_pt_search.getSearchResults();
+    TEST_EQUALITY( reference_points.extent( 0 ),
+                   ref_reference_points.extent( 0 ) );
+    auto query_ids_host = Kokkos::create_mirror_view( query_ids );
+    Kokkos::deep_copy( query_ids_host, query_ids );
+    auto ref_query_ids_host = Kokkos::create_mirror_view( ref_query_ids );
+    Kokkos::deep_copy( ref_query_ids_host, ref_query_ids );
+    TEST_COMPARE_ARRAYS( query_ids_host, ref_query_ids_host );
+
+    // Use it again to locate a second set of points that are not in the mesh
+    Kokkos::View<double * [dim], DeviceType> far_points_coord(
+        "far_points_coord", 1 );
+    Kokkos::deep_copy( far_points_coord, 10000. );
+    auto far_pt_search = mesh_index.locate( far_points_coord );
+    std::tie( ranks, cell_indices, reference_points, query_ids ) =
+        far_pt_search.getSearchResults();
+    TEST_EQUALITY( query_ids.extent( 0 ), 0 );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, prune_candidates, DeviceType )
+{
+    // Each processor owns a single tetrahedron and looks for two points inside
+    // its bounding box. Only the first point is inside the tetrahedron, the
+    // second one must be rejected before the Newton solve.
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    unsigned int constexpr dim = 3;
+    double const shift = 2. * comm_rank;
+
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies_view(
+        "cell_topologies", 1 );
+    Kokkos::deep_copy( cell_topologies_view, DTK_TET_4 );
+    Kokkos::View<unsigned int *, DeviceType> cells( "cells", 4 );
+    auto cells_host = Kokkos::create_mirror_view( cells );
+    for ( unsigned int i = 0; i < 4; ++i )
+        cells_host( i ) = i;
+    Kokkos::deep_copy( cells, cells_host );
+    Kokkos::View<double **, DeviceType> coordinates( "coordinates", 4, dim );
+    auto coordinates_host = Kokkos::create_mirror_view( coordinates );
+    Kokkos::deep_copy( coordinates_host, 0. );
+    for ( unsigned int i = 0; i < 4; ++i )
+        coordinates_host( i, 0 ) = shift;
+    coordinates_host( 1, 0 ) += 1.;
+    coordinates_host( 2, 1 ) = 1.;
+    coordinates_host( 3, 2 ) = 1.;
+    Kokkos::deep_copy( coordinates, coordinates_host );
+
+    Kokkos::View<double **, DeviceType> points_coord( "points_coord", 2, dim );
+    auto points_coord_host = Kokkos::create_mirror_view( points_coord );
+    points_coord_host( 0, 0 ) = shift + 0.1;
+    points_coord_host( 0, 1 ) = 0.2;
+    points_coord_host( 0, 2 ) = 0.3;
+    points_coord_host( 1, 0 ) = shift + 0.9;
+    points_coord_host( 1, 1 ) = 0.9;
+    points_coord_host( 1, 2 ) = 0.9;
+    Kokkos::deep_copy( points_coord, points_coord_host );
+
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies_view, cells,
+                                            coordinates );
+    DataTransferKit::PointSearch<DeviceType> pt_search( comm, mesh,
+                                                        points_coord );
+
+    TEST_EQUALITY( pt_search.getNumberOfCandidates(), 2 );
+    TEST_EQUALITY( pt_search.getNumberOfPrunedCandidates(), 1 );
+
+    Kokkos::View<int *, DeviceType> ranks;
+    Kokkos::View<int *, DeviceType> cell_indices;
+    Kokkos::View<ArborX::Point *, DeviceType> reference_points;
+    Kokkos::View<unsigned int *, DeviceType> query_ids;
+    std::tie( ranks, cell_indices, reference_points, query_ids ) =
+        pt_search.getSearchResults();
+
+    TEST_EQUALITY( query_ids.extent( 0 ), 1 );
+    auto ranks_host = Kokkos::create_mirror_view( ranks );
+    Kokkos::deep_copy( ranks_host, ranks );
+    auto query_ids_host = Kokkos::create_mirror_view( query_ids );
+    Kokkos::deep_copy( query_ids_host, query_ids );
+    TEST_EQUALITY( ranks_host( 0 ), comm_rank );
+    TEST_EQUALITY( query_ids_host( 0 ), 0 );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, connectivity_storage,
+                                   DeviceType )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    unsigned int constexpr dim = 3;
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies_view;
+    Kokkos::View<unsigned int *, DeviceType> cells;
+    Kokkos::View<double **, DeviceType> coordinates;
+    std::vector<unsigned int> n_subdivisions = {{5, 5, 3}};
+    std::tie( cell_topologies_view, cells, coordinates ) =
+        buildStructuredMesh<DeviceType>( comm, n_subdivisions );
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies_view, cells,
+                                            coordinates );
+    Kokkos::View<double * [dim], DeviceType> points_coord =
+        getPointsCoord3D<DeviceType>( comm );
+
+    // Reading the nodes through the connectivity must give the same results
+    // as duplicating their coordinates for each cell
+    DataTransferKit::MeshIndex<DeviceType> block_index(
+        comm, mesh, DataTransferKit::CellStorage::BLOCK );
+    DataTransferKit::MeshIndex<DeviceType> connectivity_index(
+        comm, mesh, DataTransferKit::CellStorage::CONNECTIVITY );
+    auto block_pt_search = block_index.locate( points_coord );
+    auto connectivity_pt_search = connectivity_index.locate( points_coord );
+
+    TEST_EQUALITY( connectivity_pt_search.getNumberOfCandidates(),
+                   block_pt_search.getNumberOfCandidates() );
+    TEST_EQUALITY( connectivity_pt_search.getNumberOfPrunedCandidates(),
+                   block_pt_search.getNumberOfPrunedCandidates() );
+
+    Kokkos::View<int *, DeviceType> ranks;
+    Kokkos::View<int *, DeviceType> cell_indices;
+    Kokkos::View<ArborX::Point *, DeviceType> reference_points;
+    Kokkos::View<unsigned int *, DeviceType> query_ids;
+    std::tie( ranks, cell_indices, reference_points, query_ids ) =
+        connectivity_pt_search.getSearchResults();
+    Kokkos::View<int *, DeviceType> ref_ranks;
+    Kokkos::View<int *, DeviceType> ref_cell_indices;
+    Kokkos::View<ArborX::Point *, DeviceType> ref_reference_points;
+    Kokkos::View<unsigned int *, DeviceType> ref_query_ids;
+    std::tie( ref_ranks, ref_cell_indices, ref_reference_points,
+              ref_query_ids ) = block_pt_search.getSearchResults();
+
+    TEST_EQUALITY( query_ids.extent( 0 ), ref_query_ids.extent( 0 ) );
+    auto cell_indices_host = Kokkos::create_mirror_view( cell_indices );
+    Kokkos::deep_copy( cell_indices_host, cell_indices );
+    auto ref_cell_indices_host = Kokkos::create_mirror_view( ref_cell_indices );
+    Kokkos::deep_copy( ref_cell_indices_host, ref_cell_indices );
+    TEST_COMPARE_ARRAYS( cell_indices_host, ref_cell_indices_host );
+    auto reference_points_host = Kokkos::create_mirror_view( reference_points );
+    Kokkos::deep_copy( reference_points_host, reference_points );
+    auto ref_reference_points_host =
+        Kokkos::create_mirror_view( ref_reference_points );
+    Kokkos::deep_copy( ref_reference_points_host, ref_reference_points );
+    for ( unsigned int i = 0; i < reference_points_host.extent( 0 ); ++i )
+        for ( unsigned int d = 0; d < dim; ++d )
+            TEST_COMPARE( std::abs( reference_points_host( i )[d] -
+                                    ref_reference_points_host( i )[d] ),
+                          <=, 1e-14 );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, structured_mesh, DeviceType )
+{
+    // Same mesh as buildStructuredMesh( comm, {5, 5, 3} ): the blocks are
+    // stacked in the z direction.
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    unsigned int constexpr dim = 3;
+    Kokkos::View<double *, DeviceType> x_edges( "x_edges", 6 );
+    Kokkos::View<double *, DeviceType> y_edges( "y_edges", 6 );
+    Kokkos::View<double *, DeviceType> z_edges( "z_edges", 3 * comm_size + 1 );
+    auto x_edges_host = Kokkos::create_mirror_view( x_edges );
+    for ( unsigned int i = 0; i < 6; ++i )
+        x_edges_host( i ) = i;
+    Kokkos::deep_copy( x_edges, x_edges_host );
+    Kokkos::deep_copy( y_edges, x_edges_host );
+    auto z_edges_host = Kokkos::create_mirror_view( z_edges );
+    for ( int i = 0; i < 3 * comm_size + 1; ++i )
+        z_edges_host( i ) = i;
+    Kokkos::deep_copy( z_edges, z_edges_host );
+    Kokkos::View<int *, DeviceType> x_block_offsets( "x_block_offsets", 2 );
+    Kokkos::View<int *, DeviceType> y_block_offsets( "y_block_offsets", 2 );
+    Kokkos::View<int *, DeviceType> z_block_offsets( "z_block_offsets",
+                                                     comm_size + 1 );
+    auto x_block_offsets_host = Kokkos::create_mirror_view( x_block_offsets );
+    x_block_offsets_host( 0 ) = 0;
+    x_block_offsets_host( 1 ) = 5;
+    Kokkos::deep_copy( x_block_offsets, x_block_offsets_host );
+    Kokkos::deep_copy( y_block_offsets, x_block_offsets_host );
+    auto z_block_offsets_host = Kokkos::create_mirror_view( z_block_offsets );
+    for ( int i = 0; i < comm_size + 1; ++i )
+        z_block_offsets_host( i ) = 3 * i;
+    Kokkos::deep_copy( z_block_offsets, z_block_offsets_host );
+    DataTransferKit::StructuredMesh<DeviceType> structured_mesh(
+        x_edges, y_edges, z_edges, x_block_offsets, y_block_offsets,
+        z_block_offsets );
+    TEST_EQUALITY( structured_mesh.numLocalCells( comm_rank ), 75 );
+
+    // The first point is in the block of the next rank, the second one is
+    // outside of the mesh
+    int const next_rank = ( comm_rank + 1 ) % comm_size;
+    Kokkos::View<double * [dim], DeviceType> points_coord( "points_coord", 2 );
+    auto points_coord_host = Kokkos::create_mirror_view( points_coord );
+    points_coord_host( 0, 0 ) = 1.25;
+    points_coord_host( 0, 1 ) = 2.75;
+    points_coord_host( 0, 2 ) = 3 * next_rank + 0.25;
+    points_coord_host( 1, 0 ) = 6.;
+    points_coord_host( 1, 1 ) = 0.5;
+    points_coord_host( 1, 2 ) = 0.5;
+    Kokkos::deep_copy( points_coord, points_coord_host );
+
+    DataTransferKit::PointSearch<DeviceType> pt_search( comm, structured_mesh,
+                                                        points_coord );
+    Kokkos::View<int *, DeviceType> ranks;
+    Kokkos::View<int *, DeviceType> cell_indices;
+    Kokkos::View<ArborX::Point *, DeviceType> reference_points;
+    Kokkos::View<unsigned int *, DeviceType> query_ids;
+    std::tie( ranks, cell_indices, reference_points, query_ids ) =
+        pt_search.getSearchResults();
+
+    TEST_EQUALITY( query_ids.extent( 0 ), 1 );
+    auto ranks_host = Kokkos::create_mirror_view( ranks );
+    Kokkos::deep_copy( ranks_host, ranks );
+    auto cell_indices_host = Kokkos::create_mirror_view( cell_indices );
+    Kokkos::deep_copy( cell_indices_host, cell_indices );
+    auto reference_points_host = Kokkos::create_mirror_view( reference_points );
+    Kokkos::deep_copy( reference_points_host, reference_points );
+    auto query_ids_host = Kokkos::create_mirror_view( query_ids );
+    Kokkos::deep_copy( query_ids_host, query_ids );
+    TEST_EQUALITY( ranks_host( 0 ), next_rank );
+    TEST_EQUALITY( cell_indices_host( 0 ), 11 );
+    TEST_EQUALITY( query_ids_host( 0 ), 0 );
+
+    // Compare with the search on the unstructured mesh
+    Kokkos::View<DTK_CellTopology *, DeviceType> cell_topologies_view;
+    Kokkos::View<unsigned int *, DeviceType> cells;
+    Kokkos::View<double **, DeviceType> coordinates;
+    std::vector<unsigned int> n_subdivisions = {{5, 5, 3}};
+    std::tie( cell_topologies_view, cells, coordinates ) =
+        buildStructuredMesh<DeviceType>( comm, n_subdivisions );
+    DataTransferKit::Mesh<DeviceType> mesh( cell_topologies_view, cells,
+                                            coordinates );
+    DataTransferKit::PointSearch<DeviceType> ref_pt_search( comm, mesh,
+                                                            points_coord );
+    Kokkos::View<int *, DeviceType> ref_ranks;
+    Kokkos::View<int *, DeviceType> ref_cell_indices;
+    Kokkos::View<ArborX::Point *, DeviceType> ref_reference_points;
+    Kokkos::View<unsigned int *, DeviceType> ref_query_ids;
+    std::tie( ref_ranks, ref_cell_indices, ref_reference_points,
+              ref_query_ids ) = ref_pt_search.getSearchResults();
+    TEST_EQUALITY( ref_query_ids.extent( 0 ), 1 );
+    auto ref_cell_indices_host = Kokkos::create_mirror_view( ref_cell_indices );
+    Kokkos::deep_copy( ref_cell_indices_host, ref_cell_indices );
+    auto ref_reference_points_host =
+        Kokkos::create_mirror_view( ref_reference_points );
+    Kokkos::deep_copy( ref_reference_points_host, ref_reference_points );
+    TEST_EQUALITY( cell_indices_host( 0 ), ref_cell_indices_host( 0 ) );
+    for ( unsigned int d = 0; d < dim; ++d )
+        TEST_COMPARE( std::abs( reference_points_host( 0 )[d] -
+                                ref_reference_points_host( 0 )[d] ),
+                      <=, 1e-14 );
+}
+
 // Include the test macros.
 #include "DataTransferKit_ETIHelperMacros.h"
 
@@ -454,6 +746,14 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( PointSearch, two_topo_two_dim, DeviceType )
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
         PointSearch, one_topo_three_dim_no_point_found, DeviceType##NODE )     \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, two_topo_two_dim,       \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, mesh_index,             \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, prune_candidates,       \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, connectivity_storage,   \
+                                          DeviceType##NODE )                   \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( PointSearch, structured_mesh,        \
                                           DeviceType##NODE )
 
 // Demangle the types
@@ -11,11 +11,15 @@
 
 #include "DTK_C_API.hpp"
 #include "DTK_Core.hpp"
+#include "DTK_Tracing.hpp"
 
 #include "DTK_Version.hpp"
 
 #include <cerrno>
+#include <mutex>
 #include <set>
+#include <string>
+#include <vector>
 
 namespace DataTransferKit
 {
@@ -31,8 +35,10 @@ struct DTK_FunctionWrap
     void *_data;
 };
 
-// We store the reinterpret_cast versions of pointers
+// We store the reinterpret_cast versions of pointers. Accesses to the set
+// are serialized since user applications may be used from several threads.
 static std::set<void *> valid_user_handles;
+static std::mutex valid_user_handles_mutex;
 
 template <typename Function>
 std::pair<Function, void *> get_function( std::shared_ptr<void> user_data )
@@ -255,6 +261,54 @@ void EvaluateFieldFunctionWrapper<double>(
              object_ids.data(), values.data() );
 }
 
+template <class Scalar>
+void PullFieldsDataFunctionWrapper( std::shared_ptr<void>,
+                                    const std::vector<std::string> &,
+                                    std::vector<View<Scalar>> & )
+{
+    throw DataTransferKitException( "Not implemented" );
+}
+template <>
+void PullFieldsDataFunctionWrapper<double>(
+    std::shared_ptr<void> user_data,
+    const std::vector<std::string> &field_names,
+    std::vector<View<double>> &field_dofs )
+{
+    std::vector<const char *> names;
+    std::vector<double *> dofs;
+    for ( size_t i = 0; i < field_names.size(); ++i )
+    {
+        names.push_back( field_names[i].c_str() );
+        dofs.push_back( field_dofs[i].data() );
+    }
+    auto u = get_function<DTK_PullFieldsDataFunction>( user_data );
+    u.first( u.second, field_names.size(), names.data(), dofs.data() );
+}
+
+template <class Scalar>
+void PushFieldsDataFunctionWrapper( std::shared_ptr<void>,
+                                    const std::vector<std::string> &,
+                                    const std::vector<View<Scalar>> & )
+{
+    throw DataTransferKitException( "Not implemented" );
+}
+template <>
+void PushFieldsDataFunctionWrapper<double>(
+    std::shared_ptr<void> user_data,
+    const std::vector<std::string> &field_names,
+    const std::vector<View<double>> &field_dofs )
+{
+    std::vector<const char *> names;
+    std::vector<const double *> dofs;
+    for ( size_t i = 0; i < field_names.size(); ++i )
+    {
+        names.push_back( field_names[i].c_str() );
+        dofs.push_back( field_dofs[i].data() );
+    }
+    auto u = get_function<DTK_PushFieldsDataFunction>( user_data );
+    u.first( u.second, field_names.size(), names.data(), dofs.data() );
+}
+
 } // namespace DataTransferKit
 
 extern "C" {
@@ -284,7 +338,11 @@ DTK_UserApplicationHandle DTK_createUserApplication( DTK_MemorySpace space )
 
     auto handle = reinterpret_cast<DTK_UserApplicationHandle>(
         new DataTransferKit::DTK_Registry( space ) );
-    DataTransferKit::valid_user_handles.insert( handle );
+    {
+        std::lock_guard<std::mutex> lock(
+            DataTransferKit::valid_user_handles_mutex );
+        DataTransferKit::valid_user_handles.insert( handle );
+    }
 
     return handle;
 }
@@ -292,19 +350,26 @@ DTK_UserApplicationHandle DTK_createUserApplication( DTK_MemorySpace space )
 bool DTK_isValidUserApplication( DTK_UserApplicationHandle handle )
 {
     errno = DTK_SUCCESS;
+    std::lock_guard<std::mutex> lock(
+        DataTransferKit::valid_user_handles_mutex );
     return DataTransferKit::valid_user_handles.count( handle );
 }
 
 void DTK_destroyUserApplication( DTK_UserApplicationHandle handle )
 {
     errno = DTK_SUCCESS;
-    if ( DataTransferKit::valid_user_handles.count( handle ) )
+    bool valid_handle;
+    {
+        std::lock_guard<std::mutex> lock(
+            DataTransferKit::valid_user_handles_mutex );
+        // use handle instead of dtk as reinterpret_cast may change pointers
+        valid_handle = DataTransferKit::valid_user_handles.erase( handle ) > 0;
+    }
+    if ( valid_handle )
     {
         auto dtk = reinterpret_cast<DataTransferKit::DTK_Registry *>( handle );
         // nullptr is definitely not a valid handle, so no need to check
         delete dtk;
-        // use handle instead of dtk as reinterpret_cast may change pointers
-        DataTransferKit::valid_user_handles.erase( handle );
     }
 }
 
@@ -326,6 +391,12 @@ bool DTK_isInitialized()
     return DataTransferKit::isInitialized();
 }
 
+void DTK_enableTracing( const char *filename )
+{
+    errno = DTK_SUCCESS;
+    DataTransferKit::enableTracing( filename );
+}
+
 void DTK_finalize()
 {
     errno = DTK_SUCCESS;
@@ -432,6 +503,14 @@ void DTK_setUserFunction( DTK_UserApplicationHandle handle,
         case DTK_EVALUATE_FIELD_FUNCTION:
             dtk->_registry->setEvaluateFieldFunction(
                 EvaluateFieldFunctionWrapper<double>, data );
+            break;
+        case DTK_PULL_FIELDS_DATA_FUNCTION:
+            dtk->_registry->setPullFieldsDataFunction(
+                PullFieldsDataFunctionWrapper<double>, data );
+            break;
+        case DTK_PUSH_FIELDS_DATA_FUNCTION:
+            dtk->_registry->setPushFieldsDataFunction(
+                PushFieldsDataFunctionWrapper<double>, data );
         }
     }
     catch ( ... )
@@ -440,6 +519,130 @@ void DTK_setUserFunction( DTK_UserApplicationHandle handle,
     }
 }
 
+void DTK_registerField( DTK_UserApplicationHandle handle,
+                        const char *field_name, double *field_dofs,
+                        size_t local_num_dofs, unsigned field_dimension,
+                        DTK_FieldLayout layout )
+{
+    errno = DTK_SUCCESS;
+
+    using namespace DataTransferKit;
+
+    if ( !DTK_isValidUserApplication( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    try
+    {
+        auto dtk = reinterpret_cast<DTK_Registry *>( handle );
+
+        switch ( layout )
+        {
+        case DTK_BLOCKED_FIELD_LAYOUT:
+            dtk->_registry->registerField(
+                field_name, field_dofs,
+                Kokkos::LayoutLeft( local_num_dofs, field_dimension ) );
+            break;
+        case DTK_INTERLEAVED_FIELD_LAYOUT:
+            dtk->_registry->registerField(
+                field_name, field_dofs,
+                Kokkos::LayoutRight( local_num_dofs, field_dimension ) );
+            break;
+        default:
+            errno = DTK_UNKNOWN;
+        }
+    }
+    catch ( ... )
+    {
+        errno = DTK_UNKNOWN;
+    }
+}
+
+void DTK_unregisterField( DTK_UserApplicationHandle handle,
+                          const char *field_name )
+{
+    errno = DTK_SUCCESS;
+
+    if ( !DTK_isValidUserApplication( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    auto dtk = reinterpret_cast<DataTransferKit::DTK_Registry *>( handle );
+    dtk->_registry->unregisterField( field_name );
+}
+
+void DTK_notifyFieldChanged( DTK_UserApplicationHandle handle,
+                             const char *field_name )
+{
+    errno = DTK_SUCCESS;
+
+    if ( !DTK_isValidUserApplication( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    auto dtk = reinterpret_cast<DataTransferKit::DTK_Registry *>( handle );
+    dtk->_registry->notifyFieldChanged( field_name );
+}
+
+void DTK_registerNodeList( DTK_UserApplicationHandle handle,
+                           Coordinate *coordinates, size_t local_num_nodes,
+                           unsigned space_dim, DTK_FieldLayout layout )
+{
+    errno = DTK_SUCCESS;
+
+    using namespace DataTransferKit;
+
+    if ( !DTK_isValidUserApplication( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    try
+    {
+        auto dtk = reinterpret_cast<DTK_Registry *>( handle );
+
+        switch ( layout )
+        {
+        case DTK_BLOCKED_FIELD_LAYOUT:
+            dtk->_registry->registerNodeList(
+                coordinates, Kokkos::LayoutLeft( local_num_nodes, space_dim ) );
+            break;
+        case DTK_INTERLEAVED_FIELD_LAYOUT:
+            dtk->_registry->registerNodeList(
+                coordinates,
+                Kokkos::LayoutRight( local_num_nodes, space_dim ) );
+            break;
+        default:
+            errno = DTK_UNKNOWN;
+        }
+    }
+    catch ( ... )
+    {
+        errno = DTK_UNKNOWN;
+    }
+}
+
+void DTK_unregisterNodeList( DTK_UserApplicationHandle handle )
+{
+    errno = DTK_SUCCESS;
+
+    if ( !DTK_isValidUserApplication( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    auto dtk = reinterpret_cast<DataTransferKit::DTK_Registry *>( handle );
+    dtk->_registry->unregisterNodeList();
+}
+
 const char *DTK_error( int err )
 {
     errno = DTK_SUCCESS;
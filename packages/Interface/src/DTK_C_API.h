@@ -82,6 +82,25 @@ extern void DTK_initializeCmd( int *argc, char ***argv );
  */
 extern bool DTK_isInitialized();
 
+/** \brief Record a timeline of the regions of DTK on each rank.
+ *
+ *  The beginning and the duration of the regions of DTK, such as the phases
+ *  of the setup and of the applications of the maps and their exchanges of
+ *  values, are recorded on each rank. DTK_finalize() merges the regions of
+ *  all the ranks into a single Chrome trace file that can be displayed with
+ *  chrome://tracing or Perfetto. When tracing is not enabled, recording a
+ *  region only costs a load of a flag.
+ *
+ *  Setting the environment variable DTK_TRACE_FILE before DTK_initialize()
+ *  has the same effect.
+ *
+ *  \note If tracing is enabled, DTK_finalize() is a collective over
+ *  MPI_COMM_WORLD and must be called before MPI_Finalize().
+ *
+ *  \param[in] filename Name of the trace file written by the rank 0.
+ */
+extern void DTK_enableTracing( const char *filename );
+
 /** \brief Finalize DTK.
  *
  *  This function terminates the DTK execution environment.  If DTK
@@ -292,6 +311,23 @@ typedef struct _DTK_MapHandle *DTK_MapHandle;
  *                        "\"OptionBarDouble\": 1.32 }";
  *  \endcode
  *
+ *  The "Nearest Neighbor" and "Moving Least Squares" maps transfer the first
+ *  component of fields defined at the nodes of the source node list. Their
+ *  "Search Partition" option is "Target" (the default), for the ranks of the
+ *  target to search for the neighbors of their nodes, or "Source", for the
+ *  nodes of the target to be sent for the search to the ranks whose source
+ *  nodes surround them. The latter balances the search when the source and
+ *  the target are partitioned very differently. When its "Maximum Distance"
+ *  option is given, the "Nearest Neighbor" map only looks for source nodes
+ *  within that distance of each target node, and the target nodes without
+ *  any are assigned its "Default Value" option. Without a default value,
+ *  they are left untouched and the target fields that are not registered are
+ *  pulled from the target before applying the map. The
+ *  "Consistent Interpolation" map evaluates all the components of finite
+ *  element fields, defined by the cell list and the degree-of-freedom map of
+ *  the source, at the nodes of the target. Its "FE Type" option is one of
+ *  "HGRAD" (the default), "HDIV", or "HCURL".
+ *
  *  \param[in] space Execution space where the map will execute. Operations on
  *  user data for transfer operations will occur in this execution space. If
  *  the source or target applications reside in memory spaces that are not
@@ -315,20 +351,36 @@ typedef struct _DTK_MapHandle *DTK_MapHandle;
  *  target communicators). In that case, user implementations of callback
  *  functions should just return sizes of zero during calls to allocation
  *  functions to indicate to DTK that there is no data from the user
- *  application on a given MPI rank.
+ *  application on a given MPI rank. The communicator is duplicated so that
+ *  maps created over the same communicator may be applied concurrently from
+ *  different threads, provided MPI was initialized with MPI_THREAD_MULTIPLE
+ *  and the maps do not share user applications. The maps are however created
+ *  one at a time on each rank, and they exchange values one at a time while
+ *  holding a lock of the rank across MPI communications. Maps executing in
+ *  DTK_CUDA only overlap the gathering and the scattering of the values on
+ *  their own stream, and maps executing in DTK_SERIAL or DTK_OPENMP are
+ *  applied one at a time. Maps sharing ranks must therefore be created and
+ *  applied in the same order on all of them, or the ranks deadlock.
+ *
+ *  Alternatively, when the source and target applications live on disjoint
+ *  sets of MPI ranks, an intercommunicator between the source group and the
+ *  target group may be passed. Each rank then only passes the handle of the
+ *  application of its group and NULL for the other one. The search
+ *  structures are only built over the source ranks and the data is sent
+ *  directly from the source ranks to the target ranks.
  *
  *  \param[in] source Handle to the source application. This handle must be
- *  valid on all ranks in the communicator. Function callback implementations
- *  for the source should return zero sizes in allocation functions if the
- *  user's source application does not exist on the calling MPI rank.
+ *  valid on all ranks in the communicator, or NULL on the target ranks of an
+ *  intercommunicator. Function callback implementations for the source
+ *  should return zero sizes in allocation functions if the user's source
+ *  application does not exist on the calling MPI rank.
  *
  *  \param[in,out] target Handle to the target application. Data will be
  *  transferred from the source and pushed to this application. This handle
- *  must be valid on all ranks in the communicator. Data will be pulled from
- *  this application and transferred to the target. Function callback
- *  implementations for the target should return zero sizes in allocation
- *  functions if the user's target application does not exist on the calling
- *  MPI rank.
+ *  must be valid on all ranks in the communicator, or NULL on the source
+ *  ranks of an intercommunicator. Function callback implementations for the
+ *  target should return zero sizes in allocation functions if the user's
+ *  target application does not exist on the calling MPI rank.
  *
  *  \param[in] options Options string for building the map. The contents of
  *  this string specify what type of map to create as well as other parameters
@@ -365,6 +417,8 @@ extern bool DTK_isValidMap( DTK_MapHandle handle );
  *  based on the field name.
  *
  *  \note This function call is a collective over the map's communicator.
+ *  When maps sharing ranks are applied from several threads, they must be
+ *  applied in the same order on all of these ranks (see DTK_createMap()).
  *
  *  \note The source and target user application handles associated with the
  *  given map instance must still be valid - they cannot have been destroyed
@@ -386,6 +440,81 @@ extern bool DTK_isValidMap( DTK_MapHandle handle );
 extern void DTK_applyMap( DTK_MapHandle handle, const char *source_field,
                           const char *target_field );
 
+/** \brief Transfer several fields at once.
+ *
+ *  This function is equivalent to calling DTK_applyMap() for each pair of
+ *  source and target fields but the values of all the fields are exchanged
+ *  together, which reduces the number of messages sent by the map. If the
+ *  source (resp. target) application registered a
+ *  DTK_PullFieldsDataFunction() (resp. DTK_PushFieldsDataFunction()), it is
+ *  called once for all the fields that were not registered with
+ *  DTK_registerField().
+ *
+ *  \note This function call is a collective over the map's communicator.
+ *
+ *  \param[in] handle Map handle. This handle must be valid on all calling MPI
+ *  ranks.
+ *
+ *  \param[in] num_fields Number of fields to transfer.
+ *
+ *  \param[in] source_fields Names of the fields in the source user
+ *  application. The length of this array is num_fields.
+ *
+ *  \param[in] target_fields Names of the fields in the target user
+ *  application. The length of this array is num_fields. The i-th source field
+ *  is transferred to the i-th target field.
+ */
+extern void DTK_applyMapMany( DTK_MapHandle handle, int num_fields,
+                              const char **source_fields,
+                              const char **target_fields );
+
+/** \brief Get the number of buffers allocated by a map to transfer fields.
+ *
+ *  Buffers are allocated the first time a field is transferred and when the
+ *  application signals that the field changed (see DTK_notifyFieldChanged()).
+ *  Transferring the same fields again does not allocate any buffer, which
+ *  this function allows to check.
+ *
+ *  \param[in] handle Map handle.
+ *
+ *  \return The number of buffers allocated by DTK_applyMap() since the map
+ *  was created.
+ */
+extern size_t DTK_getMapNumAllocations( DTK_MapHandle handle );
+
+/** \brief Get the costs of a map on the calling rank as a JSON object.
+ *
+ *  The object holds the wall clock time in seconds spent in each phase of the
+ *  setup and of the applications of the map (\c "phase_times"), the number
+ *  of applications, the number of bytes and messages sent and received to
+ *  exchange the values, the largest amount of temporary memory in bytes held
+ *  at once, the high-water mark of the arena the temporaries of the setup of
+ *  a moving least squares map are taken from, the number of bytes held by
+ *  the map between applications, and the number of underdetermined systems
+ *  of a moving least squares map. For instance:
+ *
+ *  \code
+ *  {"phase_times":{"apply_exchange":0.012,"query":0.31,"tree_build":0.05},
+ *   "num_applications":1,"bytes_sent":1600,"bytes_received":1600,
+ *   "messages_sent":5,"messages_received":5,"peak_temporary_memory":3200,
+ *   "arena_high_water_mark":0,"memory_footprint":1000,
+ *   "underdetermined_systems":0}
+ *  \endcode
+ *
+ *  \param[in] handle Map handle.
+ *
+ *  \param[out] json_buffer Buffer the null-terminated JSON string is written
+ *  to. It is truncated to fit in the buffer. May be NULL to only query the
+ *  size of the string.
+ *
+ *  \param[in] buffer_size Size of the buffer in bytes.
+ *
+ *  \return The size of the buffer needed to hold the whole string,
+ *  including the terminating null character.
+ */
+extern size_t DTK_getMapStatistics( DTK_MapHandle handle, char *json_buffer,
+                                    size_t buffer_size );
+
 /** \brief Destroy a DTK handle to a map.
  *
  *  \param[in,out] handle map handle. If this handle has already been
@@ -436,6 +565,8 @@ typedef enum {
     DTK_PULL_FIELD_DATA_FUNCTION /** See DTK_PullFieldDataFunction() */,
     DTK_PUSH_FIELD_DATA_FUNCTION /** See DTK_PushFieldDataFunction() */,
     DTK_EVALUATE_FIELD_FUNCTION /** See DTK_EvaluateFieldFunction() */,
+    DTK_PULL_FIELDS_DATA_FUNCTION /** See DTK_PullFieldsDataFunction() */,
+    DTK_PUSH_FIELDS_DATA_FUNCTION /** See DTK_PushFieldsDataFunction() */,
 } DTK_FunctionType;
 // clang-format on
 
@@ -476,6 +607,121 @@ extern void DTK_setUserFunction( DTK_UserApplicationHandle handle,
                                  DTK_FunctionType type, void ( *f )(),
                                  void *user_data );
 
+/** \brief Layout of the degrees of freedom of a field registered with
+ *  DTK_registerField().
+ *
+ *  DTK_BLOCKED_FIELD_LAYOUT: Values are blocked by field dimension as for the
+ *  field data function callbacks. The value of component \f$d\f$ of the
+ *  degree of freedom \f$n\f$ is at <code>d*local_num_dofs + n</code>.
+ *
+ *  DTK_INTERLEAVED_FIELD_LAYOUT: The components of each degree of freedom are
+ *  contiguous. The value of component \f$d\f$ of the degree of freedom
+ *  \f$n\f$ is at <code>n*field_dimension + d</code>.
+ */
+typedef enum {
+    DTK_BLOCKED_FIELD_LAYOUT,
+    DTK_INTERLEAVED_FIELD_LAYOUT
+} DTK_FieldLayout;
+
+/** \brief Lend the memory of a field to DTK.
+ *
+ *  When a map is applied to a registered field, DTK reads and writes the
+ *  degrees of freedom directly in the given array instead of allocating a
+ *  field and calling DTK_FieldSizeFunction(), DTK_PullFieldDataFunction(),
+ *  and DTK_PushFieldDataFunction(). This avoids copying the field data at
+ *  every transfer.
+ *
+ *  \note The array must be allocated in the memory space of the user
+ *  application and must remain valid, with the same size, until the field is
+ *  unregistered with DTK_unregisterField() or the user application is
+ *  destroyed. Registering a field again with the same name replaces the
+ *  previous registration.
+ *
+ *  \param[in,out] handle User application handle.
+ *
+ *  \param[in] field_name Name of the field.
+ *
+ *  \param[in] field_dofs Degrees-of-freedom of the field. The length of this
+ *  array is local_num_dofs * field_dimension.
+ *
+ *  \param[in] local_num_dofs Number of degrees of freedom on this process.
+ *
+ *  \param[in] field_dimension Dimension of the field.
+ *
+ *  \param[in] layout Layout of the degrees of freedom in \p field_dofs.
+ */
+extern void DTK_registerField( DTK_UserApplicationHandle handle,
+                               const char *field_name, double *field_dofs,
+                               size_t local_num_dofs, unsigned field_dimension,
+                               DTK_FieldLayout layout );
+
+/** \brief Stop lending the memory of a field to DTK.
+ *
+ *  Subsequent transfers of the field go through the field data function
+ *  callbacks again.
+ *
+ *  \param[in,out] handle User application handle.
+ *
+ *  \param[in] field_name Name of the field.
+ */
+extern void DTK_unregisterField( DTK_UserApplicationHandle handle,
+                                 const char *field_name );
+
+/** \brief Signal that the size of a field changed.
+ *
+ *  Maps set up their buffers for a field the first time it is transferred
+ *  and reuse them afterwards without calling DTK_FieldSizeFunction()
+ *  again. This function must be called whenever the dimension or the number
+ *  of degrees of freedom of a field changes so that the buffers are set up
+ *  again at the next transfer. Registering or unregistering a field with
+ *  DTK_registerField() or DTK_unregisterField() signals the change
+ *  automatically.
+ *
+ *  \param[in,out] handle User application handle.
+ *
+ *  \param[in] field_name Name of the field.
+ */
+extern void DTK_notifyFieldChanged( DTK_UserApplicationHandle handle,
+                                    const char *field_name );
+
+/** \brief Lend the memory of the coordinates of the nodes to DTK.
+ *
+ *  Maps created with this user application read the coordinates directly in
+ *  the given array instead of calling DTK_NodeListSizeFunction() and
+ *  DTK_NodeListDataFunction(). The coordinates reach the search without
+ *  being copied or transposed when the map runs in the memory space of the
+ *  user application.
+ *
+ *  \note The array must be allocated in the memory space of the user
+ *  application and must remain valid until the node list is unregistered
+ *  with DTK_unregisterNodeList() or the user application is destroyed. Maps
+ *  only read the coordinates when they are created.
+ *
+ *  \param[in,out] handle User application handle.
+ *
+ *  \param[in] coordinates Coordinates of the nodes. The length of this array
+ *  is local_num_nodes * space_dim.
+ *
+ *  \param[in] local_num_nodes Number of nodes on this process.
+ *
+ *  \param[in] space_dim Spatial dimension.
+ *
+ *  \param[in] layout Layout of the coordinates. DTK_BLOCKED_FIELD_LAYOUT
+ *  blocks them by dimension as for DTK_NodeListDataFunction() and
+ *  DTK_INTERLEAVED_FIELD_LAYOUT stores the coordinates of each node
+ *  contiguously.
+ */
+extern void DTK_registerNodeList( DTK_UserApplicationHandle handle,
+                                  Coordinate *coordinates,
+                                  size_t local_num_nodes, unsigned space_dim,
+                                  DTK_FieldLayout layout );
+
+/** \brief Stop lending the memory of the coordinates of the nodes to DTK.
+ *
+ *  \param[in,out] handle User application handle.
+ */
+extern void DTK_unregisterNodeList( DTK_UserApplicationHandle handle );
+
 /**@}*/
 
 /**
@@ -1101,6 +1347,56 @@ typedef void ( *DTK_EvaluateFieldFunction )(
     const Coordinate *evaluation_points, const LocalOrdinal *object_ids,
     double *values );
 
+/** \brief Prototype function to pull data from application into several
+ *         fields at once.
+ *
+ *  This function is optional. When it is registered, DTK_applyMapMany() calls
+ *  it once instead of calling DTK_PullFieldDataFunction() for each field.
+ *
+ *  \note Register with a user application using DTK_setUserFunction() by
+ *  passing DTK_PULL_FIELDS_DATA_FUNCTION as the \p type argument.
+ *
+ *  \param[in] user_data Custom user data.
+ *
+ *  \param[in] num_fields Number of fields to pull.
+ *
+ *  \param[in] field_names Names of the fields to pull. The length of this
+ *  array is num_fields.
+ *
+ *  \param[out] field_dofs Degrees-of-freedom for each field. The length of
+ *  this array is num_fields. Each array is laid out as the \p field_dofs
+ *  argument of DTK_PullFieldDataFunction().
+ */
+typedef void ( *DTK_PullFieldsDataFunction )( void *user_data,
+                                              int num_fields,
+                                              const char **field_names,
+                                              double **field_dofs );
+
+/** \brief Prototype function to push data from several fields at once into
+ *         the application.
+ *
+ *  This function is optional. When it is registered, DTK_applyMapMany() calls
+ *  it once instead of calling DTK_PushFieldDataFunction() for each field.
+ *
+ *  \note Register with a user application using DTK_setUserFunction() by
+ *  passing DTK_PUSH_FIELDS_DATA_FUNCTION as the \p type argument.
+ *
+ *  \param[in] user_data Custom user data.
+ *
+ *  \param[in] num_fields Number of fields to push.
+ *
+ *  \param[in] field_names Names of the fields to push. The length of this
+ *  array is num_fields.
+ *
+ *  \param[in] field_dofs Degrees-of-freedom for each field. The length of
+ *  this array is num_fields. Each array is laid out as the \p field_dofs
+ *  argument of DTK_PushFieldDataFunction().
+ */
+typedef void ( *DTK_PushFieldsDataFunction )( void *user_data,
+                                              int num_fields,
+                                              const char **field_names,
+                                              const double **field_dofs );
+
 /**@}*/
 
 /**@}*/
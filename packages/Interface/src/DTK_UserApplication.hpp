@@ -61,6 +61,10 @@ class UserApplication
     //! @name Type Aliases
     //@{
     using MemorySpace = typename ParallelModel::memory_space;
+    using RegisteredField = Field<Scalar, Kokkos::LayoutStride, MemorySpace,
+                                  Kokkos::MemoryUnmanaged>;
+    using RegisteredNodeList =
+        NodeList<Kokkos::LayoutStride, MemorySpace, Kokkos::MemoryUnmanaged>;
     //@}
 
     //! Constructor.
@@ -70,6 +74,15 @@ class UserApplication
     //! Get a node list from the application.
     NodeList<Kokkos::LayoutLeft, MemorySpace> getNodeList();
 
+    //! Check whether the application lent the memory of the coordinates of
+    //! its nodes.
+    bool hasRegisteredNodeList() const;
+
+    //! Get the node list whose memory was lent by the application. The list
+    //! wraps the application memory, whatever its layout, and no data is
+    //! copied.
+    RegisteredNodeList getRegisteredNodeList();
+
     //! Get a bounding volume list from the application.
     BoundingVolumeList<Kokkos::LayoutLeft, MemorySpace> getBoundingVolumeList();
 
@@ -104,12 +117,40 @@ class UserApplication
     pushField( const std::string &field_name,
                const Field<Scalar, Kokkos::LayoutLeft, MemorySpace> field );
 
+    //! Pull several fields with the given names to the application. The
+    //! application is called once if it provides a function pulling several
+    //! fields at once, once per field otherwise.
+    void pullFields(
+        const std::vector<std::string> &field_names,
+        const std::vector<Field<Scalar, Kokkos::LayoutLeft, MemorySpace>>
+            &fields );
+
+    //! Push several fields with the given names to the application.
+    void pushFields(
+        const std::vector<std::string> &field_names,
+        const std::vector<Field<Scalar, Kokkos::LayoutLeft, MemorySpace>>
+            &fields );
+
     //! Ask the application to evaluate a field with a given name.
     void evaluateField(
         const std::string &field_name,
         const EvaluationSet<Kokkos::LayoutLeft, MemorySpace> eval_set,
         Field<Scalar, Kokkos::LayoutLeft, MemorySpace> field );
 
+    //! Check whether the application lent the memory of a field with a given
+    //! name.
+    bool hasRegisteredField( const std::string &field_name ) const;
+
+    //! Get a field with a given name whose memory was lent by the
+    //! application. The field wraps the application memory and no data is
+    //! copied.
+    RegisteredField getRegisteredField( const std::string &field_name );
+
+    //! Get the version of a field with a given name. The version changes
+    //! every time the application signals that the field changed so that
+    //! buffers set up for the field can be reused until then.
+    std::size_t fieldVersion( const std::string &field_name ) const;
+
   private:
     // User function registry for this application.
     std::shared_ptr<UserFunctionRegistry<Scalar>> _user_functions;
@@ -55,6 +55,31 @@ auto UserApplication<Scalar, ParallelModel>::getNodeList()
     return node_list;
 }
 
+//---------------------------------------------------------------------------//
+// Check whether the application lent the memory of its nodes.
+template <class Scalar, class ParallelModel>
+bool UserApplication<Scalar, ParallelModel>::hasRegisteredNodeList() const
+{
+    return static_cast<bool>( _user_functions->_registered_node_list );
+}
+
+//---------------------------------------------------------------------------//
+// Get the node list whose memory was lent by the application.
+template <class Scalar, class ParallelModel>
+auto UserApplication<Scalar, ParallelModel>::getRegisteredNodeList()
+    -> RegisteredNodeList
+{
+    DTK_INSIST( hasRegisteredNodeList() );
+
+    // Wrap the application memory.
+    auto const &registered_node_list = *_user_functions->_registered_node_list;
+    RegisteredNodeList node_list;
+    node_list.coordinates = decltype( node_list.coordinates )(
+        registered_node_list.first, registered_node_list.second );
+
+    return node_list;
+}
+
 //---------------------------------------------------------------------------//
 // Get a bounding volume list from the application.
 template <class Scalar, class ParallelModel>
@@ -298,6 +323,58 @@ void UserApplication<Scalar, ParallelModel>::pushField(
                       field_dofs );
 }
 
+//---------------------------------------------------------------------------//
+// Pull several fields with the given names to the application.
+template <class Scalar, class ParallelModel>
+void UserApplication<Scalar, ParallelModel>::pullFields(
+    const std::vector<std::string> &field_names,
+    const std::vector<Field<Scalar, Kokkos::LayoutLeft, MemorySpace>> &fields )
+{
+    DTK_REQUIRE( field_names.size() == fields.size() );
+
+    // Fall back to pulling the fields one at a time.
+    if ( !_user_functions->_pull_fields_func.first )
+    {
+        for ( size_t i = 0; i < fields.size(); ++i )
+            pullField( field_names[i], fields[i] );
+        return;
+    }
+
+    // Get the fields from the user.
+    std::vector<View<Scalar>> field_dofs;
+    field_dofs.reserve( fields.size() );
+    for ( auto const &field : fields )
+        field_dofs.emplace_back( field.dofs );
+    callUserFunction( _user_functions->_pull_fields_func, field_names,
+                      field_dofs );
+}
+
+//---------------------------------------------------------------------------//
+// Push several fields with the given names to the application.
+template <class Scalar, class ParallelModel>
+void UserApplication<Scalar, ParallelModel>::pushFields(
+    const std::vector<std::string> &field_names,
+    const std::vector<Field<Scalar, Kokkos::LayoutLeft, MemorySpace>> &fields )
+{
+    DTK_REQUIRE( field_names.size() == fields.size() );
+
+    // Fall back to pushing the fields one at a time.
+    if ( !_user_functions->_push_fields_func.first )
+    {
+        for ( size_t i = 0; i < fields.size(); ++i )
+            pushField( field_names[i], fields[i] );
+        return;
+    }
+
+    // Give the fields to the user.
+    std::vector<View<Scalar>> field_dofs;
+    field_dofs.reserve( fields.size() );
+    for ( auto const &field : fields )
+        field_dofs.emplace_back( field.dofs );
+    callUserFunction( _user_functions->_push_fields_func, field_names,
+                      field_dofs );
+}
+
 //---------------------------------------------------------------------------//
 // Ask the application to evaluate a field with a given name.
 template <class Scalar, class ParallelModel>
@@ -314,6 +391,45 @@ void UserApplication<Scalar, ParallelModel>::evaluateField(
                       evaluation_points, object_ids, values );
 }
 
+//---------------------------------------------------------------------------//
+// Check whether the application lent the memory of a field.
+template <class Scalar, class ParallelModel>
+bool UserApplication<Scalar, ParallelModel>::hasRegisteredField(
+    const std::string &field_name ) const
+{
+    return _user_functions->_registered_fields.count( field_name ) > 0;
+}
+
+//---------------------------------------------------------------------------//
+// Get a field whose memory was lent by the application.
+template <class Scalar, class ParallelModel>
+auto UserApplication<Scalar, ParallelModel>::getRegisteredField(
+    const std::string &field_name ) -> RegisteredField
+{
+    auto registered_field =
+        _user_functions->_registered_fields.find( field_name );
+    DTK_INSIST( registered_field != _user_functions->_registered_fields.end() );
+
+    // Wrap the application memory.
+    RegisteredField field;
+    field.dofs = decltype( field.dofs )( registered_field->second.first,
+                                         registered_field->second.second );
+
+    return field;
+}
+
+//---------------------------------------------------------------------------//
+// Get the version of a field.
+template <class Scalar, class ParallelModel>
+std::size_t UserApplication<Scalar, ParallelModel>::fieldVersion(
+    const std::string &field_name ) const
+{
+    auto version = _user_functions->_field_versions.find( field_name );
+    return ( version != _user_functions->_field_versions.end() )
+               ? version->second
+               : 0;
+}
+
 //---------------------------------------------------------------------------//
 
 } // namespace DataTransferKit
@@ -225,6 +225,26 @@ using PushFieldDataFunction =
                         const std::string &field_name,
                         const View<Scalar> field_dofs )>;
 
+//---------------------------------------------------------------------------//
+/*!
+ * \brief Pull data from application into several fields at once.
+ */
+template <class Scalar>
+using PullFieldsDataFunction =
+    std::function<void( std::shared_ptr<void> user_data,
+                        const std::vector<std::string> &field_names,
+                        std::vector<View<Scalar>> &field_dofs )>;
+
+//---------------------------------------------------------------------------//
+/*
+ * \brief Push data from several fields at once into the application.
+ */
+template <class Scalar>
+using PushFieldsDataFunction =
+    std::function<void( std::shared_ptr<void> user_data,
+                        const std::vector<std::string> &field_names,
+                        const std::vector<View<Scalar>> &field_dofs )>;
+
 //---------------------------------------------------------------------------//
 /*
  * \brief Evaluate a field at a given set of points in a given set of objects.
@@ -21,6 +21,8 @@
 #include "DTK_UserDataInterface.hpp"
 #include "DTK_View.hpp"
 
+#include <Kokkos_Core.hpp>
+
 #include <functional>
 #include <memory>
 #include <string>
@@ -164,11 +166,72 @@ class UserFunctionRegistry
     void setPushFieldDataFunction( PushFieldDataFunction<Scalar> &&func,
                                    std::shared_ptr<void> user_data = nullptr );
 
+    //! Pull several fields at once.
+    void setPullFieldsDataFunction( PullFieldsDataFunction<Scalar> &&func,
+                                    std::shared_ptr<void> user_data = nullptr );
+
+    //! Push several fields at once.
+    void setPushFieldsDataFunction( PushFieldsDataFunction<Scalar> &&func,
+                                    std::shared_ptr<void> user_data = nullptr );
+
     //! Evaluate field.
     void setEvaluateFieldFunction( EvaluateFieldFunction<Scalar> &&func,
                                    std::shared_ptr<void> user_data = nullptr );
     //@}
 
+    //! @name Register Field Memory
+    //@{
+
+    //! Lend the memory of a field to DTK. The degrees of freedom are
+    //! dimensioned (local number of dofs, field dimension) as described by
+    //! the layout. They are read and written in place instead of going
+    //! through the field size, pull, and push functions. The memory must live
+    //! in the memory space of the user application and remain valid until
+    //! the field is unregistered.
+    void registerField( const std::string &field_name, Scalar *field_dofs,
+                        const Kokkos::LayoutLeft &layout );
+
+    //! Lend the memory of a field with interleaved components to DTK.
+    void registerField( const std::string &field_name, Scalar *field_dofs,
+                        const Kokkos::LayoutRight &layout );
+
+    //! Lend the memory of a strided field to DTK.
+    void registerField( const std::string &field_name, Scalar *field_dofs,
+                        const Kokkos::LayoutStride &layout );
+
+    //! Stop lending the memory of a field to DTK.
+    void unregisterField( const std::string &field_name );
+
+    //! Signal that the size of a field changed. DTK caches the buffers of
+    //! the fields it transfers and only queries their size again after this
+    //! call. Registering or unregistering a field also signals a change.
+    void notifyFieldChanged( const std::string &field_name );
+    //@}
+
+    //! @name Register Node Memory
+    //@{
+
+    //! Lend the memory of the coordinates of the nodes to DTK. The
+    //! coordinates are dimensioned (local number of nodes, spatial dimension)
+    //! as described by the layout. They are read in place instead of going
+    //! through the node list size and data functions. The memory must live in
+    //! the memory space of the user application and remain valid until the
+    //! node list is unregistered.
+    void registerNodeList( Coordinate *coordinates,
+                           const Kokkos::LayoutLeft &layout );
+
+    //! Lend the memory of interleaved coordinates to DTK.
+    void registerNodeList( Coordinate *coordinates,
+                           const Kokkos::LayoutRight &layout );
+
+    //! Lend the memory of strided coordinates to DTK.
+    void registerNodeList( Coordinate *coordinates,
+                           const Kokkos::LayoutStride &layout );
+
+    //! Stop lending the memory of the coordinates of the nodes to DTK.
+    void unregisterNodeList();
+    //@}
+
   private:
     //@{
     //! User Geometry functions.
@@ -238,9 +301,26 @@ class UserFunctionRegistry
     //! Field push data function.
     UserImpl<PushFieldDataFunction<Scalar>> _push_field_func;
 
+    //! Multiple fields pull data function.
+    UserImpl<PullFieldsDataFunction<Scalar>> _pull_fields_func;
+
+    //! Multiple fields push data function.
+    UserImpl<PushFieldsDataFunction<Scalar>> _push_fields_func;
+
     //! Field evaluate data function.
     UserImpl<EvaluateFieldFunction<Scalar>> _eval_field_func;
     //@}
+
+    //! Fields whose memory is lent by the application.
+    std::unordered_map<std::string, std::pair<Scalar *, Kokkos::LayoutStride>>
+        _registered_fields;
+
+    //! Number of changes signaled for each field.
+    std::unordered_map<std::string, std::size_t> _field_versions;
+
+    //! Coordinates of the nodes lent by the application, if any.
+    std::unique_ptr<std::pair<Coordinate *, Kokkos::LayoutStride>>
+        _registered_node_list;
 };
 
 //---------------------------------------------------------------------------//
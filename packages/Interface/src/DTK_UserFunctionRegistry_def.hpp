@@ -190,6 +190,24 @@ void UserFunctionRegistry<Scalar>::setPushFieldDataFunction(
     _push_field_func = std::make_pair( func, user_data );
 }
 
+//---------------------------------------------------------------------------//
+// Pull several fields at once.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::setPullFieldsDataFunction(
+    PullFieldsDataFunction<Scalar> &&func, std::shared_ptr<void> user_data )
+{
+    _pull_fields_func = std::make_pair( func, user_data );
+}
+
+//---------------------------------------------------------------------------//
+// Push several fields at once.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::setPushFieldsDataFunction(
+    PushFieldsDataFunction<Scalar> &&func, std::shared_ptr<void> user_data )
+{
+    _push_fields_func = std::make_pair( func, user_data );
+}
+
 //---------------------------------------------------------------------------//
 // Evaluate field.
 template <class Scalar>
@@ -199,6 +217,107 @@ void UserFunctionRegistry<Scalar>::setEvaluateFieldFunction(
     _eval_field_func = std::make_pair( func, user_data );
 }
 
+//---------------------------------------------------------------------------//
+// Register the memory of a field blocked by field dimension.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::registerField(
+    const std::string &field_name, Scalar *field_dofs,
+    const Kokkos::LayoutLeft &layout )
+{
+    registerField( field_name, field_dofs,
+                   Kokkos::LayoutStride( layout.dimension[0], 1,
+                                         layout.dimension[1],
+                                         layout.dimension[0] ) );
+}
+
+//---------------------------------------------------------------------------//
+// Register the memory of a field with interleaved components.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::registerField(
+    const std::string &field_name, Scalar *field_dofs,
+    const Kokkos::LayoutRight &layout )
+{
+    registerField( field_name, field_dofs,
+                   Kokkos::LayoutStride( layout.dimension[0],
+                                         layout.dimension[1],
+                                         layout.dimension[1], 1 ) );
+}
+
+//---------------------------------------------------------------------------//
+// Register the memory of a strided field.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::registerField(
+    const std::string &field_name, Scalar *field_dofs,
+    const Kokkos::LayoutStride &layout )
+{
+    DTK_REQUIRE( field_dofs != nullptr || layout.dimension[0] == 0 );
+    _registered_fields[field_name] = std::make_pair( field_dofs, layout );
+    notifyFieldChanged( field_name );
+}
+
+//---------------------------------------------------------------------------//
+// Unregister the memory of a field.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::unregisterField(
+    const std::string &field_name )
+{
+    _registered_fields.erase( field_name );
+    notifyFieldChanged( field_name );
+}
+
+//---------------------------------------------------------------------------//
+// Signal that the size of a field changed.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::notifyFieldChanged(
+    const std::string &field_name )
+{
+    ++_field_versions[field_name];
+}
+
+//---------------------------------------------------------------------------//
+// Register the memory of the coordinates of the nodes blocked by dimension.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::registerNodeList(
+    Coordinate *coordinates, const Kokkos::LayoutLeft &layout )
+{
+    registerNodeList( coordinates,
+                      Kokkos::LayoutStride( layout.dimension[0], 1,
+                                            layout.dimension[1],
+                                            layout.dimension[0] ) );
+}
+
+//---------------------------------------------------------------------------//
+// Register the memory of interleaved coordinates.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::registerNodeList(
+    Coordinate *coordinates, const Kokkos::LayoutRight &layout )
+{
+    registerNodeList( coordinates,
+                      Kokkos::LayoutStride( layout.dimension[0],
+                                            layout.dimension[1],
+                                            layout.dimension[1], 1 ) );
+}
+
+//---------------------------------------------------------------------------//
+// Register the memory of strided coordinates.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::registerNodeList(
+    Coordinate *coordinates, const Kokkos::LayoutStride &layout )
+{
+    DTK_REQUIRE( coordinates != nullptr || layout.dimension[0] == 0 );
+    _registered_node_list.reset(
+        new std::pair<Coordinate *, Kokkos::LayoutStride>( coordinates,
+                                                           layout ) );
+}
+
+//---------------------------------------------------------------------------//
+// Unregister the memory of the coordinates of the nodes.
+template <class Scalar>
+void UserFunctionRegistry<Scalar>::unregisterNodeList()
+{
+    _registered_node_list.reset();
+}
+
 //---------------------------------------------------------------------------//
 
 } // namespace DataTransferKit
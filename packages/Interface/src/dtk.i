@@ -23,6 +23,7 @@
 
 %rename DTK_initializeCmd DTK_initialize_cmd;
 %rename DTK_isInitialized DTK_is_initialized;
+%rename DTK_enableTracing DTK_enable_tracing;
 
 %rename DTK_isValidUserApplication DTK_is_valid_user_application;
 %rename DTK_createUserApplication DTK_create_user_application;
@@ -31,9 +32,17 @@
 %rename DTK_createMap DTK_create_map;
 %rename DTK_isValidMap DTK_is_valid_map;
 %rename DTK_applyMap DTK_apply_map;
+%rename DTK_applyMapMany DTK_apply_map_many;
 %rename DTK_destroyMap DTK_destroy_map;
+%rename DTK_getMapNumAllocations DTK_get_map_num_allocations;
+%rename DTK_getMapStatistics DTK_get_map_statistics;
 
 %rename DTK_setUserFunction DTK_set_user_function;
+%rename DTK_registerField DTK_register_field;
+%rename DTK_unregisterField DTK_unregister_field;
+%rename DTK_notifyFieldChanged DTK_notify_field_changed;
+%rename DTK_registerNodeList DTK_register_node_list;
+%rename DTK_unregisterNodeList DTK_unregister_node_list;
 
 %include <std_string.i>
 
@@ -786,6 +786,129 @@ TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, field_push_pull, SC,
     test_field_push_pull( user_app, out, success );
 }
 
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, field_registration, SC,
+                                   DeviceType )
+{
+    // Test types.
+    using ExecutionSpace = typename DeviceType::execution_space;
+    using MemorySpace = typename ExecutionSpace::memory_space;
+    using Scalar = SC;
+
+    // Create the application fields, one with blocked and one with
+    // interleaved components.
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, MemorySpace> blocked(
+        "blocked", SIZE_1, SPACE_DIM );
+    Kokkos::View<Scalar **, Kokkos::LayoutRight, MemorySpace> interleaved(
+        "interleaved", SIZE_1, SPACE_DIM );
+
+    // Lend the memory to DTK.
+    auto registry =
+        std::make_shared<DataTransferKit::UserFunctionRegistry<Scalar>>();
+    registry->registerField( "blocked", blocked.data(),
+                             Kokkos::LayoutLeft( SIZE_1, SPACE_DIM ) );
+    registry->registerField( "interleaved", interleaved.data(),
+                             Kokkos::LayoutRight( SIZE_1, SPACE_DIM ) );
+
+    // Create the user application.
+    DataTransferKit::UserApplication<Scalar, ExecutionSpace> user_app(
+        registry );
+    TEST_ASSERT( user_app.hasRegisteredField( "blocked" ) );
+    TEST_ASSERT( user_app.hasRegisteredField( "interleaved" ) );
+    TEST_ASSERT( !user_app.hasRegisteredField( FIELD_NAME ) );
+
+    // The registered fields wrap the application memory.
+    auto blocked_field = user_app.getRegisteredField( "blocked" );
+    auto interleaved_field = user_app.getRegisteredField( "interleaved" );
+    TEST_EQUALITY( blocked_field.dofs.data(), blocked.data() );
+    TEST_EQUALITY( interleaved_field.dofs.data(), interleaved.data() );
+    TEST_EQUALITY( blocked_field.dofs.extent( 0 ), SIZE_1 );
+    TEST_EQUALITY( blocked_field.dofs.extent( 1 ), SPACE_DIM );
+    TEST_EQUALITY( interleaved_field.dofs.extent( 0 ), SIZE_1 );
+    TEST_EQUALITY( interleaved_field.dofs.extent( 1 ), SPACE_DIM );
+
+    // Write through the registered fields and check that the application
+    // sees the values at the right place.
+    auto blocked_dofs = blocked_field.dofs;
+    auto interleaved_dofs = interleaved_field.dofs;
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<ExecutionSpace>( 0, SIZE_1 ),
+        KOKKOS_LAMBDA( int const n ) {
+            for ( int d = 0; d < SPACE_DIM; ++d )
+            {
+                blocked_dofs( n, d ) = n + d + OFFSET;
+                interleaved_dofs( n, d ) = n - d + OFFSET;
+            }
+        } );
+    Kokkos::fence();
+    auto blocked_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), blocked );
+    auto interleaved_host = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), interleaved );
+    for ( int n = 0; n < SIZE_1; ++n )
+        for ( int d = 0; d < SPACE_DIM; ++d )
+        {
+            TEST_EQUALITY( blocked_host.data()[d * SIZE_1 + n],
+                           Scalar( n + d + OFFSET ) );
+            TEST_EQUALITY( interleaved_host.data()[n * SPACE_DIM + d],
+                           Scalar( n - d + OFFSET ) );
+        }
+
+    // Unregister a field.
+    registry->unregisterField( "blocked" );
+    TEST_ASSERT( !user_app.hasRegisteredField( "blocked" ) );
+    TEST_ASSERT( user_app.hasRegisteredField( "interleaved" ) );
+}
+
+//---------------------------------------------------------------------------//
+TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, node_list_registration,
+                                   SC, DeviceType )
+{
+    // Test types.
+    using ExecutionSpace = typename DeviceType::execution_space;
+    using MemorySpace = typename ExecutionSpace::memory_space;
+    using Scalar = SC;
+
+    // Create interleaved coordinates.
+    Kokkos::View<Coordinate **, Kokkos::LayoutRight, MemorySpace> coordinates(
+        "coordinates", SIZE_1, SPACE_DIM );
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<ExecutionSpace>( 0, SIZE_1 ),
+        KOKKOS_LAMBDA( int const n ) {
+            for ( int d = 0; d < SPACE_DIM; ++d )
+                coordinates( n, d ) = n + d + OFFSET;
+        } );
+    Kokkos::fence();
+
+    // Lend the memory to DTK.
+    auto registry =
+        std::make_shared<DataTransferKit::UserFunctionRegistry<Scalar>>();
+    DataTransferKit::UserApplication<Scalar, ExecutionSpace> user_app(
+        registry );
+    TEST_ASSERT( !user_app.hasRegisteredNodeList() );
+    registry->registerNodeList( coordinates.data(),
+                                Kokkos::LayoutRight( SIZE_1, SPACE_DIM ) );
+    TEST_ASSERT( user_app.hasRegisteredNodeList() );
+
+    // The registered node list wraps the application memory with its
+    // layout.
+    auto node_list = user_app.getRegisteredNodeList();
+    TEST_EQUALITY( node_list.coordinates.data(), coordinates.data() );
+    TEST_EQUALITY( node_list.coordinates.extent( 0 ), SIZE_1 );
+    TEST_EQUALITY( node_list.coordinates.extent( 1 ), SPACE_DIM );
+    TEST_EQUALITY( node_list.coordinates.stride( 0 ), SPACE_DIM );
+    TEST_EQUALITY( node_list.coordinates.stride( 1 ), 1 );
+    auto node_list_host = Kokkos::create_mirror_view( node_list.coordinates );
+    Kokkos::deep_copy( node_list_host, node_list.coordinates );
+    for ( int n = 0; n < SIZE_1; ++n )
+        for ( int d = 0; d < SPACE_DIM; ++d )
+            TEST_EQUALITY( node_list_host( n, d ), n + d + OFFSET );
+
+    // Unregister the node list.
+    registry->unregisterNodeList();
+    TEST_ASSERT( !user_app.hasRegisteredNodeList() );
+}
+
 //---------------------------------------------------------------------------//
 TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, field_eval, SC, DeviceType )
 {
@@ -898,6 +1021,10 @@ TEUCHOS_UNIT_TEST_TEMPLATE_2_DECL( UserApplication, too_many_functions, SC,
         UserApplication, multiple_topology_dof, SCALAR, DeviceType##NODE )     \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, field_push_pull,    \
                                           SCALAR, DeviceType##NODE )           \
+    TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT(                                      \
+        UserApplication, field_registration, SCALAR, DeviceType##NODE )        \
+    TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT(                                      \
+        UserApplication, node_list_registration, SCALAR, DeviceType##NODE )    \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, field_eval, SCALAR, \
                                           DeviceType##NODE )                   \
     TEUCHOS_UNIT_TEST_TEMPLATE_2_INSTANT( UserApplication, missing_function,   \
@@ -12,15 +12,21 @@
 #include <DTK_C_API.h>
 #include <DTK_C_API_Map.hpp>
 
+#include <algorithm>
 #include <cerrno>
+#include <mutex>
 #include <set>
+#include <sstream>
 
 //---------------------------------------------------------------------------//
 namespace DataTransferKit
 {
 
-// We store the reinterpret_cast versions of pointers
+// We store the reinterpret_cast versions of pointers. Maps may be created,
+// applied, and destroyed from several threads so accesses to the set are
+// serialized.
 static std::set<void *> valid_map_handles;
+static std::mutex valid_map_handles_mutex;
 
 //---------------------------------------------------------------------------//
 
@@ -45,7 +51,11 @@ DTK_MapHandle DTK_createMap( DTK_ExecutionSpace space, MPI_Comm comm,
     // For demonstration purposes just use the nearest neighbor map.
     auto handle = reinterpret_cast<DTK_MapHandle>(
         DataTransferKit::createMap( space, comm, source, target, options ) );
-    DataTransferKit::valid_map_handles.insert( handle );
+    {
+        std::lock_guard<std::mutex> lock(
+            DataTransferKit::valid_map_handles_mutex );
+        DataTransferKit::valid_map_handles.insert( handle );
+    }
 
     errno = DTK_SUCCESS;
 
@@ -56,6 +66,8 @@ DTK_MapHandle DTK_createMap( DTK_ExecutionSpace space, MPI_Comm comm,
 bool DTK_isValidMap( DTK_MapHandle handle )
 {
     errno = DTK_SUCCESS;
+    std::lock_guard<std::mutex> lock(
+        DataTransferKit::valid_map_handles_mutex );
     return DataTransferKit::valid_map_handles.count( handle );
 }
 
@@ -75,14 +87,84 @@ void DTK_applyMap( DTK_MapHandle handle, const char *source_field,
     errno = DTK_SUCCESS;
 }
 
+//---------------------------------------------------------------------------//
+void DTK_applyMapMany( DTK_MapHandle handle, int num_fields,
+                       const char **source_fields, const char **target_fields )
+{
+    if ( !DTK_isValidMap( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return;
+    }
+
+    std::vector<std::string> source_field_names( source_fields,
+                                                 source_fields + num_fields );
+    std::vector<std::string> target_field_names( target_fields,
+                                                 target_fields + num_fields );
+    reinterpret_cast<DataTransferKit::DTK_Map *>( handle )->apply(
+        source_field_names, target_field_names );
+
+    errno = DTK_SUCCESS;
+}
+
+//---------------------------------------------------------------------------//
+size_t DTK_getMapNumAllocations( DTK_MapHandle handle )
+{
+    if ( !DTK_isValidMap( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return 0;
+    }
+
+    errno = DTK_SUCCESS;
+
+    return reinterpret_cast<DataTransferKit::DTK_Map *>( handle )
+        ->numAllocations();
+}
+
+//---------------------------------------------------------------------------//
+size_t DTK_getMapStatistics( DTK_MapHandle handle, char *json_buffer,
+                             size_t buffer_size )
+{
+    if ( !DTK_isValidMap( handle ) )
+    {
+        errno = DTK_INVALID_HANDLE;
+        return 0;
+    }
+
+    std::ostringstream os;
+    reinterpret_cast<DataTransferKit::DTK_Map *>( handle )
+        ->statistics()
+        .writeJSON( os );
+    std::string const json = os.str();
+
+    // The string is truncated to fit in the buffer.
+    if ( json_buffer != nullptr && buffer_size > 0 )
+    {
+        auto const length = std::min( json.size(), buffer_size - 1 );
+        std::copy_n( json.data(), length, json_buffer );
+        json_buffer[length] = '\0';
+    }
+
+    errno = DTK_SUCCESS;
+
+    return json.size() + 1;
+}
+
 //---------------------------------------------------------------------------//
 void DTK_destroyMap( DTK_MapHandle handle )
 {
-    if ( DataTransferKit::valid_map_handles.count( handle ) )
+    bool valid_handle;
+    {
+        std::lock_guard<std::mutex> lock(
+            DataTransferKit::valid_map_handles_mutex );
+        valid_handle = DataTransferKit::valid_map_handles.erase( handle ) > 0;
+    }
+
+    if ( valid_handle )
     {
         auto dtk = reinterpret_cast<DataTransferKit::DTK_Map *>( handle );
         delete dtk;
-        DataTransferKit::valid_map_handles.erase( handle );
         errno = DTK_SUCCESS;
     }
     else
@@ -17,11 +17,13 @@
 
 #include <DTK_C_API.h>
 #include <DTK_C_API.hpp>
+#include <DTK_ConsistentInterpolationOperator.hpp>
 #include <DTK_DBC.hpp>
 #include <DTK_MovingLeastSquaresOperator.hpp>
 #include <DTK_NearestNeighborOperator.hpp>
 #include <DTK_ParallelTraits.hpp>
 #include <DTK_PointCloudOperator.hpp>
+#include <DTK_Tracing.hpp>
 #include <DTK_UserApplication.hpp>
 
 #include <boost/property_tree/json_parser.hpp>
@@ -29,9 +31,15 @@
 
 #include <mpi.h>
 
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace DataTransferKit
 {
@@ -48,7 +56,115 @@ struct DTK_Map
 
     virtual void apply( const std::string &source_field_name,
                         const std::string &target_field_name ) = 0;
+
+    // Apply the map to several fields at once. The values of all the fields
+    // are exchanged together.
+    virtual void
+    apply( const std::vector<std::string> &source_field_names,
+           const std::vector<std::string> &target_field_names ) = 0;
+
+    // Number of buffers allocated by the map to apply it since its
+    // construction.
+    virtual std::size_t numAllocations() const = 0;
+
+    // Costs of the map on the calling rank since its construction. On top of
+    // the phases of its operator, the map records the time spent getting the
+    // values from the source in "apply_gather" and giving them to the target
+    // in "apply_scatter".
+    virtual OperatorStatistics statistics() const = 0;
+};
+
+//---------------------------------------------------------------------------//
+// Lock of the default execution space instances. ArborX and the setup of the
+// operators launch kernels on them, use their scratch space, and fence them
+// globally, which Kokkos does not support from several threads at once. It is
+// held while a map is set up and while its operator exchanges the values, and
+// during the whole application of the maps that use the default instance.
+inline std::mutex &defaultInstancesMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Execution space instance on which a map gathers and scatters the values of
+// the fields. With Cuda, each map runs on its own stream so that independent
+// maps can overlap these copies. The other execution spaces use their default
+// instance.
+template <class ExecSpace>
+struct ExecutionSpaceInstance
+{
+    static bool constexpr owned = false;
+
+    ExecSpace get() const { return ExecSpace(); }
+};
+
+#if defined( KOKKOS_ENABLE_CUDA )
+template <>
+struct ExecutionSpaceInstance<Cuda>
+{
+    static bool constexpr owned = true;
+
+    ExecutionSpaceInstance()
+    {
+        cudaStreamCreate( &_stream );
+        _space = Cuda( _stream );
+    }
+    ~ExecutionSpaceInstance()
+    {
+        // Release the instance before its stream.
+        _space = Cuda();
+        cudaStreamDestroy( _stream );
+    }
+    ExecutionSpaceInstance( ExecutionSpaceInstance const & ) = delete;
+    ExecutionSpaceInstance &
+    operator=( ExecutionSpaceInstance const & ) = delete;
+
+    Cuda get() const { return _space; }
+
+    cudaStream_t _stream;
+    Cuda _space;
 };
+#endif
+
+//---------------------------------------------------------------------------//
+// Registry of an application that does not live on the calling rank, when the
+// source and the target live on disjoint groups of ranks. It has no nodes and
+// its fields have no degrees of freedom.
+std::shared_ptr<UserFunctionRegistry<double>> makeAbsentApplicationRegistry()
+{
+    auto registry = std::make_shared<UserFunctionRegistry<double>>();
+    registry->setNodeListSizeFunction( []( std::shared_ptr<void>,
+                                           unsigned &space_dim,
+                                           size_t &local_num_nodes ) {
+        // The operators only handle three-dimensional points.
+        space_dim = 3;
+        local_num_nodes = 0;
+    } );
+    registry->setNodeListDataFunction(
+        []( std::shared_ptr<void>, View<Coordinate> ) {} );
+    registry->setFieldSizeFunction(
+        []( std::shared_ptr<void>, const std::string &, unsigned &field_dim,
+            size_t &local_num_dofs ) {
+            field_dim = 1;
+            local_num_dofs = 0;
+        } );
+    registry->setPullFieldDataFunction(
+        []( std::shared_ptr<void>, const std::string &, View<double> ) {} );
+    registry->setPushFieldDataFunction(
+        []( std::shared_ptr<void>, const std::string &,
+            const View<double> ) {} );
+    return registry;
+}
+
+// Get the registry of a user application. A null handle stands for an
+// application that does not live on the calling rank.
+std::shared_ptr<UserFunctionRegistry<double>>
+getRegistry( DTK_UserApplicationHandle handle )
+{
+    if ( handle == nullptr )
+        return makeAbsentApplicationRegistry();
+    return reinterpret_cast<DTK_Registry *>( handle )->_registry;
+}
 
 //---------------------------------------------------------------------------//
 template <class MapExecSpace, class SourceMemSpace, class TargetMemSpace>
@@ -59,36 +175,99 @@ struct DTK_MapImpl : public DTK_Map
     DTK_MapImpl( MPI_Comm comm, DTK_UserApplicationHandle source,
                  DTK_UserApplicationHandle target,
                  boost::property_tree::ptree const &ptree )
-        : _source( reinterpret_cast<DTK_Registry *>( source )->_registry )
-        , _target( reinterpret_cast<DTK_Registry *>( target )->_registry )
+        : _source( getRegistry( source ) )
+        , _target( getRegistry( target ) )
     {
+        DTK_TRACE_REGION( "create_map" );
+        std::lock_guard<std::mutex> const lock( defaultInstancesMutex() );
+
+        // Each map communicates on its own communicator so that the messages
+        // of maps applied concurrently do not match each other. When the
+        // source and the target live on disjoint groups of ranks, the groups
+        // of the intercommunicator are merged and each rank only holds the
+        // application of its group.
+        int is_intercomm;
+        MPI_Comm_test_inter( comm, &is_intercomm );
+        if ( is_intercomm )
+        {
+            DTK_INSIST( ( source == nullptr ) != ( target == nullptr ) );
+            _role = ( target == nullptr ) ? PointCloudRole::Source
+                                          : PointCloudRole::Target;
+            MPI_Intercomm_merge( comm, _role == PointCloudRole::Target,
+                                 &_comm );
+        }
+        else
+        {
+            DTK_INSIST( source != nullptr && target != nullptr );
+            _role = PointCloudRole::SourceAndTarget;
+            MPI_Comm_dup( comm, &_comm );
+        }
+        try
+        {
+            createOperator( ptree );
+        }
+        catch ( ... )
+        {
+            MPI_Comm_free( &_comm );
+            throw;
+        }
+    }
+
+    void createOperator( boost::property_tree::ptree const &ptree )
+    {
+        auto const space = _instance.get();
+
         // FOR NOW JUST CREATE A NEAREST NEIGHBOR OPERATOR FOR DEMONSTRATION
         // PURPOSES. THIS WILL BE REPLACED BY A PROPER FACTORY.
 
-        // Get coordinates from the source and target.
-        auto source_nodes = _source.getNodeList().coordinates;
-        auto target_nodes = _target.getNodeList().coordinates;
-
-        // For now things are layout left in the interface so copy to a
-        // matching layout that is compatible with the operator.
-        Kokkos::View<Coordinate **, map_device_type> source_nodes_copy(
-            "src_nodes_copy", source_nodes.extent( 0 ),
-            source_nodes.extent( 1 ) );
-        Kokkos::deep_copy( source_nodes_copy, source_nodes );
-        Kokkos::View<Coordinate **, map_device_type> target_nodes_copy(
-            "tgt_nodes_copy", target_nodes.extent( 0 ),
-            target_nodes.extent( 1 ) );
-        Kokkos::deep_copy( target_nodes_copy, target_nodes );
-
         auto const which_map =
             ptree.get<std::string>( "Map Type", "Undefined" );
         if ( which_map == "Undefined" )
             throw DataTransferKitException(
                 R"(Field "Map Type" is not defined in options string argument for map creation)" );
-        else if ( which_map == "Nearest Neighbor" || which_map == "NN" )
-            _map = std::unique_ptr<NearestNeighborOperator<map_device_type>>(
+        if ( which_map == "Consistent Interpolation" )
+        {
+            createConsistentInterpolation( ptree );
+            return;
+        }
+
+        // Get coordinates from the source and target. The operators accept
+        // any layout so the coordinates are only copied when they do not
+        // live in the memory space of the map.
+        auto source_nodes_copy = getCoordinates( _source );
+        auto target_nodes_copy = getCoordinates( _target );
+
+        auto const search_partition =
+            ptree.get<std::string>( "Search Partition", "Target" );
+        if ( search_partition != "Target" && search_partition != "Source" )
+            throw DataTransferKitException( "Invalid search partition \"" +
+                                            search_partition + "\"" );
+        auto const partition = ( search_partition == "Source" )
+                                   ? SearchPartition::Source
+                                   : SearchPartition::Target;
+
+        if ( which_map == "Nearest Neighbor" || which_map == "NN" )
+        {
+            // The target nodes without a source node within the maximum
+            // distance are assigned the default value when one is given and
+            // left untouched otherwise. In the latter case, the current
+            // values of the target fields are gathered before applying the
+            // map since the buffers of the map do not always alias them.
+            auto const max_distance = ptree.get<double>(
+                "Maximum Distance", std::numeric_limits<double>::infinity() );
+            std::unique_ptr<NearestNeighborOperator<map_device_type>> map(
                 new NearestNeighborOperator<map_device_type>(
-                    comm, source_nodes_copy, target_nodes_copy ) );
+                    _comm, _role, source_nodes_copy, target_nodes_copy,
+                    max_distance, space, partition ) );
+            auto const default_value =
+                ptree.get_optional<double>( "Default Value" );
+            if ( default_value )
+                map->setDefaultValue( *default_value );
+            else
+                _gather_targets =
+                    max_distance < std::numeric_limits<double>::infinity();
+            _map = std::move( map );
+        }
         else if ( which_map == "Moving Least Squares" || which_map == "MLS" )
         {
             // NOTE if field "Order" is misspelled (for instance first letter
@@ -102,7 +281,8 @@ struct DTK_MapImpl : public DTK_Map
                     new MovingLeastSquaresOperator<
                         map_device_type, Wendland<0>,
                         MultivariatePolynomialBasis<Linear, 3>>(
-                        comm, source_nodes_copy, target_nodes_copy ) );
+                        _comm, _role, source_nodes_copy, target_nodes_copy,
+                        space, partition ) );
             else if ( order == "Quadratic" || order == "2" )
                 _map = std::unique_ptr<MovingLeastSquaresOperator<
                     map_device_type, Wendland<0>,
@@ -110,7 +290,8 @@ struct DTK_MapImpl : public DTK_Map
                     new MovingLeastSquaresOperator<
                         map_device_type, Wendland<0>,
                         MultivariatePolynomialBasis<Quadratic, 3>>(
-                        comm, source_nodes_copy, target_nodes_copy ) );
+                        _comm, _role, source_nodes_copy, target_nodes_copy,
+                        space, partition ) );
             else
                 throw DataTransferKitException(
                     "Invalid order \"" + order +
@@ -121,42 +302,516 @@ struct DTK_MapImpl : public DTK_Map
                                             "\"" );
     }
 
+    // Interpolate the finite element fields of the source mesh at the nodes
+    // of the target. All the components of the fields are transferred.
+    void
+    createConsistentInterpolation( boost::property_tree::ptree const &ptree )
+    {
+        // The target nodes are located in the cells of the source mesh on
+        // the ranks of the communicator of the map.
+        DTK_INSIST( _role == PointCloudRole::SourceAndTarget );
+
+        auto const fe_type_name = ptree.get<std::string>( "FE Type", "HGRAD" );
+        DTK_FEType fe_type;
+        if ( fe_type_name == "HGRAD" )
+            fe_type = DTK_HGRAD;
+        else if ( fe_type_name == "HDIV" )
+            fe_type = DTK_HDIV;
+        else if ( fe_type_name == "HCURL" )
+            fe_type = DTK_HCURL;
+        else
+            throw DataTransferKitException(
+                "Invalid finite element type \"" + fe_type_name +
+                "\" for creating a consistent interpolation map" );
+
+        // Get the source mesh and the degrees of freedom of its cells.
+        auto cell_list = _source.getCellList();
+        std::string discretization_type;
+        auto dof_map = _source.getDOFMap( discretization_type );
+
+        using same_space = std::is_same<SourceMemSpace,
+                                        typename map_device_type::memory_space>;
+        Mesh<map_device_type> mesh(
+            copyToMapSpace<DTK_CellTopology>( cell_list.cell_topologies,
+                                              "cell_topologies" ),
+            copyToMapSpace<unsigned int>( cell_list.cells, "cells" ),
+            toDefaultLayout(
+                toMapSpace( cell_list.coordinates, same_space() ) ) );
+
+        // The degrees of freedom of each cell are stored contiguously.
+        auto object_dof_ids = copyToMapSpace<LocalOrdinal>(
+            Kokkos::View<LocalOrdinal *, Kokkos::LayoutLeft, SourceMemSpace,
+                         Kokkos::MemoryUnmanaged>(
+                dof_map.object_dof_ids.data(),
+                dof_map.object_dof_ids.span() ),
+            "object_dof_ids" );
+        auto cell_dof_ids = object_dof_ids;
+        if ( dof_map.object_dof_ids.rank() == 2 )
+        {
+            int const n_cells = dof_map.object_dof_ids.extent( 0 );
+            int const dofs_per_cell = dof_map.object_dof_ids.extent( 1 );
+            cell_dof_ids = Kokkos::View<LocalOrdinal *, map_device_type>(
+                "cell_dof_ids", object_dof_ids.extent( 0 ) );
+            Kokkos::parallel_for(
+                DTK_MARK_REGION( "flatten_cell_dof_ids" ),
+                Kokkos::RangePolicy<MapExecSpace>( 0, n_cells ),
+                KOKKOS_LAMBDA( int const i ) {
+                    for ( int j = 0; j < dofs_per_cell; ++j )
+                        cell_dof_ids( i * dofs_per_cell + j ) =
+                            object_dof_ids( i + j * n_cells );
+                } );
+            Kokkos::fence();
+        }
+
+        _map.reset( new ConsistentInterpolationOperator<map_device_type>(
+            _comm, mesh, toDefaultLayout( getCoordinates( _target ) ),
+            cell_dof_ids, fe_type, _instance.get() ) );
+        _all_components = true;
+    }
+
+    ~DTK_MapImpl() override
+    {
+        // Release the operator before the communicator it uses.
+        _map.reset();
+        int finalized;
+        MPI_Finalized( &finalized );
+        if ( !finalized )
+            MPI_Comm_free( &_comm );
+    }
+
     void apply( const std::string &source_field_name,
                 const std::string &target_field_name ) override
     {
-        // Create fields.
-        auto source_field = _source.getField( source_field_name );
-        auto target_field = _target.getField( target_field_name );
-
-        // Pull the data from the source.
-        _source.pullField( source_field_name, source_field );
-
-        // Copy to a compatible layout. Nearest neighbor operator needs a
-        // compatible layout and only 1 dimension
-        int num_src = source_field.dofs.extent( 0 );
-        Kokkos::View<double *, map_device_type> source_field_copy(
-            "source_field_copy", num_src );
-        Kokkos::deep_copy(
-            source_field_copy,
-            Kokkos::subview( source_field.dofs, Kokkos::ALL, 0 ) );
-        int num_tgt = target_field.dofs.extent( 0 );
-        Kokkos::View<double *, map_device_type> target_field_copy(
-            "target_field_copy", num_tgt );
-
-        // Apply the map.
-        _map->apply( source_field_copy, target_field_copy );
-
-        // Copy the transferred field back to the original target layout.
-        Kokkos::deep_copy( Kokkos::subview( target_field.dofs, Kokkos::ALL, 0 ),
-                           target_field_copy );
+        DTK_TRACE_REGION( "apply_map" );
+        auto lock = lockDefaultInstances();
+
+        // Get the buffers of the fields. They are only set up the first time
+        // a field is transferred or when the application signals that the
+        // field changed.
+        auto const space = _instance.get();
+        ScopedPhaseTimer<MapExecSpace> gather_timer( _statistics,
+                                                     "apply_gather", space );
+        auto &source = getBuffer( _source, _source_buffers, source_field_name,
+                                  "source_values" );
+        auto &target = getBuffer( _target, _target_buffers, target_field_name,
+                                  "target_values" );
+
+        // Pull the data from the source. Registered fields are used in place.
+        if ( !source.registered )
+            _source.pullField( source_field_name, source.field );
+        copyToValues( source );
+
+        // Pull the data from the target as well when the map leaves some of
+        // its values untouched.
+        if ( _gather_targets )
+        {
+            if ( !target.registered )
+                _target.pullField( target_field_name, target.field );
+            copyToValues( target );
+        }
+        gather_timer.stop();
+
+        // Apply the map. The point cloud operators only handle the first
+        // component of the fields.
+        DTK_REQUIRE( source.values.extent( 1 ) == target.values.extent( 1 ) );
+        if ( !lock.owns_lock() )
+            lock.lock();
+        if ( source.values.extent( 1 ) == 1 )
+            _map->apply( Kokkos::subview( source.values, Kokkos::ALL, 0 ),
+                         Kokkos::subview( target.values, Kokkos::ALL, 0 ) );
+        else
+            _map->applyMany( source.values, target.values );
+        if ( ExecutionSpaceInstance<MapExecSpace>::owned )
+            lock.unlock();
 
         // Push the data to the target.
-        _target.pushField( target_field_name, target_field );
+        ScopedPhaseTimer<MapExecSpace> scatter_timer( _statistics,
+                                                      "apply_scatter", space );
+        copyFromValues( target );
+        if ( !target.registered )
+            _target.pushField( target_field_name, target.field );
+    }
+
+    void apply( const std::vector<std::string> &source_field_names,
+                const std::vector<std::string> &target_field_names ) override
+    {
+        DTK_TRACE_REGION( "apply_map" );
+        auto lock = lockDefaultInstances();
+        DTK_REQUIRE( source_field_names.size() == target_field_names.size() );
+        int const n_fields = source_field_names.size();
+        if ( n_fields == 0 )
+            return;
+
+        // Get the buffers of the fields and gather the fields that go
+        // through the user functions so that they are pulled and pushed
+        // together.
+        auto const space = _instance.get();
+        ScopedPhaseTimer<MapExecSpace> gather_timer( _statistics,
+                                                     "apply_gather", space );
+        std::vector<FieldBuffer<SourceMemSpace> *> sources( n_fields );
+        std::vector<FieldBuffer<TargetMemSpace> *> targets( n_fields );
+        std::vector<std::string> pulled_names;
+        std::vector<std::string> pushed_names;
+        std::vector<Field<double, Kokkos::LayoutLeft, SourceMemSpace>>
+            pulled_fields;
+        std::vector<Field<double, Kokkos::LayoutLeft, TargetMemSpace>>
+            pushed_fields;
+        for ( int i = 0; i < n_fields; ++i )
+        {
+            sources[i] = &getBuffer( _source, _source_buffers,
+                                     source_field_names[i], "source_values" );
+            targets[i] = &getBuffer( _target, _target_buffers,
+                                     target_field_names[i], "target_values" );
+            if ( !sources[i]->registered )
+            {
+                pulled_names.push_back( source_field_names[i] );
+                pulled_fields.push_back( sources[i]->field );
+            }
+            if ( !targets[i]->registered )
+            {
+                pushed_names.push_back( target_field_names[i] );
+                pushed_fields.push_back( targets[i]->field );
+            }
+        }
+
+        // Pull the data from the source, and from the target when the map
+        // leaves some of its values untouched.
+        if ( !pulled_names.empty() )
+            _source.pullFields( pulled_names, pulled_fields );
+        if ( _gather_targets && !pushed_names.empty() )
+            _target.pullFields( pushed_names, pushed_fields );
+
+        // Pack the values of all the fields, one component per column. The
+        // packed views are only reallocated when their extents change.
+        unsigned int const n_source_values = sources[0]->values.extent( 0 );
+        unsigned int const n_target_values = targets[0]->values.extent( 0 );
+        std::vector<int> columns( n_fields + 1, 0 );
+        for ( int i = 0; i < n_fields; ++i )
+        {
+            DTK_REQUIRE( sources[i]->values.extent( 0 ) == n_source_values );
+            DTK_REQUIRE( targets[i]->values.extent( 0 ) == n_target_values );
+            DTK_REQUIRE( sources[i]->values.extent( 1 ) ==
+                         targets[i]->values.extent( 1 ) );
+            columns[i + 1] = columns[i] + sources[i]->values.extent_int( 1 );
+        }
+        int const n_columns = columns[n_fields];
+        if ( _packed_source_values.extent( 0 ) != n_source_values ||
+             _packed_source_values.extent_int( 1 ) != n_columns )
+        {
+            _packed_source_values = Kokkos::View<double **, map_device_type>(
+                "packed_source_values", n_source_values, n_columns );
+            ++_num_allocations;
+        }
+        if ( _packed_target_values.extent( 0 ) != n_target_values ||
+             _packed_target_values.extent_int( 1 ) != n_columns )
+        {
+            _packed_target_values = Kokkos::View<double **, map_device_type>(
+                "packed_target_values", n_target_values, n_columns );
+            ++_num_allocations;
+        }
+        for ( int i = 0; i < n_fields; ++i )
+        {
+            copyToValues( *sources[i] );
+            Kokkos::deep_copy(
+                space,
+                Kokkos::subview( _packed_source_values, Kokkos::ALL,
+                                 std::make_pair( columns[i], columns[i + 1] ) ),
+                sources[i]->values );
+            if ( _gather_targets )
+            {
+                copyToValues( *targets[i] );
+                Kokkos::deep_copy(
+                    space,
+                    Kokkos::subview(
+                        _packed_target_values, Kokkos::ALL,
+                        std::make_pair( columns[i], columns[i + 1] ) ),
+                    targets[i]->values );
+            }
+        }
+        space.fence();
+        gather_timer.stop();
+
+        // Apply the map to all the fields at once.
+        if ( !lock.owns_lock() )
+            lock.lock();
+        _map->applyMany( _packed_source_values, _packed_target_values );
+        if ( ExecutionSpaceInstance<MapExecSpace>::owned )
+            lock.unlock();
+
+        // Unpack the values and push the data to the target.
+        ScopedPhaseTimer<MapExecSpace> scatter_timer( _statistics,
+                                                      "apply_scatter", space );
+        for ( int i = 0; i < n_fields; ++i )
+        {
+            Kokkos::deep_copy(
+                space, targets[i]->values,
+                Kokkos::subview(
+                    _packed_target_values, Kokkos::ALL,
+                    std::make_pair( columns[i], columns[i + 1] ) ) );
+            space.fence();
+            copyFromValues( *targets[i] );
+        }
+        if ( !pushed_names.empty() )
+            _target.pushFields( pushed_names, pushed_fields );
+    }
+
+    std::size_t numAllocations() const override { return _num_allocations; }
+
+    OperatorStatistics statistics() const override
+    {
+        auto statistics = _map->statistics();
+        for ( auto const &phase : _statistics.phase_times )
+            statistics.phase_times[phase.first] += phase.second;
+        return statistics;
+    }
+
+    using MapCoordinates =
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride,
+                     map_device_type>;
+
+    // Get the coordinates of the nodes of a user application in the memory
+    // space of the map. Coordinates lent by the application are used as they
+    // are, whatever their layout.
+    template <class MemSpace>
+    static MapCoordinates
+    getCoordinates( UserApplication<double, MemSpace> &user_app )
+    {
+        using same_space =
+            std::is_same<MemSpace, typename map_device_type::memory_space>;
+        if ( user_app.hasRegisteredNodeList() )
+            return toMapSpace( user_app.getRegisteredNodeList().coordinates,
+                               same_space() );
+        return toMapSpace( user_app.getNodeList().coordinates, same_space() );
+    }
+
+    template <class View>
+    static MapCoordinates toMapSpace( View coordinates, std::true_type )
+    {
+        return coordinates;
+    }
+
+    template <class View>
+    static MapCoordinates toMapSpace( View coordinates, std::false_type )
+    {
+        // Deep copies between memory spaces require contiguous views with
+        // matching layouts. The layout is kept to avoid a transpose.
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft,
+                     typename View::memory_space>
+            staging( "coordinates_staging", coordinates.extent( 0 ),
+                     coordinates.extent( 1 ) );
+        Kokkos::deep_copy( staging, coordinates );
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, map_device_type>
+            coordinates_copy( "coordinates", coordinates.extent( 0 ),
+                              coordinates.extent( 1 ) );
+        Kokkos::deep_copy( coordinates_copy, staging );
+        return coordinates_copy;
+    }
+
+    // Copy a contiguous rank-1 view of an application to the memory space of
+    // the map, converting its values to T.
+    template <class T, class View>
+    static Kokkos::View<T *, map_device_type>
+    copyToMapSpace( View const &view, std::string const &label )
+    {
+        int const n = view.extent( 0 );
+        Kokkos::View<typename View::non_const_value_type *, Kokkos::LayoutLeft,
+                     map_device_type>
+            copy( label + "_copy", n );
+        Kokkos::deep_copy( copy, view );
+        Kokkos::View<T *, map_device_type> converted( label, n );
+        Kokkos::parallel_for( DTK_MARK_REGION( "convert_values" ),
+                              Kokkos::RangePolicy<MapExecSpace>( 0, n ),
+                              KOKKOS_LAMBDA( int const i ) {
+                                  converted( i ) = copy( i );
+                              } );
+        Kokkos::fence();
+        return converted;
+    }
+
+    // Copy coordinates in the memory space of the map to a view with the
+    // default layout.
+    static Kokkos::View<Coordinate **, map_device_type>
+    toDefaultLayout( MapCoordinates coordinates )
+    {
+        Kokkos::View<Coordinate **, map_device_type> copy(
+            "coordinates", coordinates.extent( 0 ), coordinates.extent( 1 ) );
+        Kokkos::deep_copy( copy, coordinates );
+        return copy;
+    }
+
+    // Buffers used to transfer a field.
+    template <class MemSpace>
+    struct FieldBuffer
+    {
+        // Whether the memory of the field is lent by the application.
+        bool registered;
+        // Version of the field when the buffer was set up.
+        std::size_t version;
+        // Field allocated for the user functions. Empty for registered
+        // fields.
+        Field<double, Kokkos::LayoutLeft, MemSpace> field;
+        // Degrees of freedom of the field, registered or allocated.
+        Kokkos::View<double **, Kokkos::LayoutStride, MemSpace> dofs;
+        // Components of the degrees of freedom transferred by the map, in the
+        // memory space of the map. It aliases dofs, whatever their layout,
+        // when they live in the memory space of the map.
+        Kokkos::View<double **, Kokkos::LayoutStride, map_device_type> values;
+        // Copy of the components with the layout of the values, only needed
+        // when they live in another memory space than the map and their
+        // layout differs.
+        Kokkos::View<double **, Kokkos::LayoutLeft, MemSpace> staging;
+    };
+
+    // Lock of the default execution space instances, taken right away when
+    // the map runs on them and before applying the operator otherwise.
+    std::unique_lock<std::mutex> lockDefaultInstances() const
+    {
+        std::unique_lock<std::mutex> lock( defaultInstancesMutex(),
+                                           std::defer_lock );
+        if ( !ExecutionSpaceInstance<MapExecSpace>::owned )
+            lock.lock();
+        return lock;
+    }
+
+    // Get the buffer of a field, setting it up if needed.
+    template <class MemSpace>
+    FieldBuffer<MemSpace> &
+    getBuffer( UserApplication<double, MemSpace> &user_app,
+               std::unordered_map<std::string, FieldBuffer<MemSpace>> &buffers,
+               std::string const &field_name, std::string const &label )
+    {
+        auto const version = user_app.fieldVersion( field_name );
+        auto cached = buffers.find( field_name );
+        if ( cached != buffers.end() && cached->second.version == version )
+            return cached->second;
+
+        FieldBuffer<MemSpace> buffer;
+        buffer.registered = user_app.hasRegisteredField( field_name );
+        buffer.version = version;
+        if ( buffer.registered )
+        {
+            buffer.dofs = user_app.getRegisteredField( field_name ).dofs;
+        }
+        else
+        {
+            buffer.field = user_app.getField( field_name );
+            buffer.dofs = buffer.field.dofs;
+            ++_num_allocations;
+        }
+
+        auto components = getComponents( buffer.dofs );
+        int const n = components.extent( 0 );
+        int const n_components = components.extent( 1 );
+        bool const same_space =
+            std::is_same<MemSpace,
+                         typename map_device_type::memory_space>::value;
+        if ( same_space )
+        {
+            buffer.values =
+                Kokkos::View<double **, Kokkos::LayoutStride, map_device_type>(
+                    components.data(),
+                    Kokkos::LayoutStride( n, components.stride( 0 ),
+                                          n_components,
+                                          components.stride( 1 ) ) );
+        }
+        else
+        {
+            buffer.values = Kokkos::View<double **, Kokkos::LayoutLeft,
+                                         map_device_type>( label, n,
+                                                           n_components );
+            ++_num_allocations;
+            bool const layout_left =
+                components.stride( 0 ) == 1 &&
+                ( n_components == 1 || components.stride( 1 ) == n );
+            if ( !layout_left )
+            {
+                buffer.staging =
+                    Kokkos::View<double **, Kokkos::LayoutLeft, MemSpace>(
+                        label + "_staging", n, n_components );
+                ++_num_allocations;
+            }
+        }
+
+        return buffers[field_name] = buffer;
+    }
+
+    // Components of the degrees of freedom transferred by the map: all of
+    // them for the finite element maps, the first one otherwise.
+    template <class MemSpace>
+    Kokkos::View<double **, Kokkos::LayoutStride, MemSpace> getComponents(
+        Kokkos::View<double **, Kokkos::LayoutStride, MemSpace> dofs ) const
+    {
+        int const n_components = _all_components ? dofs.extent_int( 1 ) : 1;
+        return Kokkos::subview( dofs, Kokkos::ALL,
+                                std::make_pair( 0, n_components ) );
+    }
+
+    // Copy the transferred components of the degrees of freedom to the values
+    // of the buffer if they do not alias them. The copies to the memory space
+    // of the map are done on the execution space instance of the map.
+    template <class Buffer>
+    void copyToValues( Buffer const &buffer ) const
+    {
+        auto components = getComponents( buffer.dofs );
+        if ( buffer.values.data() == components.data() )
+            return;
+
+        // Deep copies between memory spaces require contiguous views with
+        // matching layouts.
+        auto const space = _instance.get();
+        if ( buffer.staging.extent( 0 ) > 0 )
+        {
+            Kokkos::deep_copy( buffer.staging, components );
+            Kokkos::deep_copy( space, buffer.values, buffer.staging );
+        }
+        else
+        {
+            Kokkos::deep_copy( space, buffer.values, components );
+        }
+        space.fence();
+    }
+
+    // Copy the values of the buffer back to the transferred components of the
+    // degrees of freedom if they do not alias them.
+    template <class Buffer>
+    void copyFromValues( Buffer const &buffer ) const
+    {
+        auto components = getComponents( buffer.dofs );
+        if ( buffer.values.data() == components.data() )
+            return;
+
+        auto const space = _instance.get();
+        if ( buffer.staging.extent( 0 ) > 0 )
+        {
+            Kokkos::deep_copy( space, buffer.staging, buffer.values );
+            space.fence();
+            Kokkos::deep_copy( components, buffer.staging );
+        }
+        else
+        {
+            Kokkos::deep_copy( space, components, buffer.values );
+            space.fence();
+        }
     }
 
+    MPI_Comm _comm;
+    PointCloudRole _role;
+    ExecutionSpaceInstance<MapExecSpace> _instance;
     UserApplication<double, SourceMemSpace> _source;
     UserApplication<double, TargetMemSpace> _target;
     std::unique_ptr<PointCloudOperator<map_device_type>> _map;
+    std::unordered_map<std::string, FieldBuffer<SourceMemSpace>>
+        _source_buffers;
+    std::unordered_map<std::string, FieldBuffer<TargetMemSpace>>
+        _target_buffers;
+    Kokkos::View<double **, map_device_type> _packed_source_values;
+    Kokkos::View<double **, map_device_type> _packed_target_values;
+    // Whether the current values of the target fields are gathered before
+    // applying the map because it leaves some of them untouched.
+    bool _gather_targets = false;
+    std::size_t _num_allocations = 0;
+    OperatorStatistics _statistics;
+    bool _all_components = false;
 };
 
 //---------------------------------------------------------------------------//
@@ -253,11 +908,17 @@ DTK_Map *createMap( DTK_ExecutionSpace map_space, MPI_Comm comm,
             "map creation" );
     }
 
-    // Get the user source and target memory spaces.
+    // Get the user source and target memory spaces. An application that does
+    // not live on the calling rank uses the memory space of the other one.
+    DTK_INSIST( source != nullptr || target != nullptr );
     DTK_MemorySpace src_space =
-        reinterpret_cast<DataTransferKit::DTK_Registry *>( source )->_space;
+        reinterpret_cast<DataTransferKit::DTK_Registry *>(
+            source != nullptr ? source : target )
+            ->_space;
     DTK_MemorySpace tgt_space =
-        reinterpret_cast<DataTransferKit::DTK_Registry *>( target )->_space;
+        reinterpret_cast<DataTransferKit::DTK_Registry *>(
+            target != nullptr ? target : source )
+            ->_space;
 
     // Check up front that we have been asked for execution and memory spaces
     // that are available in the kokkos build. This lets use a little cleaner
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file
+ * \brief Finite element interpolation behind the point cloud operator
+ * interface used by the maps.
+ */
+#ifndef DTK_CONSISTENT_INTERPOLATION_OPERATOR_HPP
+#define DTK_CONSISTENT_INTERPOLATION_OPERATOR_HPP
+
+#include <DTK_DBC.hpp>
+#include <DTK_Interpolation.hpp>
+#include <DTK_Mesh.hpp>
+#include <DTK_PointCloudOperator.hpp>
+
+#include <mpi.h>
+
+#include <string>
+
+namespace DataTransferKit
+{
+
+// Evaluate the finite element fields of a source mesh at the target points.
+// The source values are the degrees of freedom of the source cells and each
+// column holds one field or one component of a field. Target points that are
+// not located in any source cell get zero values. The statistics only hold
+// the time spent in the "interpolation" phase of the applications.
+//
+// The operator copies the source values to, and gathers the values of the
+// target points that were found from, work views that are kept between the
+// applications and only reallocated when the number of fields changes. These
+// copies run on the execution space instance \p space. Interpolation::apply()
+// still allocates its communication buffers at each application and runs on
+// the default instance of the execution space.
+template <typename DeviceType>
+class ConsistentInterpolationOperator : public PointCloudOperator<DeviceType>
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    ConsistentInterpolationOperator(
+        MPI_Comm comm, Mesh<DeviceType> const &mesh,
+        Kokkos::View<double **, DeviceType> target_points,
+        Kokkos::View<LocalOrdinal *, DeviceType> cell_dof_ids,
+        DTK_FEType fe_type, ExecutionSpace const &space = ExecutionSpace() )
+        : _interpolation( comm, mesh, target_points, cell_dof_ids, fe_type )
+        , _n_target_points( target_points.extent( 0 ) )
+        , _space( space )
+    {
+    }
+
+    void apply(
+        Kokkos::View<double const *, Kokkos::LayoutStride, DeviceType>
+            source_values,
+        Kokkos::View<double *, Kokkos::LayoutStride, DeviceType> target_values )
+        const override
+    {
+        // Apply the operator to the values seen as a single column.
+        applyMany(
+            Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>(
+                source_values.data(),
+                Kokkos::LayoutStride( source_values.extent( 0 ),
+                                      source_values.stride( 0 ), 1, 1 ) ),
+            Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>(
+                target_values.data(),
+                Kokkos::LayoutStride( target_values.extent( 0 ),
+                                      target_values.stride( 0 ), 1, 1 ) ) );
+    }
+
+    void applyMany(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            source_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            target_values ) const override
+    {
+        DTK_REQUIRE( target_values.extent( 0 ) == _n_target_points );
+        DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+        ++this->_statistics.num_applications;
+        ScopedPhaseTimer<ExecutionSpace> timer( this->_statistics,
+                                                "interpolation", _space );
+        int const n_fields = target_values.extent( 1 );
+        reserve( _source_work, "source_values", source_values.extent( 0 ),
+                 n_fields );
+        reserve( _found_values, "found_values", _n_target_points, n_fields );
+
+        // Interpolation::apply() only accepts contiguous views. It returns
+        // the values of the points that were found first, along with the ids
+        // of the points.
+        Kokkos::deep_copy( _space, _source_work, source_values );
+        _space.fence();
+        auto found_query_ids =
+            _interpolation.apply( _source_work, _found_values );
+
+        // We cannot use the members in a lambda function with CUDA.
+        auto found_values = _found_values;
+        Kokkos::deep_copy( _space, target_values, 0. );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "scatter_found_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( _space, 0,
+                                                 _n_target_points ),
+            KOKKOS_LAMBDA( int const i ) {
+                int const query_id = found_query_ids( i );
+                if ( query_id >= 0 )
+                    for ( int j = 0; j < n_fields; ++j )
+                        target_values( query_id, j ) = found_values( i, j );
+            } );
+        _space.fence();
+    }
+
+  private:
+    // Reallocate a work view when its extents change.
+    static void reserve( Kokkos::View<double **, DeviceType> &view,
+                         std::string const &label, int n, int m )
+    {
+        if ( view.extent_int( 0 ) != n || view.extent_int( 1 ) != m )
+            view = Kokkos::View<double **, DeviceType>(
+                Kokkos::ViewAllocateWithoutInitializing( label ), n, m );
+    }
+
+    // Interpolation::apply() is not const but does not modify the operator.
+    mutable Interpolation<DeviceType> _interpolation;
+    unsigned int const _n_target_points;
+    ExecutionSpace _space;
+    mutable Kokkos::View<double **, DeviceType> _source_work;
+    mutable Kokkos::View<double **, DeviceType> _found_values;
+};
+
+} // end namespace DataTransferKit
+
+#endif // DTK_CONSISTENT_INTERPOLATION_OPERATOR_HPP
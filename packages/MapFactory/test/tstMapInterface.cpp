@@ -25,7 +25,12 @@
 
 #include <Kokkos_Core.hpp>
 
+#include <cstring>
 #include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 //---------------------------------------------------------------------------//
 // User implementation
@@ -86,6 +91,129 @@ void pushField( void *user_data, const char *, const double *field_dofs )
         data->field( i ) = field_dofs[i];
 }
 
+template <class Space>
+void pullFields( void *user_data, int num_fields, const char **field_names,
+                 double **field_dofs )
+{
+    for ( int f = 0; f < num_fields; ++f )
+        pullField<Space>( user_data, field_names[f], field_dofs[f] );
+}
+template <class Space>
+void pushFields( void *user_data, int num_fields, const char **field_names,
+                 const double **field_dofs )
+{
+    for ( int f = 0; f < num_fields; ++f )
+        pushField<Space>( user_data, field_names[f], field_dofs[f] );
+}
+
+//---------------------------------------------------------------------------//
+// User implementation of a finite element mesh made of a single hexahedron
+// and of a cloud of points, both with a two-component field at their nodes.
+template <class Space>
+struct TestMeshData
+{
+    Kokkos::View<double * [3], Space> coords;
+    Kokkos::View<double * [2], Space> field;
+
+    TestMeshData( const int size )
+        : coords( "coords", size )
+        , field( "field", size )
+    {
+    }
+};
+
+template <class Space>
+void meshNodeListSize( void *user_data, unsigned *space_dim,
+                       size_t *local_num_nodes )
+{
+    TestMeshData<Space> *data = static_cast<TestMeshData<Space> *>( user_data );
+    *space_dim = data->coords.extent( 1 );
+    *local_num_nodes = data->coords.extent( 0 );
+}
+
+template <class Space>
+void meshNodeListData( void *user_data, Coordinate *coords )
+{
+    TestMeshData<Space> *data = static_cast<TestMeshData<Space> *>( user_data );
+    int num_node = data->coords.extent( 0 );
+    for ( unsigned n = 0; n < data->coords.extent( 0 ); ++n )
+        for ( unsigned d = 0; d < data->coords.extent( 1 ); ++d )
+            coords[num_node * d + n] = data->coords( n, d );
+}
+
+template <class Space>
+void meshCellListSize( void *user_data, unsigned *space_dim,
+                       size_t *local_num_nodes, size_t *local_num_cells,
+                       size_t *total_cell_nodes )
+{
+    meshNodeListSize<Space>( user_data, space_dim, local_num_nodes );
+    *local_num_cells = 1;
+    *total_cell_nodes = *local_num_nodes;
+}
+
+template <class Space>
+void meshCellListData( void *user_data, Coordinate *coords,
+                       LocalOrdinal *cells, DTK_CellTopology *cell_topologies )
+{
+    TestMeshData<Space> *data = static_cast<TestMeshData<Space> *>( user_data );
+    meshNodeListData<Space>( user_data, coords );
+    for ( unsigned n = 0; n < data->coords.extent( 0 ); ++n )
+        cells[n] = n;
+    cell_topologies[0] = DTK_HEX_8;
+}
+
+template <class Space>
+void meshDOFMapSize( void *user_data, size_t *local_num_dofs,
+                     size_t *local_num_objects, unsigned *dofs_per_object )
+{
+    TestMeshData<Space> *data = static_cast<TestMeshData<Space> *>( user_data );
+    *local_num_dofs = data->field.extent( 0 );
+    *local_num_objects = 1;
+    *dofs_per_object = data->field.extent( 0 );
+}
+
+template <class Space>
+void meshDOFMapData( void *user_data, GlobalOrdinal *global_dof_ids,
+                     LocalOrdinal *object_dof_ids, char *discretization_type )
+{
+    TestMeshData<Space> *data = static_cast<TestMeshData<Space> *>( user_data );
+    for ( unsigned i = 0; i < data->field.extent( 0 ); ++i )
+    {
+        global_dof_ids[i] = i;
+        object_dof_ids[i] = i;
+    }
+    std::strcpy( discretization_type, "HEX_HGRAD_1" );
+}
+
+template <class Space>
+void meshFieldSize( void *user_data, const char *, unsigned *field_dimension,
+                    size_t *local_num_dofs )
+{
+    TestMeshData<Space> *data = static_cast<TestMeshData<Space> *>( user_data );
+    *field_dimension = data->field.extent( 1 );
+    *local_num_dofs = data->field.extent( 0 );
+}
+
+template <class Space>
+void meshPullField( void *user_data, const char *, double *field_dofs )
+{
+    TestMeshData<Space> *data = static_cast<TestMeshData<Space> *>( user_data );
+    int num_dofs = data->field.extent( 0 );
+    for ( unsigned i = 0; i < data->field.extent( 0 ); ++i )
+        for ( unsigned c = 0; c < data->field.extent( 1 ); ++c )
+            field_dofs[num_dofs * c + i] = data->field( i, c );
+}
+
+template <class Space>
+void meshPushField( void *user_data, const char *, const double *field_dofs )
+{
+    TestMeshData<Space> *data = static_cast<TestMeshData<Space> *>( user_data );
+    int num_dofs = data->field.extent( 0 );
+    for ( unsigned i = 0; i < data->field.extent( 0 ); ++i )
+        for ( unsigned c = 0; c < data->field.extent( 1 ); ++c )
+            data->field( i, c ) = field_dofs[num_dofs * c + i];
+}
+
 //---------------------------------------------------------------------------//
 // Test execution space enumeration selector.
 template <class Space>
@@ -142,6 +270,9 @@ void test( bool &success, Teuchos::FancyOStream &out )
     DTK_MapHandle bad_handle = nullptr;
     DTK_applyMap( bad_handle, "bad", "bad" );
     TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
+    TEST_EQUALITY( DTK_getMapStatistics( bad_handle, nullptr, 0 ),
+                   static_cast<size_t>( 0 ) );
+    TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
     DTK_destroyMap( bad_handle );
     TEST_EQUALITY( errno, DTK_INVALID_HANDLE );
 
@@ -280,6 +411,42 @@ void test( bool &success, Teuchos::FancyOStream &out )
         DTK_applyMap( map_handle, "dummy", "dummy" );
         TEST_EQUALITY( errno, DTK_SUCCESS );
 
+        // Applying the map again reuses the buffers of the fields until the
+        // application signals a change.
+        auto const num_allocations = DTK_getMapNumAllocations( map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_applyMap( map_handle, "dummy", "dummy" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_EQUALITY( DTK_getMapNumAllocations( map_handle ),
+                       num_allocations );
+        DTK_notifyFieldChanged( tgt_handle, "dummy" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_applyMap( map_handle, "dummy", "dummy" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        TEST_COMPARE( DTK_getMapNumAllocations( map_handle ), >,
+                      num_allocations );
+
+        // The statistics are returned as a JSON object. Its size can be
+        // queried first and it is truncated to fit in smaller buffers.
+        auto const statistics_size =
+            DTK_getMapStatistics( map_handle, nullptr, 0 );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        std::vector<char> statistics( statistics_size );
+        TEST_EQUALITY( DTK_getMapStatistics( map_handle, statistics.data(),
+                                             statistics.size() ),
+                       statistics_size );
+        std::string const json( statistics.data() );
+        TEST_EQUALITY( json.size() + 1, statistics_size );
+        TEST_EQUALITY( json.front(), '{' );
+        TEST_EQUALITY( json.back(), '}' );
+        TEST_INEQUALITY( json.find( R"("num_applications":3)" ),
+                         std::string::npos );
+        TEST_INEQUALITY( json.find( R"("apply_exchange":)" ),
+                         std::string::npos );
+        char truncated[4];
+        DTK_getMapStatistics( map_handle, truncated, sizeof( truncated ) );
+        TEST_EQUALITY( std::string( truncated ), json.substr( 0, 3 ) );
+
         double const relative_tolerance = 1e-14;
         // NOTE adding the same value to both lhs and rhs to resolve floating
         // point comparison issues with zero using Teuchos assertion macro
@@ -296,10 +463,468 @@ void test( bool &success, Teuchos::FancyOStream &out )
         TEST_EQUALITY( errno, DTK_SUCCESS );
     }
 
+    // Check map apply with fields and coordinates whose memory is lent by the
+    // applications. The coordinates are used in their native layout.
+    DTK_registerNodeList(
+        src_handle, src_data->coords.data(), num_point, 3,
+        std::is_same<typename decltype( src_data->coords )::array_layout,
+                     Kokkos::LayoutRight>::value
+            ? DTK_INTERLEAVED_FIELD_LAYOUT
+            : DTK_BLOCKED_FIELD_LAYOUT );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_registerNodeList(
+        tgt_handle, tgt_data->coords.data(), num_point, 3,
+        std::is_same<typename decltype( tgt_data->coords )::array_layout,
+                     Kokkos::LayoutRight>::value
+            ? DTK_INTERLEAVED_FIELD_LAYOUT
+            : DTK_BLOCKED_FIELD_LAYOUT );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_registerField( src_handle, "registered", src_data->field.data(),
+                       num_point, 1, DTK_BLOCKED_FIELD_LAYOUT );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_registerField( tgt_handle, "registered", tgt_data->field.data(),
+                       num_point, 1, DTK_INTERLEAVED_FIELD_LAYOUT );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    for ( std::string const options : {
+              R"({ "Map Type": "Nearest Neighbor" })",
+              R"({ "Map Type": "Moving Least Squares" })",
+          } )
+    {
+        for ( int p = 0; p < num_point; ++p )
+            tgt_data->field( p ) = 0.0;
+
+        auto map_handle =
+            DTK_createMap( SpaceSelector<MapSpace>::value(), comm, src_handle,
+                           tgt_handle, options.c_str() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        DTK_applyMap( map_handle, "registered", "registered" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        // The fields are used in place when they live in the memory space
+        // of the map.
+        if ( std::is_same<typename MapSpace::memory_space,
+                          SourceSpace>::value &&
+             std::is_same<typename MapSpace::memory_space,
+                          TargetSpace>::value )
+            TEST_EQUALITY( DTK_getMapNumAllocations( map_handle ),
+                           static_cast<size_t>( 0 ) );
+
+        double const relative_tolerance = 1e-14;
+        double const shift_from_zero = 3.14;
+        for ( int p = 0; p < num_point; ++p )
+        {
+            TEST_FLOATING_EQUALITY( tgt_data->field( p ) + shift_from_zero,
+                                    1.0 * p + inverse_rank * num_point +
+                                        shift_from_zero,
+                                    relative_tolerance );
+        }
+
+        DTK_destroyMap( map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+    }
+
+    // Check map apply with several fields at once, pulled and pushed
+    // together or registered.
+    DTK_setUserFunction( src_handle, DTK_PULL_FIELDS_DATA_FUNCTION,
+                         ( void ( * )() ) & pullFields<SourceSpace>,
+                         src_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( tgt_handle, DTK_PUSH_FIELDS_DATA_FUNCTION,
+                         ( void ( * )() ) & pushFields<TargetSpace>,
+                         tgt_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    for ( std::string const options : {
+              R"({ "Map Type": "Nearest Neighbor" })",
+              R"({ "Map Type": "Moving Least Squares" })",
+          } )
+    {
+        for ( int p = 0; p < num_point; ++p )
+            tgt_data->field( p ) = 0.0;
+
+        auto map_handle =
+            DTK_createMap( SpaceSelector<MapSpace>::value(), comm, src_handle,
+                           tgt_handle, options.c_str() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        const char *field_names[] = {"dummy", "registered"};
+        DTK_applyMapMany( map_handle, 2, field_names, field_names );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        double const relative_tolerance = 1e-14;
+        double const shift_from_zero = 3.14;
+        for ( int p = 0; p < num_point; ++p )
+        {
+            TEST_FLOATING_EQUALITY( tgt_data->field( p ) + shift_from_zero,
+                                    1.0 * p + inverse_rank * num_point +
+                                        shift_from_zero,
+                                    relative_tolerance );
+        }
+
+        DTK_destroyMap( map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+    }
+
+    DTK_unregisterField( src_handle, "registered" );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_unregisterField( tgt_handle, "registered" );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_unregisterNodeList( src_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_unregisterNodeList( tgt_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    // Check the nearest neighbor map with a maximum distance. Every other
+    // target point is moved away from the source points and keeps its value
+    // unless a default value is given.
+    auto far_data = std::make_shared<TestUserData<TargetSpace>>( num_point );
+    for ( int p = 0; p < num_point; ++p )
+        for ( int d = 0; d < 3; ++d )
+            far_data->coords( p, d ) =
+                1.0 * p + inverse_rank * num_point + ( p % 2 ) * 0.5;
+    auto far_handle =
+        DTK_createUserApplication( SpaceSelector<TargetSpace>::value() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( far_handle, DTK_NODE_LIST_SIZE_FUNCTION,
+                         ( void ( * )() ) & nodeListSize<TargetSpace>,
+                         far_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( far_handle, DTK_NODE_LIST_DATA_FUNCTION,
+                         ( void ( * )() ) & nodeListData<TargetSpace>,
+                         far_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( far_handle, DTK_FIELD_SIZE_FUNCTION,
+                         ( void ( * )() ) & fieldSize<TargetSpace>,
+                         far_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( far_handle, DTK_PULL_FIELD_DATA_FUNCTION,
+                         ( void ( * )() ) & pullField<TargetSpace>,
+                         far_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( far_handle, DTK_PUSH_FIELD_DATA_FUNCTION,
+                         ( void ( * )() ) & pushField<TargetSpace>,
+                         far_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    for ( bool const with_default_value : {false, true} )
+    {
+        std::string const options =
+            with_default_value
+                ? R"({ "Map Type": "NN", "Maximum Distance": 0.5, "Default Value": 42 })"
+                : R"({ "Map Type": "NN", "Maximum Distance": 0.5 })";
+        double const missing_value = with_default_value ? 42. : -1.;
+        auto map_handle =
+            DTK_createMap( SpaceSelector<MapSpace>::value(), comm, src_handle,
+                           far_handle, options.c_str() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        // Apply the map to one field, then to several fields at once.
+        const char *field_names[] = {"dummy"};
+        for ( bool const many : {false, true} )
+        {
+            for ( int p = 0; p < num_point; ++p )
+                far_data->field( p ) = -1.;
+            if ( many )
+                DTK_applyMapMany( map_handle, 1, field_names, field_names );
+            else
+                DTK_applyMap( map_handle, "dummy", "dummy" );
+            TEST_EQUALITY( errno, DTK_SUCCESS );
+
+            double const relative_tolerance = 1e-14;
+            double const shift_from_zero = 3.14;
+            for ( int p = 0; p < num_point; ++p )
+            {
+                double const expected =
+                    ( p % 2 ) ? missing_value
+                              : 1.0 * p + inverse_rank * num_point;
+                TEST_FLOATING_EQUALITY( far_data->field( p ) +
+                                            shift_from_zero,
+                                        expected + shift_from_zero,
+                                        relative_tolerance );
+            }
+        }
+
+        DTK_destroyMap( map_handle );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+    }
+    DTK_destroyUserApplication( far_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
     DTK_destroyUserApplication( src_handle );
     TEST_EQUALITY( errno, DTK_SUCCESS );
     DTK_destroyUserApplication( tgt_handle );
     TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    DTK_finalize();
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+}
+
+//---------------------------------------------------------------------------//
+// Check the consistent interpolation map.
+template <class MapSpace, class SourceSpace, class TargetSpace>
+void testConsistentInterpolation( bool &success, Teuchos::FancyOStream &out )
+{
+    DTK_initialize();
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    auto teuchos_comm = Teuchos::DefaultComm<int>::getComm();
+    auto comm = Teuchos::getRawMpiComm( *teuchos_comm );
+    int comm_rank = teuchos_comm->getRank();
+    int inverse_rank = teuchos_comm->getSize() - comm_rank - 1;
+
+    // Check the consistent interpolation of a two-component field. Each rank
+    // holds a unit cube shifted along the x-axis by its rank and the target
+    // points lie in the cube of another rank. The linear fields are exactly
+    // represented by the finite element.
+    auto linear = []( double x, double y, double z ) {
+        return x + 2. * y + 3. * z;
+    };
+    auto mesh_data = std::make_shared<TestMeshData<SourceSpace>>( 8 );
+    for ( int n = 0; n < 8; ++n )
+    {
+        mesh_data->coords( n, 0 ) =
+            comm_rank + ( ( n % 4 == 1 || n % 4 == 2 ) ? 1. : 0. );
+        mesh_data->coords( n, 1 ) = ( n % 4 == 2 || n % 4 == 3 ) ? 1. : 0.;
+        mesh_data->coords( n, 2 ) = ( n < 4 ) ? 0. : 1.;
+        double const value =
+            linear( mesh_data->coords( n, 0 ), mesh_data->coords( n, 1 ),
+                    mesh_data->coords( n, 2 ) );
+        mesh_data->field( n, 0 ) = value;
+        mesh_data->field( n, 1 ) = -2. * value;
+    }
+    int const num_target_point = 3;
+    auto points_data =
+        std::make_shared<TestMeshData<TargetSpace>>( num_target_point );
+    for ( int p = 0; p < num_target_point; ++p )
+    {
+        points_data->coords( p, 0 ) = inverse_rank + .25 * ( p + 1 );
+        points_data->coords( p, 1 ) = .5;
+        points_data->coords( p, 2 ) = .25 * ( p + 1 );
+    }
+
+    auto mesh_handle =
+        DTK_createUserApplication( SpaceSelector<SourceSpace>::value() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( mesh_handle, DTK_CELL_LIST_SIZE_FUNCTION,
+                         ( void ( * )() ) & meshCellListSize<SourceSpace>,
+                         mesh_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( mesh_handle, DTK_CELL_LIST_DATA_FUNCTION,
+                         ( void ( * )() ) & meshCellListData<SourceSpace>,
+                         mesh_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( mesh_handle, DTK_DOF_MAP_SIZE_FUNCTION,
+                         ( void ( * )() ) & meshDOFMapSize<SourceSpace>,
+                         mesh_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( mesh_handle, DTK_DOF_MAP_DATA_FUNCTION,
+                         ( void ( * )() ) & meshDOFMapData<SourceSpace>,
+                         mesh_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( mesh_handle, DTK_FIELD_SIZE_FUNCTION,
+                         ( void ( * )() ) & meshFieldSize<SourceSpace>,
+                         mesh_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( mesh_handle, DTK_PULL_FIELD_DATA_FUNCTION,
+                         ( void ( * )() ) & meshPullField<SourceSpace>,
+                         mesh_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    auto points_handle =
+        DTK_createUserApplication( SpaceSelector<TargetSpace>::value() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( points_handle, DTK_NODE_LIST_SIZE_FUNCTION,
+                         ( void ( * )() ) & meshNodeListSize<TargetSpace>,
+                         points_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( points_handle, DTK_NODE_LIST_DATA_FUNCTION,
+                         ( void ( * )() ) & meshNodeListData<TargetSpace>,
+                         points_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( points_handle, DTK_FIELD_SIZE_FUNCTION,
+                         ( void ( * )() ) & meshFieldSize<TargetSpace>,
+                         points_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_setUserFunction( points_handle, DTK_PUSH_FIELD_DATA_FUNCTION,
+                         ( void ( * )() ) & meshPushField<TargetSpace>,
+                         points_data.get() );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    TEST_THROW(
+        DTK_createMap( SpaceSelector<MapSpace>::value(), comm, mesh_handle,
+                       points_handle,
+                       R"({ "Map Type": "Consistent Interpolation", "FE Type": "Invalid" })" ),
+        DataTransferKit::DataTransferKitException );
+
+    auto interpolation_handle = DTK_createMap(
+        SpaceSelector<MapSpace>::value(), comm, mesh_handle, points_handle,
+        R"({ "Map Type": "Consistent Interpolation" })" );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    // Applying the map again reuses its buffers and its work views.
+    double const shift_from_zero = 3.14;
+    std::size_t num_allocations = 0;
+    for ( int application = 0; application < 2; ++application )
+    {
+        for ( int p = 0; p < num_target_point; ++p )
+            for ( int c = 0; c < 2; ++c )
+                points_data->field( p, c ) = 0.;
+
+        DTK_applyMap( interpolation_handle, "field", "field" );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        if ( application == 0 )
+            num_allocations = DTK_getMapNumAllocations( interpolation_handle );
+        else
+            TEST_EQUALITY( DTK_getMapNumAllocations( interpolation_handle ),
+                           num_allocations );
+
+        for ( int p = 0; p < num_target_point; ++p )
+        {
+            double const value = linear( points_data->coords( p, 0 ),
+                                         points_data->coords( p, 1 ),
+                                         points_data->coords( p, 2 ) );
+            TEST_FLOATING_EQUALITY( points_data->field( p, 0 ) +
+                                        shift_from_zero,
+                                    value + shift_from_zero, 1e-12 );
+            TEST_FLOATING_EQUALITY( points_data->field( p, 1 ) +
+                                        shift_from_zero,
+                                    -2. * value + shift_from_zero, 1e-12 );
+        }
+    }
+
+    DTK_destroyMap( interpolation_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_destroyUserApplication( mesh_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+    DTK_destroyUserApplication( points_handle );
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    DTK_finalize();
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+}
+
+//---------------------------------------------------------------------------//
+// Apply independent maps concurrently from several threads.
+template <class MapSpace, class SourceSpace, class TargetSpace>
+void testConcurrentApply( bool &success, Teuchos::FancyOStream &out )
+{
+    int provided;
+    MPI_Query_thread( &provided );
+    if ( provided < MPI_THREAD_MULTIPLE )
+    {
+        out << "MPI does not support calls from several threads at once\n";
+        return;
+    }
+
+    DTK_initialize();
+    TEST_EQUALITY( errno, DTK_SUCCESS );
+
+    // Each map transfers its own field between applications of the calling
+    // rank so that the ranks do not wait for each other, whatever the order
+    // in which the threads apply the maps.
+    int const num_maps = 2;
+    int const num_point = 1000;
+    std::vector<std::shared_ptr<TestUserData<SourceSpace>>> src_data;
+    std::vector<std::shared_ptr<TestUserData<TargetSpace>>> tgt_data;
+    std::vector<DTK_UserApplicationHandle> src_handles;
+    std::vector<DTK_UserApplicationHandle> tgt_handles;
+    std::vector<DTK_MapHandle> map_handles;
+    for ( int m = 0; m < num_maps; ++m )
+    {
+        src_data.push_back(
+            std::make_shared<TestUserData<SourceSpace>>( num_point ) );
+        tgt_data.push_back(
+            std::make_shared<TestUserData<TargetSpace>>( num_point ) );
+        for ( int p = 0; p < num_point; ++p )
+        {
+            for ( int d = 0; d < 3; ++d )
+            {
+                src_data[m]->coords( p, d ) = 1.0 * p;
+                tgt_data[m]->coords( p, d ) = 1.0 * p;
+            }
+            src_data[m]->field( p ) = 1.0 * p * ( m + 1 );
+            tgt_data[m]->field( p ) = 0.0;
+        }
+
+        src_handles.push_back(
+            DTK_createUserApplication( SpaceSelector<SourceSpace>::value() ) );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( src_handles[m], DTK_NODE_LIST_SIZE_FUNCTION,
+                             ( void ( * )() ) & nodeListSize<SourceSpace>,
+                             src_data[m].get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( src_handles[m], DTK_NODE_LIST_DATA_FUNCTION,
+                             ( void ( * )() ) & nodeListData<SourceSpace>,
+                             src_data[m].get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( src_handles[m], DTK_FIELD_SIZE_FUNCTION,
+                             ( void ( * )() ) & fieldSize<SourceSpace>,
+                             src_data[m].get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( src_handles[m], DTK_PULL_FIELD_DATA_FUNCTION,
+                             ( void ( * )() ) & pullField<SourceSpace>,
+                             src_data[m].get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        tgt_handles.push_back(
+            DTK_createUserApplication( SpaceSelector<TargetSpace>::value() ) );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( tgt_handles[m], DTK_NODE_LIST_SIZE_FUNCTION,
+                             ( void ( * )() ) & nodeListSize<TargetSpace>,
+                             tgt_data[m].get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( tgt_handles[m], DTK_NODE_LIST_DATA_FUNCTION,
+                             ( void ( * )() ) & nodeListData<TargetSpace>,
+                             tgt_data[m].get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( tgt_handles[m], DTK_FIELD_SIZE_FUNCTION,
+                             ( void ( * )() ) & fieldSize<TargetSpace>,
+                             tgt_data[m].get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_setUserFunction( tgt_handles[m], DTK_PUSH_FIELD_DATA_FUNCTION,
+                             ( void ( * )() ) & pushField<TargetSpace>,
+                             tgt_data[m].get() );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+
+        map_handles.push_back(
+            DTK_createMap( SpaceSelector<MapSpace>::value(), MPI_COMM_SELF,
+                           src_handles[m], tgt_handles[m],
+                           R"({ "Map Type": "Nearest Neighbor" })" ) );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+    }
+
+    // errno is local to each thread.
+    int const num_applications = 10;
+    std::vector<int> errors( num_maps, DTK_SUCCESS );
+    std::vector<std::thread> threads;
+    for ( int m = 0; m < num_maps; ++m )
+        threads.emplace_back( [&, m]() {
+            for ( int i = 0; i < num_applications; ++i )
+            {
+                DTK_applyMap( map_handles[m], "dummy", "dummy" );
+                if ( errno != DTK_SUCCESS )
+                    errors[m] = errno;
+            }
+        } );
+    for ( auto &thread : threads )
+        thread.join();
+
+    double const relative_tolerance = 1e-14;
+    double const shift_from_zero = 3.14;
+    for ( int m = 0; m < num_maps; ++m )
+    {
+        TEST_EQUALITY( errors[m], DTK_SUCCESS );
+        for ( int p = 0; p < num_point; ++p )
+            TEST_FLOATING_EQUALITY( tgt_data[m]->field( p ) + shift_from_zero,
+                                    1.0 * p * ( m + 1 ) + shift_from_zero,
+                                    relative_tolerance );
+
+        DTK_destroyMap( map_handles[m] );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_destroyUserApplication( src_handles[m] );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+        DTK_destroyUserApplication( tgt_handles[m] );
+        TEST_EQUALITY( errno, DTK_SUCCESS );
+    }
+
     DTK_finalize();
     TEST_EQUALITY( errno, DTK_SUCCESS );
 }
@@ -313,6 +938,19 @@ TEUCHOS_UNIT_TEST( MapInterface, Serial )
     test<DataTransferKit::Serial, DataTransferKit::HostSpace,
          DataTransferKit::HostSpace>( success, out );
 }
+
+TEUCHOS_UNIT_TEST( MapInterface, ConsistentInterpolationSerial )
+{
+    testConsistentInterpolation<DataTransferKit::Serial,
+                                DataTransferKit::HostSpace,
+                                DataTransferKit::HostSpace>( success, out );
+}
+
+TEUCHOS_UNIT_TEST( MapInterface, ConcurrentSerial )
+{
+    testConcurrentApply<DataTransferKit::Serial, DataTransferKit::HostSpace,
+                        DataTransferKit::HostSpace>( success, out );
+}
 #endif
 
 //---------------------------------------------------------------------------//
@@ -322,6 +960,19 @@ TEUCHOS_UNIT_TEST( MapInterface, OpenMP )
     test<DataTransferKit::OpenMP, DataTransferKit::HostSpace,
          DataTransferKit::HostSpace>( success, out );
 }
+
+TEUCHOS_UNIT_TEST( MapInterface, ConsistentInterpolationOpenMP )
+{
+    testConsistentInterpolation<DataTransferKit::OpenMP,
+                                DataTransferKit::HostSpace,
+                                DataTransferKit::HostSpace>( success, out );
+}
+
+TEUCHOS_UNIT_TEST( MapInterface, ConcurrentOpenMP )
+{
+    testConcurrentApply<DataTransferKit::OpenMP, DataTransferKit::HostSpace,
+                        DataTransferKit::HostSpace>( success, out );
+}
 #endif
 
 //---------------------------------------------------------------------------//
@@ -331,6 +982,19 @@ TEUCHOS_UNIT_TEST( MapInterface, Cuda )
     test<DataTransferKit::Cuda, DataTransferKit::CudaUVMSpace,
          DataTransferKit::CudaUVMSpace>( success, out );
 }
+
+TEUCHOS_UNIT_TEST( MapInterface, ConsistentInterpolationCuda )
+{
+    testConsistentInterpolation<DataTransferKit::Cuda,
+                                DataTransferKit::CudaUVMSpace,
+                                DataTransferKit::CudaUVMSpace>( success, out );
+}
+
+TEUCHOS_UNIT_TEST( MapInterface, ConcurrentCuda )
+{
+    testConcurrentApply<DataTransferKit::Cuda, DataTransferKit::CudaUVMSpace,
+                        DataTransferKit::CudaUVMSpace>( success, out );
+}
 #endif
 
 //---------------------------------------------------------------------------//
@@ -11,16 +11,21 @@
 
 #include <Kokkos_Core.hpp>
 
-#include <Teuchos_GlobalMPISession.hpp>
 #include <Teuchos_UnitTestRepository.hpp>
 
+#include <mpi.h>
+
 int main( int argc, char *argv[] )
 {
-    Teuchos::GlobalMPISession mpiSession( &argc, &argv );
+    // The maps are applied concurrently from several threads when MPI
+    // supports it.
+    int provided;
+    MPI_Init_thread( &argc, &argv, MPI_THREAD_MULTIPLE, &provided );
     Teuchos::UnitTestRepository::setGloballyReduceTestResult( true );
     Kokkos::initialize( argc, argv );
     int return_val =
         Teuchos::UnitTestRepository::runUnitTestsFromMain( argc, argv );
     Kokkos::finalize();
+    MPI_Finalize();
     return return_val;
 }
@@ -0,0 +1,307 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file PointCloudScaling.cpp
+ * \brief Weak and strong scaling of the point cloud operators.
+ *
+ * The problems are generated in memory by SyntheticProblemGenerator. The
+ * driver sweeps the number of ranks by running on the first 1, 2, 4, ...
+ * ranks of MPI_COMM_WORLD so that a single oversubscribed launch, e.g.
+ * mpirun --oversubscribe -np 16, gives a whole scaling curve. For each
+ * number of ranks, it sweeps the problem sizes, which are per rank for weak
+ * scaling and in total for strong scaling. The setup time, the apply time,
+ * and the error of each operator are printed as comma-separated values.
+ */
+//---------------------------------------------------------------------------//
+
+#include "PointCloudProblemGenerator/SyntheticProblemGenerator.hpp"
+
+#include <DTK_Core.hpp>
+#include <DTK_DBC.hpp>
+#include <DTK_MovingLeastSquaresOperator.hpp>
+#include <DTK_NearestNeighborOperator.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using DeviceType = Kokkos::View<DataTransferKit::Coordinate **>::device_type;
+using ExecutionSpace = DeviceType::execution_space;
+using Generator =
+    DataTransferKit::SyntheticProblemGenerator<double, DeviceType, DeviceType>;
+using CoordView = Kokkos::View<DataTransferKit::Coordinate **,
+                               Kokkos::LayoutLeft, DeviceType>;
+using FieldView = Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType>;
+
+//---------------------------------------------------------------------------//
+// Time spent by the slowest rank of comm in function, in microseconds.
+template <typename Function>
+double timeCollective( MPI_Comm comm, Function const &function )
+{
+    MPI_Barrier( comm );
+    auto const start = std::chrono::steady_clock::now();
+    function();
+    Kokkos::fence();
+    std::chrono::duration<double, std::micro> const elapsed =
+        std::chrono::steady_clock::now() - start;
+    double local_time = elapsed.count();
+    double time;
+    MPI_Allreduce( &local_time, &time, 1, MPI_DOUBLE, MPI_MAX, comm );
+    return time;
+}
+
+//---------------------------------------------------------------------------//
+// Largest difference over all the ranks of comm between the values and the
+// expected values.
+double maxError( MPI_Comm comm, Kokkos::View<double *, DeviceType> values,
+                 FieldView expected )
+{
+    double local_error = 0.;
+    Kokkos::parallel_reduce(
+        "compute_error",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, values.extent( 0 ) ),
+        KOKKOS_LAMBDA( int i, double &error ) {
+            double const diff = values( i ) - expected( i, 0 );
+            double const abs_diff = diff < 0. ? -diff : diff;
+            if ( abs_diff > error )
+                error = abs_diff;
+        },
+        Kokkos::Max<double>( local_error ) );
+    double error;
+    MPI_Allreduce( &local_error, &error, 1, MPI_DOUBLE, MPI_MAX, comm );
+    return error;
+}
+
+//---------------------------------------------------------------------------//
+// Setup and apply times, in microseconds, and error of an operator.
+struct Result
+{
+    double setup_time;
+    double apply_time;
+    double error;
+};
+
+template <typename Operator>
+Result benchmarkOperator( MPI_Comm comm, CoordView source_points,
+                          FieldView source_field, CoordView target_points,
+                          FieldView target_field, int num_applications )
+{
+    Result result;
+
+    std::unique_ptr<Operator> op;
+    result.setup_time = timeCollective( comm, [&]() {
+        op.reset( new Operator( comm, source_points, target_points ) );
+    } );
+
+    auto source_values = Kokkos::subview( source_field, Kokkos::ALL, 0 );
+    Kokkos::View<double *, DeviceType> target_values(
+        "target_values", target_points.extent( 0 ) );
+    auto const apply = [&]() {
+        for ( int i = 0; i < num_applications; ++i )
+            op->apply( source_values, target_values );
+    };
+    result.apply_time = timeCollective( comm, apply ) / num_applications;
+
+    result.error = maxError( comm, target_values, target_field );
+
+    return result;
+}
+
+//---------------------------------------------------------------------------//
+void printUsage( char const *executable )
+{
+    std::cout
+        << "Usage: " << executable << " [options]\n"
+        << "  --mode MODE            weak, strong, or both (default both)\n"
+        << "  --min-points N         smallest problem size (default 1000)\n"
+        << "  --max-points N         largest problem size (default 100000)\n"
+        << "  --source DIST          distribution of the sources: uniform, "
+           "clustered, surface, or anisotropic (default uniform)\n"
+        << "  --target DIST          distribution of the targets (default "
+           "uniform)\n"
+        << "  --mismatch FRACTION    shift of the target partition (default "
+           "0.5)\n"
+        << "  --applications N       applications timed per operator "
+           "(default 10)\n"
+        << "  --output FILE          file the results are written to "
+           "(default standard output)\n";
+}
+
+//---------------------------------------------------------------------------//
+int main( int argc, char *argv[] )
+{
+    MPI_Init( &argc, &argv );
+    DataTransferKit::initialize( &argc, &argv );
+
+    std::string mode = "both";
+    int min_points = 1000;
+    int max_points = 100000;
+    DataTransferKit::SyntheticProblemParameters parameters;
+    int num_applications = 10;
+    std::string output;
+
+    static option const long_options[] = {
+        {"mode", required_argument, nullptr, 'M'},
+        {"min-points", required_argument, nullptr, 'n'},
+        {"max-points", required_argument, nullptr, 'N'},
+        {"source", required_argument, nullptr, 's'},
+        {"target", required_argument, nullptr, 't'},
+        {"mismatch", required_argument, nullptr, 'm'},
+        {"applications", required_argument, nullptr, 'a'},
+        {"output", required_argument, nullptr, 'o'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}};
+    int opt;
+    while ( ( opt = getopt_long( argc, argv, "M:n:N:s:t:m:a:o:h", long_options,
+                                 nullptr ) ) != -1 )
+    {
+        switch ( opt )
+        {
+        case 'M':
+            mode = optarg;
+            break;
+        case 'n':
+            min_points = std::atoi( optarg );
+            break;
+        case 'N':
+            max_points = std::atoi( optarg );
+            break;
+        case 's':
+            parameters.src_distribution =
+                DataTransferKit::syntheticDistributionFromString( optarg );
+            break;
+        case 't':
+            parameters.tgt_distribution =
+                DataTransferKit::syntheticDistributionFromString( optarg );
+            break;
+        case 'm':
+            parameters.partition_mismatch = std::atof( optarg );
+            break;
+        case 'a':
+            num_applications = std::atoi( optarg );
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        default:
+            printUsage( argv[0] );
+            DataTransferKit::finalize();
+            MPI_Finalize();
+            return EXIT_FAILURE;
+        }
+    }
+    DTK_INSIST( mode == "weak" || mode == "strong" || mode == "both" );
+    DTK_INSIST( 0 < min_points && min_points <= max_points );
+    DTK_INSIST( num_applications > 0 );
+
+    int world_rank;
+    MPI_Comm_rank( MPI_COMM_WORLD, &world_rank );
+    int world_size;
+    MPI_Comm_size( MPI_COMM_WORLD, &world_size );
+
+    std::ostringstream results;
+    results << "scaling,ranks,points_per_rank,operator,setup_time,apply_time,"
+               "error\n";
+
+    std::vector<std::string> modes;
+    if ( mode != "strong" )
+        modes.push_back( "weak" );
+    if ( mode != "weak" )
+        modes.push_back( "strong" );
+
+    // Run on the first num_ranks ranks. The other ones wait.
+    for ( int num_ranks = 1; num_ranks <= world_size; num_ranks *= 2 )
+    {
+        MPI_Comm comm;
+        MPI_Comm_split( MPI_COMM_WORLD,
+                        world_rank < num_ranks ? 0 : MPI_UNDEFINED, world_rank,
+                        &comm );
+        if ( comm == MPI_COMM_NULL )
+            continue;
+
+        for ( auto const &scaling : modes )
+            for ( int num_points = min_points; num_points <= max_points;
+                  num_points *= 10 )
+            {
+                int const points_per_rank =
+                    scaling == "weak" ? num_points
+                                      : std::max( num_points / num_ranks, 1 );
+                parameters.num_src_per_rank = points_per_rank;
+                parameters.num_tgt_per_rank = points_per_rank;
+
+                CoordView source_points;
+                FieldView source_field;
+                CoordView target_points;
+                FieldView target_field;
+                Generator( comm, parameters )
+                    .createUniquelyOwnedProblem( source_points, source_field,
+                                                 target_points, target_field );
+
+                auto const nearest_neighbor = benchmarkOperator<
+                    DataTransferKit::NearestNeighborOperator<DeviceType>>(
+                    comm, source_points, source_field, target_points,
+                    target_field, num_applications );
+                auto const moving_least_squares = benchmarkOperator<
+                    DataTransferKit::MovingLeastSquaresOperator<DeviceType>>(
+                    comm, source_points, source_field, target_points,
+                    target_field, num_applications );
+
+                if ( world_rank == 0 )
+                    for ( auto const &result :
+                          {std::make_pair( "nearest_neighbor",
+                                           nearest_neighbor ),
+                           std::make_pair( "moving_least_squares",
+                                           moving_least_squares )} )
+                        results << scaling << ',' << num_ranks << ','
+                                << points_per_rank << ',' << result.first
+                                << ',' << result.second.setup_time << ','
+                                << result.second.apply_time << ','
+                                << result.second.error << '\n';
+            }
+
+        MPI_Comm_free( &comm );
+    }
+
+    if ( world_rank == 0 )
+    {
+        if ( output.empty() )
+        {
+            std::cout << results.str();
+        }
+        else
+        {
+            std::ofstream file( output );
+            DTK_INSIST( file.good() );
+            file << results.str();
+        }
+    }
+
+    DataTransferKit::finalize();
+    MPI_Finalize();
+    return EXIT_SUCCESS;
+}
+
+//---------------------------------------------------------------------------//
+// end PointCloudScaling.cpp
+//---------------------------------------------------------------------------//
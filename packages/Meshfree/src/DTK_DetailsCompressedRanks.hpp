@@ -0,0 +1,159 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_DETAILS_COMPRESSED_RANKS_HPP
+#define DTK_DETAILS_COMPRESSED_RANKS_HPP
+
+#include <ArborX.hpp>
+#include <DTK_Tracing.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DataTransferKit
+{
+namespace Details
+{
+
+// Ranks owning the source points of the neighbors of an operator. Most
+// neighbors live on the calling rank or on a handful of neighboring ranks, so
+// the distinct ranks are stored once in a table and each neighbor only keeps
+// the position of its rank in the table, on one byte instead of four. When
+// the neighbors live on more than 256 ranks, the ranks are stored as is.
+template <typename DeviceType>
+class CompressedRanks
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+  public:
+    // Largest number of distinct ranks whose positions fit in one byte.
+    static int constexpr max_table_size = 256;
+
+    CompressedRanks()
+        : _table( "rank_table" )
+        , _positions( "rank_positions" )
+        , _ranks( "ranks" )
+    {
+    }
+
+    // Compress the ranks of the neighbors. They must be ranks of comm.
+    static CompressedRanks
+    compress( MPI_Comm comm, Kokkos::View<int const *, DeviceType> ranks )
+    {
+        int comm_size;
+        MPI_Comm_size( comm, &comm_size );
+        int const n = ranks.extent( 0 );
+
+        // Flag the ranks that are used and number them in increasing order.
+        Kokkos::View<int *, DeviceType> position_in_table( "position_in_table",
+                                                           comm_size + 1 );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "flag_ranks" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+            KOKKOS_LAMBDA( int i ) { position_in_table( ranks( i ) ) = 1; } );
+        ArborX::exclusivePrefixSum( position_in_table );
+        int const table_size = ArborX::lastElement( position_in_table );
+
+        CompressedRanks compressed;
+        if ( table_size > max_table_size )
+        {
+            compressed._ranks = Kokkos::View<int *, DeviceType>(
+                Kokkos::ViewAllocateWithoutInitializing( "ranks" ), n );
+            Kokkos::deep_copy( compressed._ranks, ranks );
+            return compressed;
+        }
+
+        Kokkos::View<int *, DeviceType> table(
+            Kokkos::ViewAllocateWithoutInitializing( "rank_table" ),
+            table_size );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "fill_rank_table" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, comm_size ),
+            KOKKOS_LAMBDA( int r ) {
+                if ( position_in_table( r + 1 ) > position_in_table( r ) )
+                    table( position_in_table( r ) ) = r;
+            } );
+        Kokkos::View<std::uint8_t *, DeviceType> positions(
+            Kokkos::ViewAllocateWithoutInitializing( "rank_positions" ), n );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "compress_ranks" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+            KOKKOS_LAMBDA( int i ) {
+                positions( i ) = static_cast<std::uint8_t>(
+                    position_in_table( ranks( i ) ) );
+            } );
+        Kokkos::fence();
+
+        compressed._compressed = true;
+        compressed._table = table;
+        compressed._positions = positions;
+        return compressed;
+    }
+
+    // Rank of each neighbor, in a new view.
+    Kokkos::View<int *, DeviceType>
+    decompress( ExecutionSpace const &space = ExecutionSpace() ) const
+    {
+        Kokkos::View<int *, DeviceType> ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "ranks" ), size() );
+        if ( !_compressed )
+        {
+            Kokkos::deep_copy( space, ranks, _ranks );
+            space.fence();
+            return ranks;
+        }
+
+        // We cannot use the members in a lambda function with CUDA.
+        auto table = _table;
+        auto positions = _positions;
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "decompress_ranks" ),
+            Kokkos::RangePolicy<ExecutionSpace>( space, 0, size() ),
+            KOKKOS_LAMBDA( int i ) { ranks( i ) = table( positions( i ) ); } );
+        space.fence();
+        return ranks;
+    }
+
+    // Number of neighbors.
+    std::size_t size() const
+    {
+        return _compressed ? _positions.extent( 0 ) : _ranks.extent( 0 );
+    }
+
+    // Whether the positions in the table are stored instead of the ranks.
+    bool isCompressed() const { return _compressed; }
+
+    // Number of bytes held.
+    std::size_t memoryFootprint() const
+    {
+        return _table.span() * sizeof( int ) +
+               _positions.span() * sizeof( std::uint8_t ) +
+               _ranks.span() * sizeof( int );
+    }
+
+  private:
+    bool _compressed = false;
+    // Distinct ranks, in increasing order.
+    Kokkos::View<int *, DeviceType> _table;
+    // Position of the rank of each neighbor in the table.
+    Kokkos::View<std::uint8_t *, DeviceType> _positions;
+    // Rank of each neighbor when there are too many distinct ranks.
+    Kokkos::View<int *, DeviceType> _ranks;
+};
+
+} // namespace Details
+} // namespace DataTransferKit
+
+#endif
@@ -16,6 +16,9 @@
 #include <ArborX_DetailsKokkosExt.hpp> // ArithmeticTraits
 #include <DTK_CompactlySupportedRadialBasisFunctions.hpp>
 #include <DTK_DetailsSVDImpl.hpp>
+#include <DTK_DetailsSetupArena.hpp>
+
+#include <cstddef>
 
 namespace DataTransferKit
 {
@@ -26,14 +29,27 @@ struct MovingLeastSquaresOperatorImpl
 {
     using ExecutionSpace = typename DeviceType::execution_space;
 
+    // Range of the entries of rows [begin, end) of a flattened matrix with
+    // row_size entries per row. The rows are counted with 32-bit integers,
+    // like the neighbors returned by the search, but the entries are counted
+    // with 64-bit integers: 21M targets with a quadratic basis already have
+    // more than 2^31 entries in the moment matrices.
+    KOKKOS_INLINE_FUNCTION
+    static Kokkos::pair<std::size_t, std::size_t>
+    rowRange( int const begin, int const end, std::size_t const row_size )
+    {
+        return Kokkos::make_pair( begin * row_size, end * row_size );
+    }
+
     static Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType>
-    makeKNNQueries( typename Kokkos::View<Coordinate **, DeviceType>::const_type
+    makeKNNQueries( Kokkos::View<Coordinate const **, Kokkos::LayoutStride,
+                                 DeviceType>
                         target_points,
                     unsigned int n_neighbors )
     {
         auto const n_points = target_points.extent( 0 );
         Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType> queries(
-            "queries", n_points );
+            Kokkos::ViewAllocateWithoutInitializing( "queries" ), n_points );
         Kokkos::parallel_for(
             DTK_MARK_REGION( "setup_queries" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
@@ -47,25 +63,63 @@ struct MovingLeastSquaresOperatorImpl
         return queries;
     }
 
+    // The coefficients and the source values may be stored in a narrower
+    // type than double, but the target values are accumulated in double.
+    template <typename Value>
     static Kokkos::View<double *, DeviceType> computeTargetValues(
         Kokkos::View<int const *, DeviceType> offset,
-        Kokkos::View<double const *, DeviceType> polynomial_coeffs,
-        Kokkos::View<double const *, DeviceType> source_values )
+        Kokkos::View<Value const *, DeviceType> polynomial_coeffs,
+        Kokkos::View<Value const *, DeviceType> source_values,
+        ExecutionSpace const &space = ExecutionSpace() )
     {
         auto const n_target_points = offset.extent_int( 0 ) - 1;
         Kokkos::View<double *, DeviceType> target_values(
-            std::string( "target_" ) + source_values.label(), n_target_points );
+            Kokkos::ViewAllocateWithoutInitializing(
+                std::string( "target_" ) + source_values.label() ),
+            n_target_points );
 
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_values" ),
-            Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
+            Kokkos::RangePolicy<ExecutionSpace>( space, 0, n_target_points ),
             KOKKOS_LAMBDA( const int i ) {
-                target_values( i ) = 0.;
+                double value = 0.;
                 for ( int j = offset( i ); j < offset( i + 1 ); ++j )
-                    target_values( i ) +=
-                        polynomial_coeffs( j ) * source_values( j );
+                    value += static_cast<double>( polynomial_coeffs( j ) ) *
+                             source_values( j );
+                target_values( i ) = value;
             } );
-        Kokkos::fence();
+        space.fence();
+
+        return target_values;
+    }
+
+    template <typename Value>
+    static Kokkos::View<double **, DeviceType> computeTargetValues(
+        Kokkos::View<int const *, DeviceType> offset,
+        Kokkos::View<Value const *, DeviceType> polynomial_coeffs,
+        Kokkos::View<Value const **, DeviceType> source_values,
+        ExecutionSpace const &space = ExecutionSpace() )
+    {
+        auto const n_target_points = offset.extent_int( 0 ) - 1;
+        auto const n_fields = source_values.extent_int( 1 );
+        Kokkos::View<double **, DeviceType> target_values(
+            Kokkos::ViewAllocateWithoutInitializing(
+                std::string( "target_" ) + source_values.label() ),
+            n_target_points, n_fields );
+
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "compute_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( space, 0, n_target_points ),
+            KOKKOS_LAMBDA( const int i ) {
+                for ( int k = 0; k < n_fields; ++k )
+                    target_values( i, k ) = 0.;
+                for ( int j = offset( i ); j < offset( i + 1 ); ++j )
+                    for ( int k = 0; k < n_fields; ++k )
+                        target_values( i, k ) +=
+                            static_cast<double>( polynomial_coeffs( j ) ) *
+                            source_values( j, k );
+            } );
+        space.fence();
 
         return target_values;
     }
@@ -73,7 +127,9 @@ struct MovingLeastSquaresOperatorImpl
     static Kokkos::View<Coordinate **, DeviceType> transformSourceCoordinates(
         Kokkos::View<Coordinate const **, DeviceType> source_points,
         Kokkos::View<int const *, DeviceType> offset,
-        Kokkos::View<Coordinate const **, DeviceType> target_points )
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        SetupArena<DeviceType> *arena = nullptr )
     {
         auto const n_source_points = source_points.extent( 0 );
         auto const n_target_points = target_points.extent( 0 );
@@ -84,8 +140,8 @@ struct MovingLeastSquaresOperatorImpl
 
         // Change the coordinates of the source points to relative position to
         // the target points
-        Kokkos::View<Coordinate **, DeviceType> new_source_points(
-            "transformed_source_coords", n_source_points, spatial_dim );
+        auto new_source_points = allocateTemporary<Coordinate **>(
+            arena, "transformed_source_coords", n_source_points, spatial_dim );
         Kokkos::parallel_for(
             DTK_MARK_REGION( "transform" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
@@ -101,10 +157,11 @@ struct MovingLeastSquaresOperatorImpl
 
     static Kokkos::View<double *, DeviceType>
     computeRadius( Kokkos::View<Coordinate const **, DeviceType> source_points,
-                   Kokkos::View<int const *, DeviceType> offset )
+                   Kokkos::View<int const *, DeviceType> offset,
+                   SetupArena<DeviceType> *arena = nullptr )
     {
         unsigned int const n_target_points = offset.extent( 0 ) - 1;
-        Kokkos::View<double *, DeviceType> radius( "radius",
+        auto radius = allocateTemporary<double *>( arena, "radius",
                                                    source_points.extent( 0 ) );
 
         Kokkos::parallel_for(
@@ -146,7 +203,7 @@ struct MovingLeastSquaresOperatorImpl
     static Kokkos::View<double *, DeviceType>
     computeWeights( Kokkos::View<double const **, DeviceType> source_points,
                     Kokkos::View<double const *, DeviceType> radius,
-                    RBF const & )
+                    RBF const &, SetupArena<DeviceType> *arena = nullptr )
     {
         auto const n_source_points = source_points.extent( 0 );
 
@@ -156,7 +213,8 @@ struct MovingLeastSquaresOperatorImpl
         // The argument of rbf is a distance because we have changed the
         // coordinate system such the target point is the origin of the new
         // coordinate system.
-        Kokkos::View<double *, DeviceType> phi( "weights", n_source_points );
+        auto phi = allocateTemporary<double *>( arena, "weights",
+                                                n_source_points );
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_weights" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_source_points ),
@@ -174,20 +232,23 @@ struct MovingLeastSquaresOperatorImpl
     template <typename PolynomialBasis>
     static Kokkos::View<double *, DeviceType>
     computeVandermonde( Kokkos::View<double const **, DeviceType> points,
-                        PolynomialBasis const &polynomial_basis )
+                        PolynomialBasis const &polynomial_basis,
+                        SetupArena<DeviceType> *arena = nullptr )
     {
         auto const n_points = points.extent( 0 );
         auto constexpr size_polynomial_basis = PolynomialBasis::size;
-        Kokkos::View<double *, DeviceType> p(
-            "vandermonde", n_points * size_polynomial_basis );
+        auto p = allocateTemporary<double *>(
+            arena, "vandermonde", n_points * size_polynomial_basis );
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_polynomial_basis" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_points ),
             KOKKOS_LAMBDA( int i ) {
                 auto const tmp = polynomial_basis( ArborX::Point{
                     {points( i, 0 ), points( i, 1 ), points( i, 2 )}} );
+                std::size_t const row =
+                    static_cast<std::size_t>( i ) * size_polynomial_basis;
                 for ( int j = 0; j < size_polynomial_basis; ++j )
-                    p( i * size_polynomial_basis + j ) = tmp[j];
+                    p( row + j ) = tmp[j];
             } );
         return p;
     }
@@ -195,32 +256,32 @@ struct MovingLeastSquaresOperatorImpl
     static Kokkos::View<double *, DeviceType>
     computeMoments( Kokkos::View<int const *, DeviceType> offset,
                     Kokkos::View<double const *, DeviceType> p,
-                    Kokkos::View<double const *, DeviceType> phi )
+                    Kokkos::View<double const *, DeviceType> phi,
+                    SetupArena<DeviceType> *arena = nullptr )
     {
         auto const n_target_points = offset.extent_int( 0 ) - 1;
         auto const n_source_points = phi.extent_int( 0 );
         DTK_REQUIRE( n_source_points == ArborX::lastElement( offset ) );
         if ( n_source_points == 0 )
             return Kokkos::View<double *, DeviceType>( "moments" );
-        auto const size_polynomial_basis = p.extent_int( 0 ) / n_source_points;
-        auto const size_polynomial_basis_squared =
+        // The counts of points fit in an int but their products with the size
+        // of the basis, which index p and a, may not.
+        int const size_polynomial_basis = p.extent( 0 ) / n_source_points;
+        std::size_t const size_polynomial_basis_squared =
             size_polynomial_basis * size_polynomial_basis;
-        Kokkos::View<double *, DeviceType> a(
-            "moments", n_target_points * size_polynomial_basis_squared );
+        auto a = allocateTemporary<double *>(
+            arena, "moments", n_target_points * size_polynomial_basis_squared );
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_moments" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
             KOKKOS_LAMBDA( int i ) {
                 auto p_i = Kokkos::subview(
-                    p, Kokkos::make_pair( offset( i ) * size_polynomial_basis,
-                                          offset( i + 1 ) *
-                                              size_polynomial_basis ) );
+                    p, rowRange( offset( i ), offset( i + 1 ),
+                                 size_polynomial_basis ) );
                 auto phi_i = Kokkos::subview(
                     phi, Kokkos::make_pair( offset( i ), offset( i + 1 ) ) );
                 auto a_i = Kokkos::subview(
-                    a, Kokkos::make_pair( i * size_polynomial_basis_squared,
-                                          ( i + 1 ) *
-                                              size_polynomial_basis_squared ) );
+                    a, rowRange( i, i + 1, size_polynomial_basis_squared ) );
                 for ( int j = 0; j < size_polynomial_basis; ++j )
                     for ( int k = 0; k < size_polynomial_basis; ++k )
                     {
@@ -244,9 +305,11 @@ struct MovingLeastSquaresOperatorImpl
     // matrices of the same size containing corresponding pseudo-inverses
     static std::tuple<Kokkos::View<double *, DeviceType>, size_t>
     invertMoments( Kokkos::View<double const *, DeviceType> a,
-                   const int size_polynomial_basis )
+                   const int size_polynomial_basis,
+                   SetupArena<DeviceType> *arena = nullptr )
     {
-        Kokkos::View<double *, DeviceType> inv_a( "inv_a", a.extent( 0 ) );
+        auto inv_a =
+            allocateTemporary<double *>( arena, "inv_a", a.extent( 0 ) );
 
         auto num_matrices =
             a.extent( 0 ) / ( size_polynomial_basis * size_polynomial_basis );
@@ -256,10 +319,12 @@ struct MovingLeastSquaresOperatorImpl
         // to scratch space (or, at the least, I don't know how to access it).
         // So we preallocate it here, and pass to the functor. We use 2D array
         // as we would like to use 2D matrices inside SVD, and there is no way
-        // to reshape.
-        Kokkos::View<double **, DeviceType> aux( "aux", size_polynomial_basis,
-                                                 3 * num_matrices *
-                                                     size_polynomial_basis );
+        // to reshape. It is released from the arena as soon as the kernel
+        // completes.
+        std::size_t const arena_mark = arena != nullptr ? arena->size() : 0;
+        auto aux = allocateTemporary<double **>(
+            arena, "aux", size_polynomial_basis,
+            3 * num_matrices * size_polynomial_basis );
 
         SVDFunctor<DeviceType> svdFunctor( size_polynomial_basis, a, inv_a,
                                            aux );
@@ -268,50 +333,54 @@ struct MovingLeastSquaresOperatorImpl
             DTK_MARK_REGION( "compute_svd_inverse" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, num_matrices ), svdFunctor,
             num_underdetermined );
+        if ( arena != nullptr )
+            arena->rewind( arena_mark );
 
         return std::make_tuple( inv_a, num_underdetermined );
     }
 
-    static Kokkos::View<double *, DeviceType> computePolynomialCoefficients(
+    // The coefficients are computed in double and stored as Value.
+    template <typename Value = double>
+    static Kokkos::View<Value *, DeviceType> computePolynomialCoefficients(
         Kokkos::View<int const *, DeviceType> offset,
         Kokkos::View<double const *, DeviceType> inv_a,
         Kokkos::View<double const *, DeviceType> p,
         Kokkos::View<double const *, DeviceType> phi,
         const int size_polynomial_basis )
     {
-        auto const size_polynomial_basis_squared =
+        std::size_t const size_polynomial_basis_squared =
             size_polynomial_basis * size_polynomial_basis;
 
         auto num_matrices = inv_a.extent( 0 ) / size_polynomial_basis_squared;
 
-        Kokkos::View<double *, DeviceType> coeffs( "polynomial_coeffs",
-                                                   phi.extent( 0 ) );
+        Kokkos::View<Value *, DeviceType> coeffs(
+            Kokkos::ViewAllocateWithoutInitializing( "polynomial_coeffs" ),
+            phi.extent( 0 ) );
 
         Kokkos::parallel_for(
             DTK_MARK_REGION( "compute_polynomial_coeffs" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, num_matrices ),
             KOKKOS_LAMBDA( const int i ) {
                 auto p_i = Kokkos::subview(
-                    p, Kokkos::make_pair( offset( i ) * size_polynomial_basis,
-                                          offset( i + 1 ) *
-                                              size_polynomial_basis ) );
+                    p, rowRange( offset( i ), offset( i + 1 ),
+                                 size_polynomial_basis ) );
                 auto phi_i = Kokkos::subview(
                     phi, Kokkos::make_pair( offset( i ), offset( i + 1 ) ) );
                 auto inv_a_i = Kokkos::subview(
-                    inv_a, Kokkos::make_pair(
-                               i * size_polynomial_basis_squared,
-                               ( i + 1 ) * size_polynomial_basis_squared ) );
+                    inv_a,
+                    rowRange( i, i + 1, size_polynomial_basis_squared ) );
                 auto coeffs_i = Kokkos::subview(
                     coeffs, Kokkos::make_pair( offset( i ), offset( i + 1 ) ) );
 
                 // coeffs = [1 0 ... 0] * a_inv * p^T * phi
                 for ( int k = 0; k < offset( i + 1 ) - offset( i ); k++ )
                 {
-                    coeffs_i( k ) = 0.;
+                    double coeff = 0.;
                     for ( int j = 0; j < size_polynomial_basis; j++ )
-                        coeffs_i( k ) +=
-                            inv_a_i( 0 * size_polynomial_basis + j ) *
-                            p_i( k * size_polynomial_basis + j ) * phi_i( k );
+                        coeff += inv_a_i( 0 * size_polynomial_basis + j ) *
+                                 p_i( k * size_polynomial_basis + j ) *
+                                 phi_i( k );
+                    coeffs_i( k ) = static_cast<Value>( coeff );
                 }
             } );
         return coeffs;
@@ -14,6 +14,14 @@
 
 #include <ArborX.hpp>
 #include <DTK_DBC.hpp>
+#include <DTK_DetailsCompressedRanks.hpp>
+#include <DTK_OperatorStatistics.hpp>
+#include <DTK_Tracing.hpp>
+
+#include <mpi.h>
+
+#include <type_traits>
+#include <vector>
 
 namespace DataTransferKit
 {
@@ -25,13 +33,25 @@ struct NearestNeighborOperatorImpl
 {
     using ExecutionSpace = typename DeviceType::execution_space;
 
+    // Contiguous view used to exchange values of a given type, whatever the
+    // layout of the input. The values may be exchanged as a narrower type
+    // than the one of the input.
+    template <typename View,
+              typename Value = typename View::non_const_value_type>
+    using PackedView = Kokkos::View<
+        typename std::conditional<View::rank == 1, Value *, Value **>::type,
+        DeviceType>;
+
     static Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType>
     makeNearestNeighborQueries(
-        Kokkos::View<Coordinate const **, DeviceType> target_points )
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points )
     {
         int const n_target_points = target_points.extent( 0 );
         Kokkos::View<ArborX::Nearest<ArborX::Point> *, DeviceType>
-            nearest_queries( "nearest", n_target_points );
+            nearest_queries(
+                Kokkos::ViewAllocateWithoutInitializing( "nearest" ),
+                n_target_points );
         Kokkos::parallel_for(
             DTK_MARK_REGION( "setup_queries" ),
             Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
@@ -44,38 +64,182 @@ struct NearestNeighborOperatorImpl
         return nearest_queries;
     }
 
-    template <typename View>
+    static Kokkos::View<ArborX::Within *, DeviceType> makeWithinQueries(
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        Coordinate radius )
+    {
+        int const n_target_points = target_points.extent( 0 );
+        Kokkos::View<ArborX::Within *, DeviceType> within_queries(
+            Kokkos::ViewAllocateWithoutInitializing( "within" ),
+            n_target_points );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "setup_within_queries" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
+            KOKKOS_LAMBDA( int i ) {
+                within_queries( i ) = ArborX::within(
+                    ArborX::Point{{target_points( i, 0 ), target_points( i, 1 ),
+                                   target_points( i, 2 )}},
+                    radius );
+            } );
+        Kokkos::fence();
+        return within_queries;
+    }
+
+    // Keep the closest of the candidates found for each target point, given
+    // their coordinates. The indices and the ranks of the candidates are
+    // replaced by those of the nearest neighbors of the target points that
+    // have at least one candidate. The ids of these target points are
+    // returned in increasing order, followed by -1 for the other ones.
+    static Kokkos::View<int *, DeviceType> selectNearestNeighbors(
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        Kokkos::View<int const *, DeviceType> offset,
+        Kokkos::View<Coordinate **, DeviceType> candidate_points,
+        Kokkos::View<int *, DeviceType> &indices,
+        Kokkos::View<int *, DeviceType> &ranks )
+    {
+        int const n_target_points = target_points.extent( 0 );
+        Kokkos::View<int *, DeviceType> nearest(
+            Kokkos::ViewAllocateWithoutInitializing( "nearest" ),
+            n_target_points );
+        Kokkos::View<int *, DeviceType> found_offset( "found_offset",
+                                                      n_target_points + 1 );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "select_nearest_candidates" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
+            KOKKOS_LAMBDA( int i ) {
+                int closest = -1;
+                Coordinate closest_distance = 0.;
+                for ( int j = offset( i ); j < offset( i + 1 ); ++j )
+                {
+                    Coordinate distance = 0.;
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        Coordinate const diff =
+                            candidate_points( j, d ) - target_points( i, d );
+                        distance += diff * diff;
+                    }
+                    if ( closest == -1 || distance < closest_distance )
+                    {
+                        closest = j;
+                        closest_distance = distance;
+                    }
+                }
+                nearest( i ) = closest;
+                found_offset( i ) = ( closest == -1 ) ? 0 : 1;
+            } );
+        Kokkos::fence();
+        ArborX::exclusivePrefixSum( found_offset );
+        int const n_found = ArborX::lastElement( found_offset );
+
+        Kokkos::View<int *, DeviceType> found_query_ids(
+            Kokkos::ViewAllocateWithoutInitializing( "found_query_ids" ),
+            n_target_points );
+        Kokkos::deep_copy( found_query_ids, -1 );
+        Kokkos::View<int *, DeviceType> found_indices(
+            Kokkos::ViewAllocateWithoutInitializing( "indices" ), n_found );
+        Kokkos::View<int *, DeviceType> found_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "ranks" ), n_found );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "store_nearest_neighbors" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
+            KOKKOS_LAMBDA( int i ) {
+                int const j = nearest( i );
+                if ( j == -1 )
+                    return;
+                int const k = found_offset( i );
+                found_query_ids( k ) = i;
+                found_indices( k ) = indices( j );
+                found_ranks( k ) = ranks( j );
+            } );
+        Kokkos::fence();
+
+        indices = found_indices;
+        ranks = found_ranks;
+        return found_query_ids;
+    }
+
+    // Write the values fetched for the target points that have a nearest
+    // neighbor. The other target points are assigned \p default_value if
+    // \p fill_missing is true, and are left untouched otherwise. The ids are
+    // not used, and may be empty, when all the target points were found.
+    template <typename Packed, typename View>
+    static void
+    setTargetValues( Kokkos::View<int const *, DeviceType> found_query_ids,
+                     Packed const &values, View target_values,
+                     bool fill_missing, double default_value,
+                     ExecutionSpace const &space = ExecutionSpace() )
+    {
+        int const n_found = values.extent( 0 );
+        int const n_target_points = target_values.extent( 0 );
+        if ( n_found == n_target_points )
+        {
+            // All the target points were found, in order.
+            Kokkos::deep_copy( space, target_values, values );
+            space.fence();
+            return;
+        }
+
+        if ( fill_missing )
+            Kokkos::parallel_for(
+                DTK_MARK_REGION( "set_default_target_values" ),
+                Kokkos::RangePolicy<ExecutionSpace>( space, 0,
+                                                     n_target_points ),
+                KOKKOS_LAMBDA( int i ) {
+                    for ( int j = 0; j < (int)target_values.dimension_1();
+                          ++j )
+                        target_values( i, j ) = default_value;
+                } );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "set_found_target_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( space, 0, n_found ),
+            KOKKOS_LAMBDA( int i ) {
+                for ( int j = 0; j < (int)target_values.dimension_1(); ++j )
+                    target_values( found_query_ids( i ), j ) = values( i, j );
+            } );
+        space.fence();
+    }
+
+    template <typename View, typename Packed>
     static void
     pullSourceValues( MPI_Comm comm, View source_values,
                       Kokkos::View<int *, DeviceType> &buffer_indices,
                       Kokkos::View<int *, DeviceType> &buffer_ranks,
-                      typename View::non_const_type &buffer_values )
+                      Packed &buffer_values,
+                      ExecutionSpace const &space = ExecutionSpace() )
     {
         static_assert(
             View::rank <= 2,
             "pullSourceValues() requires rank-1 or rank-2 view arguments" );
+        DTK_TRACE_REGION( "pull_source_values" );
         int const n_exports = buffer_indices.extent( 0 );
         ArborX::Details::Distributor distributor( comm );
         int const n_imports = distributor.createFromSends( buffer_ranks );
 
-        Kokkos::View<int *, DeviceType> export_target_indices( "target_indices",
-                                                               n_exports );
+        Kokkos::View<int *, DeviceType> export_target_indices(
+            Kokkos::ViewAllocateWithoutInitializing( "target_indices" ),
+            n_exports );
         ArborX::iota( export_target_indices );
-        Kokkos::View<int *, DeviceType> import_target_indices( "target_indices",
-                                                               n_imports );
+        Kokkos::View<int *, DeviceType> import_target_indices(
+            Kokkos::ViewAllocateWithoutInitializing( "target_indices" ),
+            n_imports );
         ArborX::Details::DistributedSearchTreeImpl<
             DeviceType>::sendAcrossNetwork( distributor, export_target_indices,
                                             import_target_indices );
 
         Kokkos::View<int *, DeviceType> export_source_indices = buffer_indices;
-        Kokkos::View<int *, DeviceType> import_source_indices( "source_indices",
-                                                               n_imports );
+        Kokkos::View<int *, DeviceType> import_source_indices(
+            Kokkos::ViewAllocateWithoutInitializing( "source_indices" ),
+            n_imports );
         ArborX::Details::DistributedSearchTreeImpl<
             DeviceType>::sendAcrossNetwork( distributor, export_source_indices,
                                             import_source_indices );
 
-        Kokkos::View<int *, DeviceType> export_ranks( "ranks", n_exports );
-        Kokkos::View<int *, DeviceType> import_ranks( "ranks", n_imports );
+        Kokkos::View<int *, DeviceType> export_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "ranks" ), n_exports );
+        Kokkos::View<int *, DeviceType> import_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "ranks" ), n_imports );
         int comm_rank;
         MPI_Comm_rank( comm, &comm_rank );
         Kokkos::deep_copy( export_ranks, comm_rank );
@@ -85,17 +249,19 @@ struct NearestNeighborOperatorImpl
 
         buffer_indices = import_target_indices;
         buffer_ranks = import_ranks;
-        Kokkos::realloc( buffer_values, n_imports,
-                         source_values.dimension_1() );
+        using Value = typename Packed::non_const_value_type;
+        buffer_values = Packed(
+            Kokkos::ViewAllocateWithoutInitializing( buffer_values.label() ),
+            n_imports, source_values.dimension_1() );
         Kokkos::parallel_for(
             DTK_MARK_REGION( "get_source_values" ),
-            Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+            Kokkos::RangePolicy<ExecutionSpace>( space, 0, n_imports ),
             KOKKOS_LAMBDA( int i ) {
                 for ( int j = 0; j < (int)source_values.dimension_1(); ++j )
-                    buffer_values( i, j ) =
-                        source_values( import_source_indices( i ), j );
+                    buffer_values( i, j ) = static_cast<Value>(
+                        source_values( import_source_indices( i ), j ) );
             } );
-        Kokkos::fence();
+        space.fence();
     }
 
     template <typename View>
@@ -103,66 +269,180 @@ struct NearestNeighborOperatorImpl
     pushTargetValues( MPI_Comm comm,
                       Kokkos::View<int *, DeviceType> const &buffer_indices,
                       Kokkos::View<int *, DeviceType> const &buffer_ranks,
-                      View const &buffer_values, View target_values )
+                      View const &buffer_values, View target_values,
+                      ExecutionSpace const &space = ExecutionSpace() )
     {
         static_assert(
             View::rank <= 2,
             "pushTargetValues() requires rank-1 or rank-2 view arguments" );
+        DTK_TRACE_REGION( "push_target_values" );
         ArborX::Details::Distributor distributor( comm );
         int const n_imports = distributor.createFromSends( buffer_ranks );
 
         View export_source_values = buffer_values;
-        View import_source_values( "source_values", n_imports,
-                                   target_values.dimension_1() );
+        View import_source_values(
+            Kokkos::ViewAllocateWithoutInitializing( "source_values" ),
+            n_imports, target_values.dimension_1() );
         ArborX::Details::DistributedSearchTreeImpl<
             DeviceType>::sendAcrossNetwork( distributor, export_source_values,
                                             import_source_values );
 
         Kokkos::View<int *, DeviceType> export_target_indices = buffer_indices;
-        Kokkos::View<int *, DeviceType> import_target_indices( "target_indices",
-                                                               n_imports );
+        Kokkos::View<int *, DeviceType> import_target_indices(
+            Kokkos::ViewAllocateWithoutInitializing( "target_indices" ),
+            n_imports );
         ArborX::Details::DistributedSearchTreeImpl<
             DeviceType>::sendAcrossNetwork( distributor, export_target_indices,
                                             import_target_indices );
 
         Kokkos::parallel_for(
             DTK_MARK_REGION( "set_target_values" ),
-            Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+            Kokkos::RangePolicy<ExecutionSpace>( space, 0, n_imports ),
             KOKKOS_LAMBDA( int i ) {
                 for ( int j = 0; j < (int)target_values.dimension_1(); ++j )
                     target_values( import_target_indices( i ), j ) =
                         import_source_values( i, j );
             } );
+        space.fence();
+    }
+
+    static FetchPattern
+    makeFetchPattern( MPI_Comm comm,
+                      Kokkos::View<int const *, DeviceType> ranks )
+    {
+        DTK_TRACE_REGION( "make_fetch_pattern" );
+        int comm_size;
+        MPI_Comm_size( comm, &comm_size );
+        int const n_exports = ranks.extent( 0 );
+        Kokkos::View<int *, DeviceType> counts( "counts", comm_size );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "count_requested_values" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_exports ),
+            KOKKOS_LAMBDA( int i ) {
+                Kokkos::atomic_increment( &counts( ranks( i ) ) );
+            } );
         Kokkos::fence();
+        auto counts_host = Kokkos::create_mirror_view( counts );
+        Kokkos::deep_copy( counts_host, counts );
+
+        FetchPattern pattern;
+        pattern.n_exports = n_exports;
+        std::vector<int> requested( comm_size );
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            requested[r] = ( counts_host( r ) > 0 ) ? 1 : 0;
+            pattern.n_destinations += requested[r];
+        }
+
+        // The number of values requested from a rank and the number of ranks
+        // requesting them are the sums over all the ranks.
+        int n_imports;
+        MPI_Reduce_scatter_block( counts_host.data(), &n_imports, 1, MPI_INT,
+                                  MPI_SUM, comm );
+        pattern.n_imports = n_imports;
+        int n_sources;
+        MPI_Reduce_scatter_block( requested.data(), &n_sources, 1, MPI_INT,
+                                  MPI_SUM, comm );
+        pattern.n_sources = n_sources;
+
+        return pattern;
     }
 
-    template <typename View>
-    static typename View::non_const_type
-    fetch( MPI_Comm comm, Kokkos::View<int const *, DeviceType> ranks,
-           Kokkos::View<int const *, DeviceType> indices, View values )
+    // Record the communication of a call to fetch() that exchanges values of
+    // \p value_size bytes each.
+    static void recordFetch( FetchPattern const &pattern,
+                             std::size_t value_size,
+                             OperatorStatistics &statistics )
+    {
+        // The target indices, the source indices, and the ranks are sent to
+        // the owners of the source values in three messages. They send the
+        // values and the target indices back in two messages.
+        std::size_t const request_size = 3 * sizeof( int );
+        std::size_t const reply_size = value_size + sizeof( int );
+        statistics.bytes_sent += pattern.n_exports * request_size +
+                                 pattern.n_imports * reply_size;
+        statistics.bytes_received += pattern.n_imports * request_size +
+                                     pattern.n_exports * reply_size;
+        statistics.messages_sent +=
+            3 * pattern.n_destinations + 2 * pattern.n_sources;
+        statistics.messages_received +=
+            3 * pattern.n_sources + 2 * pattern.n_destinations;
+        statistics.recordTemporaryMemory(
+            ( pattern.n_exports + pattern.n_imports ) *
+            ( request_size + reply_size ) );
+    }
+
+    template <typename Ranks, typename View>
+    static PackedView<View>
+    fetch( MPI_Comm comm, Ranks const &ranks,
+           Kokkos::View<int const *, DeviceType> indices, View values,
+           ExecutionSpace const &space = ExecutionSpace() )
+    {
+        return fetchAs<typename View::non_const_value_type>(
+            comm, ranks, indices, values, space );
+    }
+
+    // Same as fetch() but the values are converted to Value by their owner
+    // before they are sent. Sending double values as float halves the size of
+    // the messages.
+    template <typename Value, typename View>
+    static PackedView<View, Value>
+    fetchAs( MPI_Comm comm, Kokkos::View<int const *, DeviceType> ranks,
+             Kokkos::View<int const *, DeviceType> indices, View values,
+             ExecutionSpace const &space = ExecutionSpace() )
     {
         DTK_REQUIRE( ranks.extent( 0 ) == indices.extent( 0 ) );
 
         Kokkos::View<int *, DeviceType> buffer_ranks =
             Kokkos::create_mirror( DeviceType(), ranks );
-        Kokkos::deep_copy( buffer_ranks, ranks );
+        Kokkos::deep_copy( space, buffer_ranks, ranks );
+
+        return exchange<Value>( comm, buffer_ranks, indices, values, space );
+    }
+
+    // Same as above with the compressed ranks stored by the operators. They
+    // are decoded directly into the buffer the ranks are copied to otherwise.
+    template <typename Value, typename View>
+    static PackedView<View, Value>
+    fetchAs( MPI_Comm comm, CompressedRanks<DeviceType> const &ranks,
+             Kokkos::View<int const *, DeviceType> indices, View values,
+             ExecutionSpace const &space = ExecutionSpace() )
+    {
+        DTK_REQUIRE( ranks.size() == indices.extent( 0 ) );
+
+        return exchange<Value>( comm, ranks.decompress( space ), indices,
+                                values, space );
+    }
+
+    // Send the requests to the owners of the values and get the values back.
+    // The buffer of ranks is overwritten.
+    template <typename Value, typename View>
+    static PackedView<View, Value>
+    exchange( MPI_Comm comm, Kokkos::View<int *, DeviceType> buffer_ranks,
+              Kokkos::View<int const *, DeviceType> indices, View values,
+              ExecutionSpace const &space = ExecutionSpace() )
+    {
+        int const n_requests = indices.extent( 0 );
 
         Kokkos::View<int *, DeviceType> buffer_indices =
             Kokkos::create_mirror( DeviceType(), indices );
-        Kokkos::deep_copy( buffer_indices, indices );
+        Kokkos::deep_copy( space, buffer_indices, indices );
+        space.fence();
 
-        typename View::non_const_type buffer_values( values.label() );
+        PackedView<View, Value> buffer_values( values.label() );
 
         pullSourceValues( comm, values, buffer_indices, buffer_ranks,
-                          buffer_values );
+                          buffer_values, space );
 
-        typename View::non_const_type values_out(
-            values.label(), ranks.extent( 0 ), values.extent( 1 ) );
+        // Every requested value is sent back.
+        PackedView<View, Value> values_out(
+            Kokkos::ViewAllocateWithoutInitializing( values.label() ),
+            n_requests, values.extent( 1 ) );
 
         pushTargetValues( comm, buffer_indices, buffer_ranks, buffer_values,
-                          values_out );
+                          values_out, space );
 
-        DTK_ENSURE( ( values_out.extent( 0 ) == ranks.extent( 0 ) ) &&
+        DTK_ENSURE( ( (int)values_out.extent( 0 ) == n_requests ) &&
                     ( values_out.extent( 1 ) == values.extent( 1 ) ) );
 
         return values_out;
@@ -18,6 +18,7 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 
 namespace DataTransferKit
 {
@@ -194,24 +195,25 @@ struct SVDFunctor
         // different sizes. However, it is unclear what the best batched
         // approach is. It could be that instead the matrices should be
         // pre-sorted by size.
-        auto A = Kokkos::subview(
-            _As, Kokkos::make_pair( matrix_id * _n * _n,
-                                    ( matrix_id + 1 ) * _n * _n ) );
-        auto pseudoA = Kokkos::subview(
-            _pseudoAs, Kokkos::make_pair( matrix_id * _n * _n,
-                                          ( matrix_id + 1 ) * _n * _n ) );
-
-        auto E = Kokkos::subview(
-            _aux, Kokkos::ALL(),
-            Kokkos::make_pair( 3 * matrix_id * _n, 3 * matrix_id * _n + _n ) );
-        auto U =
-            Kokkos::subview( _aux, Kokkos::ALL(),
-                             Kokkos::make_pair( 3 * matrix_id * _n + _n,
-                                                3 * matrix_id * _n + 2 * _n ) );
-        auto V =
+        // The position of the matrix in the batch is computed in 64 bits
+        // because it overflows an int for large batches.
+        std::size_t const n = _n;
+        std::size_t const begin = matrix_id * n * n;
+        std::size_t const end = begin + n * n;
+        auto A = Kokkos::subview( _As, Kokkos::make_pair( begin, end ) );
+        auto pseudoA =
+            Kokkos::subview( _pseudoAs, Kokkos::make_pair( begin, end ) );
+
+        std::size_t const aux_begin = 3 * n * matrix_id;
+        auto E =
             Kokkos::subview( _aux, Kokkos::ALL(),
-                             Kokkos::make_pair( 3 * matrix_id * _n + 2 * _n,
-                                                3 * matrix_id * _n + 3 * _n ) );
+                             Kokkos::make_pair( aux_begin, aux_begin + n ) );
+        auto U = Kokkos::subview(
+            _aux, Kokkos::ALL(),
+            Kokkos::make_pair( aux_begin + n, aux_begin + 2 * n ) );
+        auto V = Kokkos::subview(
+            _aux, Kokkos::ALL(),
+            Kokkos::make_pair( aux_begin + 2 * n, aux_begin + 3 * n ) );
 
         for ( int i = 0; i < _n; i++ )
             for ( int j = 0; j < _n; j++ )
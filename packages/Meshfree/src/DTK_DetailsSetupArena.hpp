@@ -0,0 +1,115 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_DETAILS_SETUP_ARENA_HPP
+#define DTK_DETAILS_SETUP_ARENA_HPP
+
+#include <DTK_DBC.hpp>
+
+#include <Kokkos_Core.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+namespace DataTransferKit
+{
+namespace Details
+{
+
+// Stack allocator for the temporary views of the setup of an operator. The
+// views are carved out of a single buffer allocated once without
+// initialization, instead of going through the allocator of the memory space
+// (cudaMalloc for instance) for each of them. The views are uninitialized and
+// do not own their memory: they must not outlive the arena. When the buffer is
+// exhausted, the views are allocated on their own.
+template <typename DeviceType>
+class SetupArena
+{
+  public:
+    // Views start on a cache line.
+    static std::size_t constexpr alignment = 64;
+
+    // Number of bytes of the arena taken by a view of the given extents.
+    template <typename DataType, typename... Extents>
+    static std::size_t requiredSize( Extents... extents )
+    {
+        std::size_t const size =
+            Kokkos::View<DataType, DeviceType>::required_allocation_size(
+                extents... );
+        return ( size + alignment - 1 ) / alignment * alignment;
+    }
+
+    explicit SetupArena( std::size_t capacity )
+        : _buffer( Kokkos::ViewAllocateWithoutInitializing( "setup_arena" ),
+                   capacity )
+    {
+    }
+
+    SetupArena( SetupArena const & ) = delete;
+    SetupArena &operator=( SetupArena const & ) = delete;
+
+    template <typename DataType, typename... Extents>
+    Kokkos::View<DataType, DeviceType> allocate( std::string const &label,
+                                                 Extents... extents )
+    {
+        std::size_t const size = requiredSize<DataType>( extents... );
+        if ( _size + size > capacity() )
+            return Kokkos::View<DataType, DeviceType>(
+                Kokkos::ViewAllocateWithoutInitializing( label ), extents... );
+
+        using Pointer =
+            typename Kokkos::View<DataType, DeviceType>::pointer_type;
+        Kokkos::View<DataType, DeviceType, Kokkos::MemoryUnmanaged> view(
+            reinterpret_cast<Pointer>( _buffer.data() + _size ), extents... );
+        _size += size;
+        _high_water_mark = std::max( _high_water_mark, _size );
+        return view;
+    }
+
+    // Release the views allocated since size() returned mark. The kernels
+    // using them must have completed.
+    void rewind( std::size_t mark = 0 )
+    {
+        DTK_REQUIRE( mark <= _size );
+        _size = mark;
+    }
+
+    // Number of bytes in use.
+    std::size_t size() const { return _size; }
+
+    std::size_t capacity() const { return _buffer.extent( 0 ); }
+
+    // Largest number of bytes in use at once.
+    std::size_t highWaterMark() const { return _high_water_mark; }
+
+  private:
+    Kokkos::View<char *, DeviceType> _buffer;
+    std::size_t _size = 0;
+    std::size_t _high_water_mark = 0;
+};
+
+// Uninitialized view taken from the arena if there is one.
+template <typename DataType, typename DeviceType, typename... Extents>
+Kokkos::View<DataType, DeviceType>
+allocateTemporary( SetupArena<DeviceType> *arena, std::string const &label,
+                   Extents... extents )
+{
+    if ( arena != nullptr )
+        return arena->template allocate<DataType>( label, extents... );
+    return Kokkos::View<DataType, DeviceType>(
+        Kokkos::ViewAllocateWithoutInitializing( label ), extents... );
+}
+
+} // namespace Details
+} // namespace DataTransferKit
+
+#endif
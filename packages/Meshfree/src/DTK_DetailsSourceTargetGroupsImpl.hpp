@@ -0,0 +1,402 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_DETAILS_SOURCE_TARGET_GROUPS_IMPL_HPP
+#define DTK_DETAILS_SOURCE_TARGET_GROUPS_IMPL_HPP
+
+#include <ArborX.hpp>
+#include <ArborX_DetailsKokkosExt.hpp> // ArithmeticTraits
+#include <DTK_DBC.hpp>
+#include <DTK_OperatorStatistics.hpp>
+#include <DTK_PointCloudOperator.hpp> // PointCloudRole
+
+#include <mpi.h>
+
+#include <vector>
+
+namespace DataTransferKit
+{
+namespace Details
+{
+
+template <typename DeviceType>
+struct SourceTargetGroupsImpl
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+    // Search the source points for the queries. The results are returned to
+    // the ranks that issued the queries and the ranks they hold are ranks of
+    // comm, so that they can be passed to fetch() as they are.
+    //
+    // When the source and the target live on disjoint groups of ranks, the
+    // search tree is only built over the source group. The queries of each
+    // target rank are forwarded to a single source rank which performs the
+    // search on their behalf.
+    //
+    // With SearchPartition::Source, the query of each target point is instead
+    // forwarded to a rank whose source points surround it, see
+    // assignToSourceRanks(), whatever the roles of the ranks.
+    //
+    // The time spent building the search tree and answering the queries is
+    // recorded in the "tree_build" and "query" phases of \p statistics, and
+    // the time spent assigning the queries to source ranks in the
+    // "repartition" phase.
+    template <typename Query>
+    static void
+    query( MPI_Comm comm, PointCloudRole role, SearchPartition partition,
+           Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+               source_points,
+           Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+               target_points,
+           Kokkos::View<Query *, DeviceType> queries,
+           Kokkos::View<int *, DeviceType> &indices,
+           Kokkos::View<int *, DeviceType> &offset,
+           Kokkos::View<int *, DeviceType> &ranks,
+           OperatorStatistics &statistics )
+    {
+        DTK_REQUIRE( queries.extent( 0 ) == target_points.extent( 0 ) );
+
+        bool const repartition = ( partition == SearchPartition::Source );
+        if ( role == PointCloudRole::SourceAndTarget && !repartition )
+        {
+            ScopedPhaseTimer<ExecutionSpace> tree_build_timer( statistics,
+                                                               "tree_build" );
+            ArborX::DistributedSearchTree<DeviceType> search_tree(
+                comm, source_points );
+            tree_build_timer.stop();
+            DTK_CHECK( !search_tree.empty() );
+            ScopedPhaseTimer<ExecutionSpace> query_timer( statistics,
+                                                          "query" );
+            search_tree.query( queries, indices, offset, ranks );
+            return;
+        }
+
+        Kokkos::View<int *, DeviceType> export_ranks;
+        if ( repartition )
+        {
+            ScopedPhaseTimer<ExecutionSpace> repartition_timer(
+                statistics, "repartition" );
+            export_ranks =
+                assignToSourceRanks( comm, source_points, target_points );
+        }
+
+        ScopedPhaseTimer<ExecutionSpace> forward_timer( statistics, "query" );
+
+        bool const is_source = ( role != PointCloudRole::Target );
+        DTK_REQUIRE( role != PointCloudRole::Source ||
+                     queries.extent( 0 ) == 0 );
+        DTK_REQUIRE( role != PointCloudRole::Target ||
+                     source_points.extent( 0 ) == 0 );
+
+        int comm_rank;
+        MPI_Comm_rank( comm, &comm_rank );
+        int comm_size;
+        MPI_Comm_size( comm, &comm_size );
+
+        // Find out which ranks of comm belong to the source group. They are
+        // ordered by their rank in the group.
+        int const in_source_group = is_source ? 1 : 0;
+        std::vector<int> in_source_groups( comm_size );
+        MPI_Allgather( &in_source_group, 1, MPI_INT, in_source_groups.data(),
+                       1, MPI_INT, comm );
+        std::vector<int> source_ranks;
+        int group_rank = 0;
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            if ( in_source_groups[r] )
+                source_ranks.push_back( r );
+            if ( r < comm_rank && in_source_groups[r] == in_source_group )
+                ++group_rank;
+        }
+        int const n_source_ranks = source_ranks.size();
+        DTK_INSIST( n_source_ranks > 0 );
+
+        // Forward the queries of the target rank to a source rank, along with
+        // where they come from.
+        int const n_queries = queries.extent( 0 );
+        if ( !repartition )
+        {
+            export_ranks = Kokkos::View<int *, DeviceType>(
+                Kokkos::ViewAllocateWithoutInitializing( "ranks" ),
+                n_queries );
+            Kokkos::deep_copy( export_ranks,
+                               source_ranks[group_rank % n_source_ranks] );
+        }
+        ArborX::Details::Distributor forward_distributor( comm );
+        int const n_imports =
+            forward_distributor.createFromSends( export_ranks );
+
+        Kokkos::View<Query *, DeviceType> import_queries(
+            Kokkos::ViewAllocateWithoutInitializing( "queries" ), n_imports );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( forward_distributor, queries,
+                                            import_queries );
+
+        Kokkos::View<int *, DeviceType> export_query_ids(
+            Kokkos::ViewAllocateWithoutInitializing( "query_ids" ), n_queries );
+        ArborX::iota( export_query_ids );
+        Kokkos::View<int *, DeviceType> import_query_ids(
+            Kokkos::ViewAllocateWithoutInitializing( "query_ids" ), n_imports );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( forward_distributor,
+                                            export_query_ids,
+                                            import_query_ids );
+
+        Kokkos::View<int *, DeviceType> export_origins(
+            Kokkos::ViewAllocateWithoutInitializing( "origins" ), n_queries );
+        Kokkos::deep_copy( export_origins, comm_rank );
+        Kokkos::View<int *, DeviceType> import_origins(
+            Kokkos::ViewAllocateWithoutInitializing( "origins" ), n_imports );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( forward_distributor, export_origins,
+                                            import_origins );
+
+        // Perform the search over the source group only.
+        MPI_Comm group_comm;
+        MPI_Comm_split( comm, in_source_group, comm_rank, &group_comm );
+        forward_timer.stop();
+        Kokkos::View<int *, DeviceType> found_indices( "indices" );
+        Kokkos::View<int *, DeviceType> found_offset( "offset", n_imports + 1 );
+        Kokkos::View<int *, DeviceType> found_ranks( "ranks" );
+        if ( is_source )
+        {
+            ScopedPhaseTimer<ExecutionSpace> tree_build_timer( statistics,
+                                                               "tree_build" );
+            ArborX::DistributedSearchTree<DeviceType> search_tree(
+                group_comm, source_points );
+            tree_build_timer.stop();
+            DTK_CHECK( !search_tree.empty() );
+            ScopedPhaseTimer<ExecutionSpace> query_timer( statistics,
+                                                          "query" );
+            search_tree.query( import_queries, found_indices, found_offset,
+                               found_ranks );
+        }
+        MPI_Comm_free( &group_comm );
+        ScopedPhaseTimer<ExecutionSpace> return_timer( statistics, "query" );
+
+        // Send the results back to the ranks that issued the queries. Their
+        // position among the results of the query is kept so that the order
+        // of the results does not depend on the order of the messages.
+        Kokkos::View<int *, DeviceType> group_to_comm_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "source_ranks" ),
+            n_source_ranks );
+        Kokkos::deep_copy(
+            group_to_comm_ranks,
+            Kokkos::View<int *, Kokkos::HostSpace, Kokkos::MemoryUnmanaged>(
+                source_ranks.data(), n_source_ranks ) );
+
+        int const n_results = ArborX::lastElement( found_offset );
+        Kokkos::View<int *, DeviceType> return_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "ranks" ), n_results );
+        Kokkos::View<int *, DeviceType> export_ids(
+            Kokkos::ViewAllocateWithoutInitializing( "query_ids" ), n_results );
+        Kokkos::View<int *, DeviceType> export_positions(
+            Kokkos::ViewAllocateWithoutInitializing( "positions" ), n_results );
+        Kokkos::View<int *, DeviceType> export_indices(
+            Kokkos::ViewAllocateWithoutInitializing( "indices" ), n_results );
+        Kokkos::View<int *, DeviceType> export_source_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "source_ranks" ),
+            n_results );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "setup_returned_results" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_imports ),
+            KOKKOS_LAMBDA( int i ) {
+                for ( int j = found_offset( i ); j < found_offset( i + 1 );
+                      ++j )
+                {
+                    return_ranks( j ) = import_origins( i );
+                    export_ids( j ) = import_query_ids( i );
+                    export_positions( j ) = j - found_offset( i );
+                    export_indices( j ) = found_indices( j );
+                    export_source_ranks( j ) =
+                        group_to_comm_ranks( found_ranks( j ) );
+                }
+            } );
+        Kokkos::fence();
+
+        ArborX::Details::Distributor backward_distributor( comm );
+        int const n_returns =
+            backward_distributor.createFromSends( return_ranks );
+
+        Kokkos::View<int *, DeviceType> import_ids(
+            Kokkos::ViewAllocateWithoutInitializing( "query_ids" ), n_returns );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( backward_distributor, export_ids,
+                                            import_ids );
+        Kokkos::View<int *, DeviceType> import_positions(
+            Kokkos::ViewAllocateWithoutInitializing( "positions" ), n_returns );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( backward_distributor,
+                                            export_positions,
+                                            import_positions );
+        Kokkos::View<int *, DeviceType> import_indices(
+            Kokkos::ViewAllocateWithoutInitializing( "indices" ), n_returns );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( backward_distributor,
+                                            export_indices, import_indices );
+        Kokkos::View<int *, DeviceType> import_source_ranks(
+            Kokkos::ViewAllocateWithoutInitializing( "source_ranks" ),
+            n_returns );
+        ArborX::Details::DistributedSearchTreeImpl<
+            DeviceType>::sendAcrossNetwork( backward_distributor,
+                                            export_source_ranks,
+                                            import_source_ranks );
+
+        // Assemble the results in the order of the queries.
+        offset = Kokkos::View<int *, DeviceType>( "offset", n_queries + 1 );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "count_returned_results" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_returns ),
+            KOKKOS_LAMBDA( int k ) {
+                Kokkos::atomic_increment( &offset( import_ids( k ) ) );
+            } );
+        Kokkos::fence();
+        ArborX::exclusivePrefixSum( offset );
+
+        indices = Kokkos::View<int *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "indices" ), n_returns );
+        ranks = Kokkos::View<int *, DeviceType>(
+            Kokkos::ViewAllocateWithoutInitializing( "ranks" ), n_returns );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "store_returned_results" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_returns ),
+            KOKKOS_LAMBDA( int k ) {
+                int const pos =
+                    offset( import_ids( k ) ) + import_positions( k );
+                indices( pos ) = import_indices( k );
+                ranks( pos ) = import_source_ranks( k );
+            } );
+        Kokkos::fence();
+    }
+
+    // Rank of comm each target point is sent to for the search. The bounding
+    // boxes of the source points of all the ranks are gathered. A point that
+    // falls into the boxes of several ranks is sent to one of them, chosen
+    // from its index so that the points of overlapping boxes are spread over
+    // their ranks. A point outside all the boxes is sent to the rank of the
+    // closest one. Ranks without source points never receive any.
+    static Kokkos::View<int *, DeviceType> assignToSourceRanks(
+        MPI_Comm comm,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points )
+    {
+        int comm_size;
+        MPI_Comm_size( comm, &comm_size );
+
+        // The box of a rank without source points is empty: its lower corner
+        // is above its upper corner.
+        int const n_source_points = source_points.extent( 0 );
+        std::vector<Coordinate> local_box( 6 );
+        for ( int d = 0; d < 3; ++d )
+        {
+            Kokkos::MinMaxScalar<Coordinate> min_max;
+            Kokkos::parallel_reduce(
+                DTK_MARK_REGION( "compute_source_bounding_box" ),
+                Kokkos::RangePolicy<ExecutionSpace>( 0, n_source_points ),
+                KOKKOS_LAMBDA( int i,
+                               Kokkos::MinMaxScalar<Coordinate> &update ) {
+                    Coordinate const x = source_points( i, d );
+                    if ( x < update.min_val )
+                        update.min_val = x;
+                    if ( x > update.max_val )
+                        update.max_val = x;
+                },
+                Kokkos::MinMax<Coordinate>( min_max ) );
+            local_box[d] = min_max.min_val;
+            local_box[3 + d] = min_max.max_val;
+        }
+        std::vector<Coordinate> boxes( 6 * comm_size );
+        MPI_Allgather( local_box.data(), 6, MPI_DOUBLE, boxes.data(), 6,
+                       MPI_DOUBLE, comm );
+
+        Kokkos::View<Coordinate **, Kokkos::LayoutRight, DeviceType>
+            source_boxes( Kokkos::ViewAllocateWithoutInitializing( "boxes" ),
+                          comm_size, 6 );
+        Kokkos::deep_copy(
+            source_boxes,
+            Kokkos::View<Coordinate **, Kokkos::LayoutRight, Kokkos::HostSpace,
+                         Kokkos::MemoryUnmanaged>( boxes.data(), comm_size,
+                                                   6 ) );
+
+        int const n_target_points = target_points.extent( 0 );
+        Kokkos::View<int *, DeviceType> destinations(
+            Kokkos::ViewAllocateWithoutInitializing( "ranks" ),
+            n_target_points );
+        Kokkos::parallel_for(
+            DTK_MARK_REGION( "assign_targets_to_source_ranks" ),
+            Kokkos::RangePolicy<ExecutionSpace>( 0, n_target_points ),
+            KOKKOS_LAMBDA( int i ) {
+                // Count the boxes the point falls into and find the closest
+                // box.
+                int n_containing = 0;
+                int closest = 0;
+                Coordinate closest_distance =
+                    KokkosExt::ArithmeticTraits::infinity<Coordinate>::value;
+                for ( int r = 0; r < comm_size; ++r )
+                {
+                    if ( source_boxes( r, 0 ) > source_boxes( r, 3 ) )
+                        continue;
+                    Coordinate distance = 0.;
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        Coordinate const x = target_points( i, d );
+                        Coordinate gap = 0.;
+                        if ( x < source_boxes( r, d ) )
+                            gap = source_boxes( r, d ) - x;
+                        else if ( x > source_boxes( r, 3 + d ) )
+                            gap = x - source_boxes( r, 3 + d );
+                        distance += gap * gap;
+                    }
+                    if ( distance == 0. )
+                        ++n_containing;
+                    if ( distance < closest_distance )
+                    {
+                        closest_distance = distance;
+                        closest = r;
+                    }
+                }
+                destinations( i ) = closest;
+                if ( n_containing < 2 )
+                    return;
+
+                // Pick one of the boxes the point falls into.
+                int k = i % n_containing;
+                for ( int r = 0; r < comm_size; ++r )
+                {
+                    if ( source_boxes( r, 0 ) > source_boxes( r, 3 ) )
+                        continue;
+                    bool inside = true;
+                    for ( int d = 0; d < 3; ++d )
+                    {
+                        Coordinate const x = target_points( i, d );
+                        if ( x < source_boxes( r, d ) ||
+                             x > source_boxes( r, 3 + d ) )
+                            inside = false;
+                    }
+                    if ( inside && k-- == 0 )
+                    {
+                        destinations( i ) = r;
+                        break;
+                    }
+                }
+            } );
+        Kokkos::fence();
+
+        return destinations;
+    }
+};
+
+} // namespace Details
+} // namespace DataTransferKit
+
+#endif
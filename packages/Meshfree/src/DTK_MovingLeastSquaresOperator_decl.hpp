@@ -14,6 +14,7 @@
 
 #include <DTK_CompactlySupportedRadialBasisFunctions.hpp>
 #include <DTK_MultivariatePolynomialBasis.hpp>
+#include <DTK_DetailsCompressedRanks.hpp>
 #include <DTK_PointCloudOperator.hpp>
 
 #include <mpi.h>
@@ -21,30 +22,61 @@
 namespace DataTransferKit
 {
 
+// The polynomial coefficients are stored, and the source values are sent to
+// the targets, as StorageType. The setup is computed in double and so are
+// the target values. With float, the coefficients held by the operator and
+// the values exchanged by each application take half the memory, at the cost
+// of rounding them to about seven significant digits.
 template <typename DeviceType,
           typename CompactlySupportedRadialBasisFunction = Wendland<0>,
-          typename PolynomialBasis = MultivariatePolynomialBasis<Linear, 3>>
+          typename PolynomialBasis = MultivariatePolynomialBasis<Linear, 3>,
+          typename StorageType = double>
 class MovingLeastSquaresOperator : public PointCloudOperator<DeviceType>
 {
     using ExecutionSpace = typename DeviceType::execution_space;
 
   public:
+    // See NearestNeighborOperator for the execution space instance.
     MovingLeastSquaresOperator(
         MPI_Comm comm,
-        Kokkos::View<Coordinate const **, DeviceType> source_points,
-        Kokkos::View<Coordinate const **, DeviceType> target_points );
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        ExecutionSpace const &space = ExecutionSpace() );
 
-    void
-    apply( Kokkos::View<double const *, DeviceType> source_values,
-           Kokkos::View<double *, DeviceType> target_values ) const override;
+    // See NearestNeighborOperator for source and target points living on
+    // disjoint sets of ranks and for the partition of the search.
+    MovingLeastSquaresOperator(
+        MPI_Comm comm, PointCloudRole role,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        ExecutionSpace const &space = ExecutionSpace(),
+        SearchPartition partition = SearchPartition::Target );
+
+    void apply(
+        Kokkos::View<double const *, Kokkos::LayoutStride, DeviceType>
+            source_values,
+        Kokkos::View<double *, Kokkos::LayoutStride, DeviceType> target_values )
+        const override;
+
+    void applyMany(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            source_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            target_values ) const override;
 
   private:
     MPI_Comm _comm;
+    ExecutionSpace _space;
     unsigned int const _n_source_points;
     Kokkos::View<int *, DeviceType> _offset;
-    Kokkos::View<int *, DeviceType> _ranks;
+    Details::CompressedRanks<DeviceType> _ranks;
     Kokkos::View<int *, DeviceType> _indices;
-    Kokkos::View<double *, DeviceType> _coeffs;
+    Details::FetchPattern _fetch_pattern;
+    Kokkos::View<StorageType *, DeviceType> _coeffs;
 };
 
 } // end namespace DataTransferKit
@@ -16,22 +16,45 @@
 #include <DTK_DBC.hpp>
 #include <DTK_DetailsMovingLeastSquaresOperatorImpl.hpp>
 #include <DTK_DetailsNearestNeighborOperatorImpl.hpp> // fetch
+#include <DTK_DetailsSourceTargetGroupsImpl.hpp>
+
+#include <cstddef>
+#include <limits>
 
 namespace DataTransferKit
 {
 
 template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
-          typename PolynomialBasis>
+          typename PolynomialBasis, typename StorageType>
 MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
-                           PolynomialBasis>::
+                           PolynomialBasis, StorageType>::
     MovingLeastSquaresOperator(
         MPI_Comm comm,
-        Kokkos::View<Coordinate const **, DeviceType> source_points,
-        Kokkos::View<Coordinate const **, DeviceType> target_points )
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        ExecutionSpace const &space )
+    : MovingLeastSquaresOperator( comm, PointCloudRole::SourceAndTarget,
+                                  source_points, target_points, space )
+{
+}
+
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename StorageType>
+MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
+                           PolynomialBasis, StorageType>::
+    MovingLeastSquaresOperator(
+        MPI_Comm comm, PointCloudRole role,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        ExecutionSpace const &space, SearchPartition partition )
     : _comm( comm )
+    , _space( space )
     , _n_source_points( source_points.extent( 0 ) )
     , _offset( "offset" )
-    , _ranks( "ranks" )
     , _indices( "indices" )
     , _coeffs( "polynomial_coefficients" )
 {
@@ -39,11 +62,12 @@ MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
                  target_points.extent_int( 1 ) );
     // FIXME for now let's assume 3D
     DTK_REQUIRE( source_points.extent_int( 1 ) == 3 );
-
-    // Build distributed search tree over the source points.
-    ArborX::DistributedSearchTree<DeviceType> search_tree( _comm,
-                                                           source_points );
-    DTK_CHECK( !search_tree.empty() );
+    // The neighbors of the targets are indexed with the 32-bit offsets
+    // returned by the search. The Vandermonde and moment matrices use 64-bit
+    // indices and may be larger.
+    DTK_REQUIRE( target_points.extent( 0 ) <=
+                 static_cast<std::size_t>( std::numeric_limits<int>::max() /
+                                           PolynomialBasis::size ) );
 
     // For each target point, query the n_neighbors points closest to the
     // target.
@@ -51,26 +75,59 @@ MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
         Details::MovingLeastSquaresOperatorImpl<DeviceType>::makeKNNQueries(
             target_points, PolynomialBasis::size );
 
-    // Perform the actual search.
-    search_tree.query( queries, _indices, _offset, _ranks );
+    // Perform the actual search over a distributed search tree built on the
+    // source points.
+    Kokkos::View<int *, DeviceType> ranks( "ranks" );
+    Details::SourceTargetGroupsImpl<DeviceType>::query(
+        _comm, role, partition, source_points, target_points, queries,
+        _indices, _offset, ranks, this->_statistics );
+    _ranks = Details::CompressedRanks<DeviceType>::compress( _comm, ranks );
 
     // Retrieve the coordinates of all source points that met the predicates.
+    // They are packed contiguously whatever the layout of the input.
     // NOTE: This is the last collective.
-    source_points = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
-        _comm, _ranks, _indices, source_points );
+    ScopedPhaseTimer<ExecutionSpace> fetch_timer( this->_statistics, "fetch" );
+    _fetch_pattern =
+        Details::NearestNeighborOperatorImpl<DeviceType>::makeFetchPattern(
+            _comm, ranks );
+    auto fetched_source_points =
+        Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
+            _comm, ranks, _indices, source_points );
+    Details::NearestNeighborOperatorImpl<DeviceType>::recordFetch(
+        _fetch_pattern, source_points.extent( 1 ) * sizeof( Coordinate ),
+        this->_statistics );
+    fetch_timer.stop();
+
+    // All the temporaries of the setup are taken from a single arena, sized
+    // for the largest amount of them alive at once.
+    using Arena = Details::SetupArena<DeviceType>;
+    auto const n_fetched = _indices.extent( 0 );
+    auto const n_targets = target_points.extent( 0 );
+    auto constexpr basis = PolynomialBasis::size;
+    Arena arena( Arena::template requiredSize<Coordinate **>( n_fetched, 3 ) +
+                 Arena::template requiredSize<double *>( n_fetched * basis ) +
+                 2 * Arena::template requiredSize<double *>( n_fetched ) +
+                 2 * Arena::template requiredSize<double *>( n_targets * basis *
+                                                             basis ) +
+                 Arena::template requiredSize<double **>(
+                     basis, 3 * n_targets * basis ) );
+
+    ScopedPhaseTimer<ExecutionSpace> moments_timer( this->_statistics,
+                                                    "moments" );
 
     // Transform source points
-    source_points = Details::MovingLeastSquaresOperatorImpl<
-        DeviceType>::transformSourceCoordinates( source_points, _offset,
-                                                 target_points );
-    target_points = Kokkos::View<double **, DeviceType>( "empty" );
+    auto transformed_source_points = Details::MovingLeastSquaresOperatorImpl<
+        DeviceType>::transformSourceCoordinates( fetched_source_points,
+                                                 _offset, target_points,
+                                                 &arena );
+    fetched_source_points = Kokkos::View<Coordinate **, DeviceType>( "empty" );
 
     // Build P (vandermonde matrix)
     // P is a single 1D storage for multiple P_i matrices. Each matrix is of
     // size (#source_points_for_specific_target_point, basis_size)
     auto p =
         Details::MovingLeastSquaresOperatorImpl<DeviceType>::computeVandermonde(
-            source_points, PolynomialBasis() );
+            transformed_source_points, PolynomialBasis(), &arena );
 
     // To build the radial basis function, we need to define the radius of the
     // radial basis function. Since we use kNN, we need to compute the radius.
@@ -78,24 +135,30 @@ MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
     // transformation of the coordinates.
     auto radius =
         Details::MovingLeastSquaresOperatorImpl<DeviceType>::computeRadius(
-            source_points, _offset );
+            transformed_source_points, _offset, &arena );
 
     // Build phi (weight matrix)
     auto phi =
         Details::MovingLeastSquaresOperatorImpl<DeviceType>::computeWeights(
-            source_points, radius, CompactlySupportedRadialBasisFunction() );
+            transformed_source_points, radius,
+            CompactlySupportedRadialBasisFunction(), &arena );
 
     // Build A (moment matrix)
     auto a =
         Details::MovingLeastSquaresOperatorImpl<DeviceType>::computeMoments(
-            _offset, p, phi );
+            _offset, p, phi, &arena );
+
+    moments_timer.stop();
 
     // TODO: it is computationally unnecessary to compute the pseudo-inverse as
     // MxM (U*E^+*V) as it will later be just used to do MxV. We could instead
     // return the (U,E^+,V) and do the MxV multiplication. But for now, it's OK.
+    ScopedPhaseTimer<ExecutionSpace> svd_timer( this->_statistics, "svd" );
     auto t = Details::MovingLeastSquaresOperatorImpl<DeviceType>::invertMoments(
-        a, PolynomialBasis::size );
+        a, PolynomialBasis::size, &arena );
     auto inv_a = std::get<0>( t );
+    svd_timer.stop();
+    this->_statistics.underdetermined_systems = std::get<1>( t );
 
     // std::get<1>(t) returns the number of undetermined system. However, this
     // is not enough to know if we will lose order of accuracy. For example, if
@@ -106,31 +169,94 @@ MovingLeastSquaresOperator<DeviceType, CompactlySupportedRadialBasisFunction,
 
     // NOTE: This assumes that the polynomial basis evaluated at {0,0,0} is
     // going to be [1, 0, 0, ..., 0]^T.
-    _coeffs = Details::MovingLeastSquaresOperatorImpl<
-        DeviceType>::computePolynomialCoefficients( _offset, inv_a, p, phi,
-                                                    PolynomialBasis::size );
+    ScopedPhaseTimer<ExecutionSpace> polynomial_coefficients_timer(
+        this->_statistics, "coefficients" );
+    _coeffs = Details::MovingLeastSquaresOperatorImpl<DeviceType>::
+        template computePolynomialCoefficients<StorageType>(
+            _offset, inv_a, p, phi, PolynomialBasis::size );
+    polynomial_coefficients_timer.stop();
+
+    this->_statistics.arena_high_water_mark = arena.highWaterMark();
+    this->_statistics.recordTemporaryMemory( arena.highWaterMark() );
+    this->_statistics.memory_footprint =
+        ( _offset.span() + _indices.span() ) * sizeof( int ) +
+        _ranks.memoryFootprint() + _coeffs.span() * sizeof( StorageType );
 }
 
 template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
-          typename PolynomialBasis>
-void MovingLeastSquaresOperator<
-    DeviceType, CompactlySupportedRadialBasisFunction, PolynomialBasis>::
-    apply( Kokkos::View<double const *, DeviceType> source_values,
-           Kokkos::View<double *, DeviceType> target_values ) const
+          typename PolynomialBasis, typename StorageType>
+void MovingLeastSquaresOperator<DeviceType,
+                                CompactlySupportedRadialBasisFunction,
+                                PolynomialBasis, StorageType>::
+    apply( Kokkos::View<double const *, Kokkos::LayoutStride, DeviceType>
+               source_values,
+           Kokkos::View<double *, Kokkos::LayoutStride, DeviceType>
+               target_values ) const
 {
     // Precondition: check that the source and the target are properly sized
     DTK_REQUIRE( source_values.extent( 0 ) == _n_source_points );
     DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
 
     // Retrieve values for all source points
-    source_values = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
-        _comm, _ranks, _indices, source_values );
+    ++this->_statistics.num_applications;
+    ScopedPhaseTimer<ExecutionSpace> exchange_timer( this->_statistics,
+                                                     "apply_exchange", _space );
+    Kokkos::View<StorageType const *, DeviceType> fetched_source_values =
+        Details::NearestNeighborOperatorImpl<DeviceType>::template fetchAs<
+            StorageType>( _comm, _ranks, _indices, source_values, _space );
+    Details::NearestNeighborOperatorImpl<DeviceType>::recordFetch(
+        _fetch_pattern, sizeof( StorageType ), this->_statistics );
+    exchange_timer.stop();
 
     // Apply A-1 (P^T phi)
-    auto new_target_values = Details::MovingLeastSquaresOperatorImpl<
-        DeviceType>::computeTargetValues( _offset, _coeffs, source_values );
+    ScopedPhaseTimer<ExecutionSpace> contraction_timer(
+        this->_statistics, "contraction", _space );
+    auto new_target_values =
+        Details::MovingLeastSquaresOperatorImpl<DeviceType>::
+            template computeTargetValues<StorageType>(
+                _offset, _coeffs, fetched_source_values, _space );
 
-    Kokkos::deep_copy( target_values, new_target_values );
+    Kokkos::deep_copy( _space, target_values, new_target_values );
+    _space.fence();
+}
+
+template <typename DeviceType, typename CompactlySupportedRadialBasisFunction,
+          typename PolynomialBasis, typename StorageType>
+void MovingLeastSquaresOperator<DeviceType,
+                                CompactlySupportedRadialBasisFunction,
+                                PolynomialBasis, StorageType>::
+    applyMany( Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+                   source_values,
+               Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+                   target_values ) const
+{
+    // Precondition: check that the source and the target are properly sized
+    DTK_REQUIRE( source_values.extent( 0 ) == _n_source_points );
+    DTK_REQUIRE( target_values.extent( 0 ) == _offset.extent( 0 ) - 1 );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+    // Retrieve values of all the fields for all source points
+    ++this->_statistics.num_applications;
+    ScopedPhaseTimer<ExecutionSpace> exchange_timer( this->_statistics,
+                                                     "apply_exchange", _space );
+    Kokkos::View<StorageType const **, DeviceType> fetched_source_values =
+        Details::NearestNeighborOperatorImpl<DeviceType>::template fetchAs<
+            StorageType>( _comm, _ranks, _indices, source_values, _space );
+    Details::NearestNeighborOperatorImpl<DeviceType>::recordFetch(
+        _fetch_pattern, source_values.extent( 1 ) * sizeof( StorageType ),
+        this->_statistics );
+    exchange_timer.stop();
+
+    // Apply A-1 (P^T phi)
+    ScopedPhaseTimer<ExecutionSpace> contraction_timer(
+        this->_statistics, "contraction", _space );
+    auto new_target_values =
+        Details::MovingLeastSquaresOperatorImpl<DeviceType>::
+            template computeTargetValues<StorageType>(
+                _offset, _coeffs, fetched_source_values, _space );
+
+    Kokkos::deep_copy( _space, target_values, new_target_values );
+    _space.fence();
 }
 
 } // end namespace DataTransferKit
@@ -140,6 +266,9 @@ void MovingLeastSquaresOperator<
     template class MovingLeastSquaresOperator<typename NODE::device_type>;     \
     template class MovingLeastSquaresOperator<                                 \
         typename NODE::device_type, Wendland<0>,                               \
-        MultivariatePolynomialBasis<Quadratic, 3>>;
+        MultivariatePolynomialBasis<Quadratic, 3>>;                            \
+    template class MovingLeastSquaresOperator<                                 \
+        typename NODE::device_type, Wendland<0>,                               \
+        MultivariatePolynomialBasis<Linear, 3>, float>;
 
 #endif
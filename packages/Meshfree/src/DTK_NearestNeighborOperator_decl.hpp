@@ -12,6 +12,7 @@
 #ifndef DTK_NEAREST_NEIGHBOR_OPERATOR_DECL_HPP
 #define DTK_NEAREST_NEIGHBOR_OPERATOR_DECL_HPP
 
+#include <DTK_DetailsCompressedRanks.hpp>
 #include <DTK_PointCloudOperator.hpp>
 
 #include <mpi.h>
@@ -25,20 +26,83 @@ class NearestNeighborOperator : public PointCloudOperator<DeviceType>
     using ExecutionSpace = typename DeviceType::execution_space;
 
   public:
+    // The operator is applied on the execution space instance \p space, so
+    // that operators applied from different threads on different instances
+    // do not synchronize with each other. Its setup runs on the default
+    // instance.
     NearestNeighborOperator(
         MPI_Comm comm,
-        Kokkos::View<Coordinate const **, DeviceType> source_points,
-        Kokkos::View<Coordinate const **, DeviceType> target_points );
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        ExecutionSpace const &space = ExecutionSpace() );
 
-    void
-    apply( Kokkos::View<double const *, DeviceType> source_values,
-           Kokkos::View<double *, DeviceType> target_values ) const override;
+    // The source and the target points may live on disjoint sets of ranks of
+    // \p comm. Each rank states which points it holds with \p role, and the
+    // search tree is only built over the ranks holding source points. The
+    // ranks that search for the neighbors of the target points are chosen
+    // with \p partition.
+    NearestNeighborOperator(
+        MPI_Comm comm, PointCloudRole role,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        ExecutionSpace const &space = ExecutionSpace(),
+        SearchPartition partition = SearchPartition::Target );
+
+    // Only the source points within \p max_distance of a target point are
+    // considered, so that the search is bounded to the ranks nearby. The
+    // target points without any source point within that distance are
+    // flagged, see foundQueryIds(), and are not assigned a value by apply().
+    // The maximum distance must be the same on all the ranks.
+    NearestNeighborOperator(
+        MPI_Comm comm, PointCloudRole role,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            source_points,
+        Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+            target_points,
+        Coordinate max_distance, ExecutionSpace const &space = ExecutionSpace(),
+        SearchPartition partition = SearchPartition::Target );
+
+    void apply(
+        Kokkos::View<double const *, Kokkos::LayoutStride, DeviceType>
+            source_values,
+        Kokkos::View<double *, Kokkos::LayoutStride, DeviceType> target_values )
+        const override;
+
+    void applyMany(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            source_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            target_values ) const override;
+
+    // Ids of the target points that have a nearest neighbor, in increasing
+    // order, followed by -1 for the flagged ones, like the ids returned by
+    // Interpolation::apply().
+    Kokkos::View<int const *, DeviceType> foundQueryIds() const;
+
+    // Value assigned by apply() to the flagged target points. By default,
+    // their values are left untouched.
+    void setDefaultValue( double value )
+    {
+        _fill_missing = true;
+        _default_value = value;
+    }
 
   private:
     MPI_Comm _comm;
+    ExecutionSpace _space;
     Kokkos::View<int *, DeviceType> _indices;
-    Kokkos::View<int *, DeviceType> _ranks;
+    Details::CompressedRanks<DeviceType> _ranks;
+    Details::FetchPattern _fetch_pattern;
+    // Only stored when some target points are flagged.
+    Kokkos::View<int *, DeviceType> _found_query_ids;
+    bool _fill_missing = false;
+    double _default_value = 0.;
     int const _size;
+    int const _n_target_points;
 };
 
 } // namespace DataTransferKit
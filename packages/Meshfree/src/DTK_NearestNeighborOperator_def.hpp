@@ -15,66 +15,203 @@
 #include <ArborX.hpp>
 #include <DTK_DBC.hpp>
 #include <DTK_DetailsNearestNeighborOperatorImpl.hpp>
+#include <DTK_DetailsSourceTargetGroupsImpl.hpp>
+
+#include <limits>
 
 namespace DataTransferKit
 {
 
 template <typename DeviceType>
 NearestNeighborOperator<DeviceType>::NearestNeighborOperator(
-    MPI_Comm comm, Kokkos::View<Coordinate const **, DeviceType> source_points,
-    Kokkos::View<Coordinate const **, DeviceType> target_points )
+    MPI_Comm comm,
+    Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+        source_points,
+    Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+        target_points,
+    ExecutionSpace const &space )
+    : NearestNeighborOperator( comm, PointCloudRole::SourceAndTarget,
+                               source_points, target_points, space )
+{
+}
+
+template <typename DeviceType>
+NearestNeighborOperator<DeviceType>::NearestNeighborOperator(
+    MPI_Comm comm, PointCloudRole role,
+    Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+        source_points,
+    Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+        target_points,
+    ExecutionSpace const &space, SearchPartition partition )
+    : NearestNeighborOperator( comm, role, source_points, target_points,
+                               std::numeric_limits<Coordinate>::infinity(),
+                               space, partition )
+{
+}
+
+template <typename DeviceType>
+NearestNeighborOperator<DeviceType>::NearestNeighborOperator(
+    MPI_Comm comm, PointCloudRole role,
+    Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+        source_points,
+    Kokkos::View<Coordinate const **, Kokkos::LayoutStride, DeviceType>
+        target_points,
+    Coordinate max_distance, ExecutionSpace const &space,
+    SearchPartition partition )
     : _comm( comm )
+    , _space( space )
     , _indices( "indices" )
-    , _ranks( "ranks" )
+    , _found_query_ids( "found_query_ids" )
     , _size( source_points.extent_int( 0 ) )
+    , _n_target_points( target_points.extent_int( 0 ) )
 {
+    DTK_REQUIRE( max_distance >= 0. );
+
     // NOTE: instead of checking the pre-condition that there is at least one
     // source point passed to one of the rank, we let the tree handle the
     // communication and just check that the tree is not empty.
 
-    // Build distributed search tree over the source points.
-    ArborX::DistributedSearchTree<DeviceType> search_tree( _comm,
-                                                           source_points );
-
-    // Tree must have at least one leaf, otherwise it makes little sense to
-    // perform the search for nearest neighbors.
-    DTK_CHECK( !search_tree.empty() );
-
-    // Query nearest neighbor for all target points.
-    auto nearest_queries = Details::NearestNeighborOperatorImpl<
-        DeviceType>::makeNearestNeighborQueries( target_points );
-
-    // Perform the actual search.
     Kokkos::View<int *, DeviceType> indices( "indices" );
     Kokkos::View<int *, DeviceType> offset( "offset" );
     Kokkos::View<int *, DeviceType> ranks( "ranks" );
-    search_tree.query( nearest_queries, indices, offset, ranks );
-
-    // Check post-condition that we did find a nearest neighbor to all target
-    // points.
-    DTK_ENSURE( ArborX::lastElement( offset ) ==
-                target_points.extent_int( 0 ) );
+    if ( max_distance == std::numeric_limits<Coordinate>::infinity() )
+    {
+        // Query nearest neighbor for all target points.
+        auto nearest_queries = Details::NearestNeighborOperatorImpl<
+            DeviceType>::makeNearestNeighborQueries( target_points );
+
+        // Perform the actual search over a distributed search tree built on
+        // the source points.
+        Details::SourceTargetGroupsImpl<DeviceType>::query(
+            _comm, role, partition, source_points, target_points,
+            nearest_queries, indices, offset, ranks, this->_statistics );
+
+        // Check post-condition that we did find a nearest neighbor to all
+        // target points.
+        DTK_ENSURE( ArborX::lastElement( offset ) ==
+                    target_points.extent_int( 0 ) );
+
+        // NOTE: we don't bother keeping `offset` around since it is just `[0,
+        // 1, 2, ..., n_target_poins]`, nor the ids of the target points found
+        // since they are all found.
+    }
+    else
+    {
+        // Find all the source points within the maximum distance of the
+        // target points. Only the ranks whose source points are that close
+        // are searched.
+        auto within_queries = Details::NearestNeighborOperatorImpl<
+            DeviceType>::makeWithinQueries( target_points, max_distance );
+        Details::SourceTargetGroupsImpl<DeviceType>::query(
+            _comm, role, partition, source_points, target_points,
+            within_queries, indices, offset, ranks, this->_statistics );
+
+        // Retrieve the coordinates of the candidates and keep the closest
+        // one.
+        ScopedPhaseTimer<ExecutionSpace> fetch_timer( this->_statistics,
+                                                      "fetch" );
+        auto const candidates_pattern =
+            Details::NearestNeighborOperatorImpl<DeviceType>::makeFetchPattern(
+                _comm, ranks );
+        auto candidate_points =
+            Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
+                _comm, ranks, indices, source_points );
+        Details::NearestNeighborOperatorImpl<DeviceType>::recordFetch(
+            candidates_pattern,
+            source_points.extent( 1 ) * sizeof( Coordinate ),
+            this->_statistics );
+        fetch_timer.stop();
+
+        auto found_query_ids =
+            Details::NearestNeighborOperatorImpl<DeviceType>::
+                selectNearestNeighbors( target_points, offset,
+                                        candidate_points, indices, ranks );
+        if ( indices.extent_int( 0 ) < _n_target_points )
+            _found_query_ids = found_query_ids;
+    }
 
     // Save results.
-    // NOTE: we don't bother keeping `offset` around since it is just `[0, 1, 2,
-    // ..., n_target_poins]`
     _indices = indices;
-    _ranks = ranks;
+    _ranks = Details::CompressedRanks<DeviceType>::compress( _comm, ranks );
+    _fetch_pattern =
+        Details::NearestNeighborOperatorImpl<DeviceType>::makeFetchPattern(
+            _comm, ranks );
+
+    this->_statistics.memory_footprint =
+        ( _indices.span() + _found_query_ids.span() ) * sizeof( int ) +
+        _ranks.memoryFootprint();
+}
+
+template <typename DeviceType>
+Kokkos::View<int const *, DeviceType>
+NearestNeighborOperator<DeviceType>::foundQueryIds() const
+{
+    if ( _found_query_ids.extent_int( 0 ) == _n_target_points )
+        return _found_query_ids;
+
+    // Every target point was found.
+    Kokkos::View<int *, DeviceType> found_query_ids(
+        Kokkos::ViewAllocateWithoutInitializing( "found_query_ids" ),
+        _n_target_points );
+    ArborX::iota( found_query_ids );
+    return found_query_ids;
 }
 
 template <typename DeviceType>
 void NearestNeighborOperator<DeviceType>::apply(
-    Kokkos::View<double const *, DeviceType> source_values,
-    Kokkos::View<double *, DeviceType> target_values ) const
+    Kokkos::View<double const *, Kokkos::LayoutStride, DeviceType>
+        source_values,
+    Kokkos::View<double *, Kokkos::LayoutStride, DeviceType> target_values )
+    const
 {
     // Precondition: check that the source and target are properly sized
-    DTK_REQUIRE( _indices.extent( 0 ) == target_values.extent( 0 ) );
+    DTK_REQUIRE( _n_target_points == target_values.extent_int( 0 ) );
     DTK_REQUIRE( _size == source_values.extent_int( 0 ) );
 
+    ++this->_statistics.num_applications;
+    ScopedPhaseTimer<ExecutionSpace> exchange_timer( this->_statistics,
+                                                     "apply_exchange", _space );
     auto values = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
-        _comm, _ranks, _indices, source_values );
+        _comm, _ranks, _indices, source_values, _space );
+    Details::NearestNeighborOperatorImpl<DeviceType>::recordFetch(
+        _fetch_pattern, sizeof( double ), this->_statistics );
+    exchange_timer.stop();
+
+    // The values fetched are those of the nearest neighbors.
+    ScopedPhaseTimer<ExecutionSpace> contraction_timer(
+        this->_statistics, "contraction", _space );
+    Details::NearestNeighborOperatorImpl<DeviceType>::setTargetValues(
+        _found_query_ids, values, target_values, _fill_missing,
+        _default_value, _space );
+}
 
-    Kokkos::deep_copy( target_values, values );
+template <typename DeviceType>
+void NearestNeighborOperator<DeviceType>::applyMany(
+    Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+        source_values,
+    Kokkos::View<double **, Kokkos::LayoutStride, DeviceType> target_values )
+    const
+{
+    // Precondition: check that the source and target are properly sized
+    DTK_REQUIRE( _n_target_points == target_values.extent_int( 0 ) );
+    DTK_REQUIRE( _size == source_values.extent_int( 0 ) );
+    DTK_REQUIRE( source_values.extent( 1 ) == target_values.extent( 1 ) );
+
+    ++this->_statistics.num_applications;
+    ScopedPhaseTimer<ExecutionSpace> exchange_timer( this->_statistics,
+                                                     "apply_exchange", _space );
+    auto values = Details::NearestNeighborOperatorImpl<DeviceType>::fetch(
+        _comm, _ranks, _indices, source_values, _space );
+    Details::NearestNeighborOperatorImpl<DeviceType>::recordFetch(
+        _fetch_pattern, source_values.extent( 1 ) * sizeof( double ),
+        this->_statistics );
+    exchange_timer.stop();
+
+    ScopedPhaseTimer<ExecutionSpace> contraction_timer(
+        this->_statistics, "contraction", _space );
+    Details::NearestNeighborOperatorImpl<DeviceType>::setTargetValues(
+        _found_query_ids, values, target_values, _fill_missing,
+        _default_value, _space );
 }
 
 } // namespace DataTransferKit
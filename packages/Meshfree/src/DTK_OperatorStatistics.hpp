@@ -0,0 +1,154 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_OPERATOR_STATISTICS_HPP
+#define DTK_OPERATOR_STATISTICS_HPP
+
+#include <DTK_Tracing.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace DataTransferKit
+{
+
+// Costs of an operator on the calling rank, accumulated over its setup and
+// all its applications. The phases of the setup are "repartition", when the
+// search is repartitioned, "tree_build", "query", "fetch", "moments", which
+// builds the moment matrices, "svd", and "coefficients". The phases of an
+// application are "apply_exchange", which exchanges the source values, and
+// "contraction", which combines them into the target values. Operators only
+// record the phases they go through and may record phases of their own.
+struct OperatorStatistics
+{
+    // Wall clock time in seconds spent in each phase.
+    std::map<std::string, double> phase_times;
+
+    // Number of calls to apply() and applyMany().
+    std::size_t num_applications = 0;
+
+    // Data exchanged with the other ranks of the communicator of the
+    // operator, including the rank itself, to gather the source values and
+    // coordinates. The communication internal to the search is not counted.
+    std::size_t bytes_sent = 0;
+    std::size_t bytes_received = 0;
+    std::size_t messages_sent = 0;
+    std::size_t messages_received = 0;
+
+    // Largest amount of memory in bytes held at once by the temporary views
+    // of a phase.
+    std::size_t peak_temporary_memory = 0;
+
+    // Largest number of bytes in use at once in the arena the temporaries of
+    // the setup are taken from, for operators that use one.
+    std::size_t arena_high_water_mark = 0;
+
+    // Bytes held by the operator between applications, e.g. the neighbors of
+    // the targets and the coefficients.
+    std::size_t memory_footprint = 0;
+
+    // Number of target points whose moment matrix is rank deficient.
+    std::size_t underdetermined_systems = 0;
+
+    void recordTemporaryMemory( std::size_t bytes )
+    {
+        peak_temporary_memory = std::max( peak_temporary_memory, bytes );
+    }
+
+    // Write the statistics as a JSON object.
+    void writeJSON( std::ostream &os ) const
+    {
+        os << "{\"phase_times\":{";
+        for ( auto it = phase_times.begin(); it != phase_times.end(); ++it )
+            os << ( it == phase_times.begin() ? "" : "," ) << '"' << it->first
+               << "\":" << it->second;
+        os << "},\"num_applications\":" << num_applications
+           << ",\"bytes_sent\":" << bytes_sent
+           << ",\"bytes_received\":" << bytes_received
+           << ",\"messages_sent\":" << messages_sent
+           << ",\"messages_received\":" << messages_received
+           << ",\"peak_temporary_memory\":" << peak_temporary_memory
+           << ",\"arena_high_water_mark\":" << arena_high_water_mark
+           << ",\"memory_footprint\":" << memory_footprint
+           << ",\"underdetermined_systems\":" << underdetermined_systems
+           << "}";
+    }
+};
+
+// Add the time spent in a scope to a phase of the statistics. The timer may
+// also be stopped before the end of the scope. The execution space instance
+// is fenced before the timer is stopped so that the kernels launched in the
+// meantime are accounted for. The phase is also recorded as a region of the
+// trace when tracing is enabled.
+template <typename ExecutionSpace>
+class ScopedPhaseTimer
+{
+  public:
+    ScopedPhaseTimer( OperatorStatistics &statistics, std::string phase,
+                      ExecutionSpace const &space = ExecutionSpace() )
+        : _statistics( statistics )
+        , _phase( std::move( phase ) )
+        , _space( space )
+        , _start( std::chrono::steady_clock::now() )
+        , _trace( _phase.c_str() )
+    {
+    }
+
+    ScopedPhaseTimer( ScopedPhaseTimer const & ) = delete;
+    ScopedPhaseTimer &operator=( ScopedPhaseTimer const & ) = delete;
+
+    ~ScopedPhaseTimer() { stop(); }
+
+    void stop()
+    {
+        if ( _stopped )
+            return;
+        _space.fence();
+        std::chrono::duration<double> const elapsed =
+            std::chrono::steady_clock::now() - _start;
+        _statistics.phase_times[_phase] += elapsed.count();
+        _trace.stop();
+        _stopped = true;
+    }
+
+  private:
+    OperatorStatistics &_statistics;
+    std::string const _phase;
+    ExecutionSpace const _space;
+    std::chrono::steady_clock::time_point const _start;
+    TraceRegion _trace;
+    bool _stopped = false;
+};
+
+namespace Details
+{
+
+// Communication performed by fetch() on a rank for given ranks and indices:
+// number of values it requests and serves, and number of ranks it requests
+// values from and serves values to. It does not depend on the values so
+// that operators compute it once.
+struct FetchPattern
+{
+    std::size_t n_exports = 0;
+    std::size_t n_imports = 0;
+    std::size_t n_destinations = 0;
+    std::size_t n_sources = 0;
+};
+
+} // namespace Details
+} // namespace DataTransferKit
+
+#endif
@@ -13,21 +13,70 @@
 #define DTK_POINT_CLOUD_OPERATOR_DECL_HPP
 
 #include <DTK_ConfigDefs.hpp>
+#include <DTK_OperatorStatistics.hpp>
 
 #include <Kokkos_View.hpp>
 
 namespace DataTransferKit
 {
 
+// Data held by a rank of the communicator of an operator. By default every
+// rank may hold both source and target points. When the source and the
+// target live on disjoint sets of ranks, each rank only holds the points of
+// its group and passes empty views for the other one.
+enum class PointCloudRole
+{
+    SourceAndTarget,
+    Source,
+    Target
+};
+
+// Ranks that search for the neighbors of the target points during the setup
+// of an operator. By default, each rank searches for the neighbors of its own
+// target points. When the target is partitioned very differently from the
+// source, for instance a surface coupled to a volume, the queries all land on
+// the few source ranks near the targets of a rank and the search is
+// imbalanced. With Source, the target points are first sent to the ranks
+// whose source points surround them, which search for their neighbors and
+// send the results back. The operator is applied in the ordering of the
+// caller either way.
+enum class SearchPartition
+{
+    Target,
+    Source
+};
+
 template <typename DeviceType>
 class PointCloudOperator
 {
   public:
     virtual ~PointCloudOperator() = default;
 
-    virtual void
-    apply( Kokkos::View<double const *, DeviceType> source_values,
-           Kokkos::View<double *, DeviceType> target_values ) const = 0;
+    // The values are taken as strided views so that the operator can be
+    // applied to the data of the application in place, whatever its layout.
+    // LayoutLeft and LayoutRight views convert to LayoutStride without copy.
+    virtual void apply(
+        Kokkos::View<double const *, Kokkos::LayoutStride, DeviceType>
+            source_values,
+        Kokkos::View<double *, Kokkos::LayoutStride, DeviceType> target_values )
+        const = 0;
+
+    // Apply the operator to several fields at once. Each column holds the
+    // values of one field. The values of all the fields are exchanged
+    // together.
+    virtual void applyMany(
+        Kokkos::View<double const **, Kokkos::LayoutStride, DeviceType>
+            source_values,
+        Kokkos::View<double **, Kokkos::LayoutStride, DeviceType>
+            target_values ) const = 0;
+
+    // Costs accumulated on the calling rank since the construction of the
+    // operator.
+    OperatorStatistics const &statistics() const { return _statistics; }
+
+  protected:
+    // Applying the operator updates its statistics.
+    mutable OperatorStatistics _statistics;
 };
 
 } // end namespace DataTransferKit
@@ -64,22 +64,29 @@ namespace DataTransferKit
 // ---------------------------------
 //
 // In the uniquely owned case, mesh nodes are given one single, unique
-// destination in the partitioning.
+// destination in the partitioning. By default the node coordinates are read
+// by rank 0 and scattered from there. In the parallel read mode, each rank
+// instead reads a contiguous slab of the nodes and sends them directly to the
+// rank owning their spatial bin so that no rank ever holds the whole mesh.
 //
 // In the ghosted case, mesh elements are given one unique destination and
 // all nodes belonging to that element are sent to that
 // destination. Therefore, nodes owned by multiple elements with different
-// destinations will be sent to multiple ranks and thus ghosted.
+// destinations will be sent to multiple ranks and thus ghosted. The element
+// connectivity references arbitrary nodes so the ghosted case always reads
+// the file on rank 0.
 //
 template <class Scalar, class SourceDevice, class TargetDevice>
 class ExodusProblemGenerator
     : public PointCloudProblemGenerator<Scalar, SourceDevice, TargetDevice>
 {
   public:
-    // Constructor.
+    // Constructor. If parallel_read is true, the uniquely owned problem is
+    // read from the files by all ranks.
     ExodusProblemGenerator( MPI_Comm comm,
                             const std::string &source_exodus_file,
-                            const std::string &target_exodus_file );
+                            const std::string &target_exodus_file,
+                            const bool parallel_read = false );
 
     // Create a problem where all points are uniquely owned (i.e. no
     // ghosting). Both source and target fields have one component and are
@@ -110,10 +117,11 @@ class ExodusProblemGenerator
         override;
 
   private:
-    // Get host views of node data from file.
+    // Get host views of node data from file. Either rank 0 reads all the
+    // nodes or each rank reads a contiguous slab of them.
     template <class Device>
     void getNodeDataFromFile(
-        const std::string &exodus_file,
+        const std::string &exodus_file, const bool parallel_read,
         Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> &coords,
         Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> &gids );
 
@@ -145,6 +153,9 @@ class ExodusProblemGenerator
     // Filenames
     std::string _src_exodus_file;
     std::string _tgt_exodus_file;
+
+    // Whether the uniquely owned problem is read by all ranks.
+    bool _parallel_read;
 };
 
 //---------------------------------------------------------------------------//
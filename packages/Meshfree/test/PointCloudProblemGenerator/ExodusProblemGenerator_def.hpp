@@ -17,6 +17,7 @@
 
 #include <netcdf.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <limits>
@@ -30,10 +31,12 @@ template <class Scalar, class SourceDevice, class TargetDevice>
 ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
     ExodusProblemGenerator( MPI_Comm comm,
                             const std::string &source_exodus_file,
-                            const std::string &target_exodus_file )
+                            const std::string &target_exodus_file,
+                            const bool parallel_read )
     : _comm( comm )
     , _src_exodus_file( source_exodus_file )
     , _tgt_exodus_file( target_exodus_file )
+    , _parallel_read( parallel_read )
 { /* ... */
 }
 
@@ -107,14 +110,16 @@ template <class Scalar, class SourceDevice, class TargetDevice>
 template <class Device>
 void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
     getNodeDataFromFile(
-        const std::string &exodus_file,
+        const std::string &exodus_file, const bool parallel_read,
         Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> &coords,
         Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> &gids )
 {
-    // Only populate views on rank 0.
+    // Only populate views on rank 0 unless all ranks read.
     int comm_rank;
     MPI_Comm_rank( _comm, &comm_rank );
-    if ( comm_rank == 0 )
+    int comm_size;
+    MPI_Comm_size( _comm, &comm_size );
+    if ( parallel_read || comm_rank == 0 )
     {
         // Open the exodus file.
         int nc_id;
@@ -124,11 +129,25 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
         // Get the number of nodes.
         auto num_nodes = getNetcdfDimensionLength( nc_id, "num_nodes" );
 
+        // Get the slab of nodes read by this rank. The nodes are split evenly
+        // with the first ranks reading one more node than the others if they
+        // do not divide evenly.
+        size_t offset = 0;
+        size_t count = num_nodes;
+        if ( parallel_read )
+        {
+            size_t remainder = num_nodes % comm_size;
+            count = num_nodes / comm_size +
+                    ( static_cast<size_t>( comm_rank ) < remainder ? 1 : 0 );
+            offset = comm_rank * ( num_nodes / comm_size ) +
+                     std::min( static_cast<size_t>( comm_rank ), remainder );
+        }
+
         // Allocate the coordinate and global id arrray.
         coords = Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device>(
-            "coords", num_nodes, 3 );
+            Kokkos::ViewAllocateWithoutInitializing( "coords" ), count, 3 );
         gids = Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device>(
-            "gids", num_nodes );
+            Kokkos::ViewAllocateWithoutInitializing( "gids" ), count );
 
         // Get the coordinate variable ids.
         int coord_var_id_x;
@@ -141,20 +160,25 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
         DTK_CHECK_ERROR_CODE(
             nc_inq_varid( nc_id, "coordz", &coord_var_id_z ) );
 
-        // Get the coordinates.
-        DTK_CHECK_ERROR_CODE(
-            nc_get_var_double( nc_id, coord_var_id_x, coords.data() ) );
-        DTK_CHECK_ERROR_CODE( nc_get_var_double( nc_id, coord_var_id_y,
-                                                 coords.data() + num_nodes ) );
-        DTK_CHECK_ERROR_CODE( nc_get_var_double(
-            nc_id, coord_var_id_z, coords.data() + 2 * num_nodes ) );
+        // Get the coordinates in the slab.
+        if ( count > 0 )
+        {
+            DTK_CHECK_ERROR_CODE( nc_get_vara_double(
+                nc_id, coord_var_id_x, &offset, &count, coords.data() ) );
+            DTK_CHECK_ERROR_CODE(
+                nc_get_vara_double( nc_id, coord_var_id_y, &offset, &count,
+                                    coords.data() + count ) );
+            DTK_CHECK_ERROR_CODE(
+                nc_get_vara_double( nc_id, coord_var_id_z, &offset, &count,
+                                    coords.data() + 2 * count ) );
+        }
 
         // Close the exodus file.
         DTK_CHECK_ERROR_CODE( nc_close( nc_id ) );
 
         // Create unique global ids starting at 1.
-        for ( size_t i = 0; i < num_nodes; ++i )
-            gids( i ) = i + 1;
+        for ( size_t i = 0; i < count; ++i )
+            gids( i ) = offset + i + 1;
     }
     else
     {
@@ -177,23 +201,33 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
     // Get the node data.
     Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> export_coords;
     Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> export_gids;
-    getNodeDataFromFile( exodus_file, export_coords, export_gids );
+    getNodeDataFromFile( exodus_file, _parallel_read, export_coords,
+                         export_gids );
+
+    // Figure out the min and max coordinates in the given dimension. When
+    // all ranks read a slab of the nodes, the bounds of the slabs are reduced
+    // over the communicator.
+    int num_node_export = export_coords.extent( 0 );
+    Coordinate dim_max = std::numeric_limits<Coordinate>::lowest();
+    Coordinate dim_min = std::numeric_limits<Coordinate>::max();
+    if ( 0 < num_node_export )
+        std::tie( dim_min, dim_max ) = ArborX::minMax(
+            Kokkos::subview( export_coords, Kokkos::ALL, dim ) );
+    if ( _parallel_read )
+    {
+        MPI_Allreduce( MPI_IN_PLACE, &dim_min, 1, MPI_DOUBLE, MPI_MIN, _comm );
+        MPI_Allreduce( MPI_IN_PLACE, &dim_max, 1, MPI_DOUBLE, MPI_MAX, _comm );
+    }
 
     // Build a communication plan. Nodes are partitioned into equal spatial
     // bins in the given dimension. There is one spatial bin for each comm
     // rank.
-    int num_node_export = export_coords.extent( 0 );
     Kokkos::View<int *, Kokkos::HostSpace> export_ranks( "export_proc_ids",
                                                          num_node_export );
     int comm_size;
     MPI_Comm_size( _comm, &comm_size );
     if ( 0 < num_node_export )
     {
-        // Figure out the min and max coordinates in the given dimension.
-        Coordinate dim_max, dim_min;
-        std::tie( dim_min, dim_max ) = ArborX::minMax(
-            Kokkos::subview( export_coords, Kokkos::ALL, dim ) );
-
         double dim_frac = 0.0;
         for ( int n = 0; n < num_node_export; ++n )
         {
@@ -231,7 +265,7 @@ void ExodusProblemGenerator<Scalar, SourceDevice, TargetDevice>::
     // Get the node data.
     Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> input_coords;
     Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> input_gids;
-    getNodeDataFromFile( exodus_file, input_coords, input_gids );
+    getNodeDataFromFile( exodus_file, false, input_coords, input_gids );
 
     // Partition based on the dimension coordinate of the first node in each
     // cell. All nodes belonging to that cell will be sent to that rank to
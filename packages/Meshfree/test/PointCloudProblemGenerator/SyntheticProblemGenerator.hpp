@@ -0,0 +1,191 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_SYNTHETICPROBLEMGENERATOR_HPP
+#define DTK_SYNTHETICPROBLEMGENERATOR_HPP
+
+#include "DTK_ConfigDefs.hpp"
+#include "DTK_Types.h"
+#include "PointCloudProblemGenerator.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <mpi.h>
+
+#include <string>
+
+namespace DataTransferKit
+{
+//---------------------------------------------------------------------------//
+// Spatial distribution of the points of a synthetic point cloud.
+enum class SyntheticDistribution
+{
+    // Uniform in the slab of the rank.
+    uniform,
+    // Gaussian clusters around a few centers in the slab of the rank.
+    clustered,
+    // On the sphere inscribed in the unit cube.
+    surface,
+    // Uniform in a thin plate, 100 times thinner in z than in x and y.
+    anisotropic
+};
+
+//---------------------------------------------------------------------------//
+// Parameters of a synthetic problem.
+struct SyntheticProblemParameters
+{
+    // Number of points generated by each rank before ghosting.
+    int num_src_per_rank = 1000;
+    int num_tgt_per_rank = 1000;
+
+    SyntheticDistribution src_distribution = SyntheticDistribution::uniform;
+    SyntheticDistribution tgt_distribution = SyntheticDistribution::uniform;
+
+    // Shift of the target partition relative to the source partition as a
+    // fraction of the width of a slab. With 0, the targets of a rank lie in
+    // the same slab as its sources. With 1, they all lie in the slab of the
+    // next rank.
+    double partition_mismatch = 0.5;
+
+    // Width of the layer of ghosted points around the slab of a rank as a
+    // fraction of the width of a slab.
+    double ghost_fraction = 0.1;
+
+    // Seed of the generator. The same seed gives the same points for a given
+    // number of ranks.
+    unsigned int seed = 0;
+};
+
+//---------------------------------------------------------------------------//
+// Generate a point cloud problem in memory.
+//
+// The unit cube is divided into one slab along x per rank and each rank
+// generates the points of its own slab without any communication. The
+// points are a deterministic function of the seed and of their global id so
+// that any rank can regenerate the points of another one:
+//
+// |          |          |        |                      |
+// |  o     o |       o  |  o  o  |  o o       o         |
+// |    o     |  o     o |      o |        o      o      |
+// | rank = 0 | rank = 1 | ...... | rank = comm_size - 1 |
+//
+// The target slabs are the source slabs shifted along x by the partition
+// mismatch. They wrap around the unit cube so that each rank still gets one
+// slab worth of targets.
+//
+// In the ghosted case, each rank also regenerates the points of the
+// neighboring slabs that are within the ghost layer of its own slab.
+//
+// Both fields have one component and hold the exact value of field() at
+// the points so that the error of a transfer can be computed.
+//
+template <class Scalar, class SourceDevice, class TargetDevice>
+class SyntheticProblemGenerator
+    : public PointCloudProblemGenerator<Scalar, SourceDevice, TargetDevice>
+{
+  public:
+    // Constructor.
+    SyntheticProblemGenerator( MPI_Comm comm,
+                               const SyntheticProblemParameters &parameters );
+
+    // Analytic field of the problem. Its bilinear term is not reproduced
+    // exactly by a linear moving least squares basis.
+    KOKKOS_INLINE_FUNCTION
+    static Scalar field( const Coordinate x, const Coordinate y,
+                         const Coordinate z )
+    {
+        return 1. + x + 2. * y + 3. * z + x * y;
+    }
+
+    // Create a problem where all points are uniquely owned (i.e. no
+    // ghosting).
+    void createUniquelyOwnedProblem(
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, SourceDevice>
+            &src_coords,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, SourceDevice> &src_field,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_coords,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, TargetDevice> &tgt_field )
+        override;
+
+    // Create a general problem where points near the boundaries of the
+    // slabs exist on multiple processors.
+    void createGhostedProblem(
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, SourceDevice>
+            &src_coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, SourceDevice>
+            &src_gids,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, SourceDevice> &src_field,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_gids,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, TargetDevice> &tgt_field )
+        override;
+
+    // Generate the points of the slab of a rank. The kernels are public
+    // because lambda functions can only be called from public functions in
+    // CUDA.
+    template <class Device>
+    void generateSlab(
+        const int cloud, const int rank, const int num_per_rank,
+        const SyntheticDistribution distribution,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> gids );
+
+    // Keep the points within the ghost layer of the slab of this rank and
+    // append them to the local points.
+    template <class Device>
+    void appendGhosts(
+        const int cloud,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> ghost_coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> ghost_gids,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> &coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> &gids );
+
+    // Evaluate the field at the points.
+    template <class Device>
+    void fillField(
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> coords,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, Device> &values );
+
+  private:
+    // Generate the local points of a cloud, with the ghosts if requested.
+    template <class Device>
+    void generateCloud(
+        const int cloud, const int num_per_rank,
+        const SyntheticDistribution distribution, const bool ghosted,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> &coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> &gids );
+
+  private:
+    // Comm
+    MPI_Comm _comm;
+    int _comm_rank;
+    int _comm_size;
+
+    // Parameters
+    SyntheticProblemParameters _parameters;
+};
+
+//---------------------------------------------------------------------------//
+
+} // namespace DataTransferKit
+
+//---------------------------------------------------------------------------//
+// Template includes
+//---------------------------------------------------------------------------//
+
+#include "SyntheticProblemGenerator_def.hpp"
+
+//---------------------------------------------------------------------------//
+
+#endif // end  DTK_SYNTHETICPROBLEMGENERATOR_HPP
@@ -0,0 +1,418 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#ifndef DTK_SYNTHETICPROBLEMGENERATOR_DEF_HPP
+#define DTK_SYNTHETICPROBLEMGENERATOR_DEF_HPP
+
+#include <ArborX.hpp>
+#include <DTK_DBC.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+
+namespace DataTransferKit
+{
+namespace Details
+{
+namespace Synthetic
+{
+// Index of the clouds in the random streams.
+constexpr int source_cloud = 0;
+constexpr int target_cloud = 1;
+
+// Number of clusters in a slab for the clustered distribution.
+constexpr int num_clusters = 4;
+
+// SplitMix64 finalizer. It is a bijection that mixes all the bits so that
+// consecutive keys give unrelated values.
+KOKKOS_INLINE_FUNCTION
+std::uint64_t mix( std::uint64_t x )
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ull;
+    x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebull;
+    return x ^ ( x >> 31 );
+}
+
+// Random number in [0,1) attached to a key. The stream index gives the
+// independent numbers needed for the same key.
+KOKKOS_INLINE_FUNCTION
+double uniform( const std::uint64_t key, const int stream )
+{
+    return ( mix( key ^ mix( stream ) ) >> 11 ) * ( 1. / 9007199254740992. );
+}
+
+// Random number of the standard normal distribution (Box-Muller).
+KOKKOS_INLINE_FUNCTION
+double normal( const std::uint64_t key, const int stream )
+{
+    double const pi = 3.14159265358979323846;
+    return sqrt( -2. * log( 1. - uniform( key, stream ) ) ) *
+           cos( 2. * pi * uniform( key, stream + 1 ) );
+}
+
+KOKKOS_INLINE_FUNCTION
+double clamp( const double x, const double lower, const double upper )
+{
+    return x < lower ? lower : ( x > upper ? upper : x );
+}
+
+// Distance along x from a point to the slab [lower,lower+width]. If the
+// slabs are periodic, the images of the point on both sides of the unit
+// cube are considered.
+KOKKOS_INLINE_FUNCTION
+double slabDistance( const double x, const double lower, const double width,
+                     const bool periodic )
+{
+    double distance = 2.;
+    for ( int image = -1; image <= 1; ++image )
+    {
+        if ( !periodic && image != 0 )
+            continue;
+        double const y = x + image;
+        double const d = y < lower
+                             ? lower - y
+                             : ( y > lower + width ? y - lower - width : 0. );
+        distance = d < distance ? d : distance;
+    }
+    return distance;
+}
+
+// Generate a point of a slab of the unit cube.
+KOKKOS_INLINE_FUNCTION
+void generatePoint( const SyntheticDistribution distribution,
+                    const std::uint64_t point_key,
+                    const std::uint64_t slab_key, const double lower,
+                    const double width, double &x, double &y, double &z )
+{
+    switch ( distribution )
+    {
+    case SyntheticDistribution::clustered:
+    {
+        int cluster = uniform( point_key, 0 ) * num_clusters;
+        cluster = cluster < num_clusters ? cluster : num_clusters - 1;
+        double const center_x =
+            lower + width * ( 0.2 + 0.6 * uniform( slab_key, 3 * cluster ) );
+        double const center_y =
+            0.2 + 0.6 * uniform( slab_key, 3 * cluster + 1 );
+        double const center_z =
+            0.2 + 0.6 * uniform( slab_key, 3 * cluster + 2 );
+        x = clamp( center_x + 0.1 * width * normal( point_key, 1 ), lower,
+                   lower + width );
+        y = clamp( center_y + 0.05 * normal( point_key, 3 ), 0., 1. );
+        z = clamp( center_z + 0.05 * normal( point_key, 5 ), 0., 1. );
+        break;
+    }
+    case SyntheticDistribution::surface:
+    {
+        // Slices of equal width of a sphere have the same area so uniform x
+        // and angle give a uniform distribution on the sphere.
+        double const pi = 3.14159265358979323846;
+        x = lower + width * uniform( point_key, 0 );
+        x = x < 1. ? x : x - 1.;
+        double const squared_radius = 0.25 - ( x - 0.5 ) * ( x - 0.5 );
+        double const radius = squared_radius > 0. ? sqrt( squared_radius ) : 0.;
+        double const angle = 2. * pi * uniform( point_key, 1 );
+        y = 0.5 + radius * cos( angle );
+        z = 0.5 + radius * sin( angle );
+        return;
+    }
+    case SyntheticDistribution::anisotropic:
+        x = lower + width * uniform( point_key, 0 );
+        y = uniform( point_key, 1 );
+        z = 0.01 * uniform( point_key, 2 );
+        break;
+    case SyntheticDistribution::uniform:
+    default:
+        x = lower + width * uniform( point_key, 0 );
+        y = uniform( point_key, 1 );
+        z = uniform( point_key, 2 );
+        break;
+    }
+
+    // The target slabs wrap around the unit cube.
+    x = x < 1. ? x : x - 1.;
+}
+} // namespace Synthetic
+} // namespace Details
+
+//---------------------------------------------------------------------------//
+// Parse the name of a distribution, e.g. "clustered".
+inline SyntheticDistribution
+syntheticDistributionFromString( const std::string &name )
+{
+    if ( name == "uniform" )
+        return SyntheticDistribution::uniform;
+    if ( name == "clustered" )
+        return SyntheticDistribution::clustered;
+    if ( name == "surface" )
+        return SyntheticDistribution::surface;
+    if ( name == "anisotropic" )
+        return SyntheticDistribution::anisotropic;
+    throw DataTransferKitException( "Unknown synthetic distribution " + name );
+}
+
+//---------------------------------------------------------------------------//
+template <class Scalar, class SourceDevice, class TargetDevice>
+SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::
+    SyntheticProblemGenerator( MPI_Comm comm,
+                               const SyntheticProblemParameters &parameters )
+    : _comm( comm )
+    , _parameters( parameters )
+{
+    DTK_REQUIRE( parameters.num_src_per_rank >= 0 );
+    DTK_REQUIRE( parameters.num_tgt_per_rank >= 0 );
+    DTK_REQUIRE( 0. <= parameters.partition_mismatch &&
+                 parameters.partition_mismatch <= 1. );
+    DTK_REQUIRE( 0. <= parameters.ghost_fraction &&
+                 parameters.ghost_fraction <= 1. );
+    MPI_Comm_rank( _comm, &_comm_rank );
+    MPI_Comm_size( _comm, &_comm_size );
+}
+
+//---------------------------------------------------------------------------//
+// Create a problem where all points are uniquely owned (i.e. no ghosting)
+template <class Scalar, class SourceDevice, class TargetDevice>
+void SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::
+    createUniquelyOwnedProblem(
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, SourceDevice>
+            &src_coords,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, SourceDevice> &src_field,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_coords,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, TargetDevice> &tgt_field )
+{
+    Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, SourceDevice> src_gids;
+    generateCloud( Details::Synthetic::source_cloud,
+                   _parameters.num_src_per_rank, _parameters.src_distribution,
+                   false, src_coords, src_gids );
+    Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, TargetDevice> tgt_gids;
+    generateCloud( Details::Synthetic::target_cloud,
+                   _parameters.num_tgt_per_rank, _parameters.tgt_distribution,
+                   false, tgt_coords, tgt_gids );
+
+    fillField( src_coords, src_field );
+    fillField( tgt_coords, tgt_field );
+}
+
+//---------------------------------------------------------------------------//
+// Create a general problem where points may exist on multiple
+// processors. Points have a unique global id.
+template <class Scalar, class SourceDevice, class TargetDevice>
+void SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::
+    createGhostedProblem(
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, SourceDevice>
+            &src_coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, SourceDevice>
+            &src_gids,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, SourceDevice> &src_field,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, TargetDevice>
+            &tgt_gids,
+        Kokkos::View<Scalar **, Kokkos::LayoutLeft, TargetDevice> &tgt_field )
+{
+    generateCloud( Details::Synthetic::source_cloud,
+                   _parameters.num_src_per_rank, _parameters.src_distribution,
+                   true, src_coords, src_gids );
+    generateCloud( Details::Synthetic::target_cloud,
+                   _parameters.num_tgt_per_rank, _parameters.tgt_distribution,
+                   true, tgt_coords, tgt_gids );
+
+    fillField( src_coords, src_field );
+    fillField( tgt_coords, tgt_field );
+}
+
+//---------------------------------------------------------------------------//
+// Generate the local points of a cloud, with the ghosts if requested.
+template <class Scalar, class SourceDevice, class TargetDevice>
+template <class Device>
+void SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::
+    generateCloud(
+        const int cloud, const int num_per_rank,
+        const SyntheticDistribution distribution, const bool ghosted,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> &coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> &gids )
+{
+    coords = Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device>(
+        Kokkos::ViewAllocateWithoutInitializing( "coords" ), num_per_rank, 3 );
+    gids = Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device>(
+        Kokkos::ViewAllocateWithoutInitializing( "gids" ), num_per_rank );
+    generateSlab( cloud, _comm_rank, num_per_rank, distribution, coords, gids );
+    if ( !ghosted )
+        return;
+
+    // The source slabs end at the boundaries of the unit cube while the
+    // target slabs wrap around it.
+    bool const periodic = ( cloud == Details::Synthetic::target_cloud );
+    int const previous = periodic
+                             ? ( _comm_rank + _comm_size - 1 ) % _comm_size
+                             : _comm_rank - 1;
+    int const next =
+        periodic ? ( _comm_rank + 1 ) % _comm_size : _comm_rank + 1;
+    for ( int neighbor : {previous, next} )
+    {
+        if ( neighbor < 0 || neighbor >= _comm_size ||
+             neighbor == _comm_rank ||
+             ( neighbor == next && next == previous ) )
+            continue;
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> ghost_coords(
+            Kokkos::ViewAllocateWithoutInitializing( "ghost_coords" ),
+            num_per_rank, 3 );
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> ghost_gids(
+            Kokkos::ViewAllocateWithoutInitializing( "ghost_gids" ),
+            num_per_rank );
+        generateSlab( cloud, neighbor, num_per_rank, distribution,
+                      ghost_coords, ghost_gids );
+        appendGhosts( cloud, ghost_coords, ghost_gids, coords, gids );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// Generate the points of the slab of a rank.
+template <class Scalar, class SourceDevice, class TargetDevice>
+template <class Device>
+void SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::
+    generateSlab(
+        const int cloud, const int rank, const int num_per_rank,
+        const SyntheticDistribution distribution,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> gids )
+{
+    using namespace Details::Synthetic;
+
+    double const width = 1. / _comm_size;
+    double const shift =
+        ( cloud == target_cloud ) ? _parameters.partition_mismatch : 0.;
+    double const lower = ( rank + shift ) * width;
+    std::uint64_t const cloud_key =
+        mix( 2 * static_cast<std::uint64_t>( _parameters.seed ) + cloud );
+    std::uint64_t const slab_key = mix( cloud_key ^ mix( ~rank ) );
+    GlobalOrdinal const offset =
+        static_cast<GlobalOrdinal>( rank ) * num_per_rank;
+
+    using ExecutionSpace = typename Device::execution_space;
+    Kokkos::parallel_for(
+        "generate_synthetic_points",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, num_per_rank ),
+        KOKKOS_LAMBDA( const int i ) {
+            // Global ids start at 1.
+            GlobalOrdinal const gid = offset + i + 1;
+            gids( i ) = gid;
+            generatePoint( distribution, mix( cloud_key + gid ), slab_key,
+                           lower, width, coords( i, 0 ), coords( i, 1 ),
+                           coords( i, 2 ) );
+        } );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+// Keep the points within the ghost layer of the slab of this rank and append
+// them to the local points.
+template <class Scalar, class SourceDevice, class TargetDevice>
+template <class Device>
+void SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::
+    appendGhosts(
+        const int cloud,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> ghost_coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> ghost_gids,
+        Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> &coords,
+        Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device> &gids )
+{
+    using namespace Details::Synthetic;
+    using ExecutionSpace = typename Device::execution_space;
+
+    double const width = 1. / _comm_size;
+    bool const periodic = ( cloud == target_cloud );
+    double const shift = periodic ? _parameters.partition_mismatch : 0.;
+    double const lower = ( _comm_rank + shift ) * width;
+    double const layer = _parameters.ghost_fraction * width;
+
+    // Flag the points in the layer and compute where they go.
+    int const num_candidates = ghost_coords.extent( 0 );
+    Kokkos::View<int *, Device> offsets( "ghost_offsets", num_candidates + 1 );
+    Kokkos::parallel_for(
+        "flag_synthetic_ghosts",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, num_candidates ),
+        KOKKOS_LAMBDA( const int i ) {
+            offsets( i ) =
+                slabDistance( ghost_coords( i, 0 ), lower, width, periodic ) <=
+                        layer
+                    ? 1
+                    : 0;
+        } );
+    Kokkos::fence();
+    ArborX::exclusivePrefixSum( offsets );
+    int const num_ghosts = ArborX::lastElement( offsets );
+
+    int const num_local = coords.extent( 0 );
+    auto local_coords = coords;
+    auto local_gids = gids;
+    coords = Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device>(
+        Kokkos::ViewAllocateWithoutInitializing( "coords" ),
+        num_local + num_ghosts, 3 );
+    gids = Kokkos::View<GlobalOrdinal *, Kokkos::LayoutLeft, Device>(
+        Kokkos::ViewAllocateWithoutInitializing( "gids" ),
+        num_local + num_ghosts );
+    auto new_coords = coords;
+    auto new_gids = gids;
+    Kokkos::parallel_for(
+        "copy_synthetic_points",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, num_local ),
+        KOKKOS_LAMBDA( const int i ) {
+            new_gids( i ) = local_gids( i );
+            for ( int d = 0; d < 3; ++d )
+                new_coords( i, d ) = local_coords( i, d );
+        } );
+    Kokkos::parallel_for(
+        "append_synthetic_ghosts",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, num_candidates ),
+        KOKKOS_LAMBDA( const int i ) {
+            if ( offsets( i + 1 ) == offsets( i ) )
+                return;
+            int const j = num_local + offsets( i );
+            new_gids( j ) = ghost_gids( i );
+            for ( int d = 0; d < 3; ++d )
+                new_coords( j, d ) = ghost_coords( i, d );
+        } );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+// Evaluate the field at the points.
+template <class Scalar, class SourceDevice, class TargetDevice>
+template <class Device>
+void SyntheticProblemGenerator<Scalar, SourceDevice, TargetDevice>::fillField(
+    Kokkos::View<Coordinate **, Kokkos::LayoutLeft, Device> coords,
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, Device> &values )
+{
+    int const num_points = coords.extent( 0 );
+    values = Kokkos::View<Scalar **, Kokkos::LayoutLeft, Device>(
+        Kokkos::ViewAllocateWithoutInitializing( "field" ), num_points, 1 );
+    auto field_values = values;
+    using ExecutionSpace = typename Device::execution_space;
+    Kokkos::parallel_for(
+        "fill_synthetic_field",
+        Kokkos::RangePolicy<ExecutionSpace>( 0, num_points ),
+        KOKKOS_LAMBDA( const int i ) {
+            field_values( i, 0 ) =
+                field( coords( i, 0 ), coords( i, 1 ), coords( i, 2 ) );
+        } );
+    Kokkos::fence();
+}
+
+//---------------------------------------------------------------------------//
+
+} // namespace DataTransferKit
+
+#endif // end  DTK_SYNTHETICPROBLEMGENERATOR_DEF_HPP
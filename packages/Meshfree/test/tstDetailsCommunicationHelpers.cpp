@@ -73,8 +73,8 @@ struct Helper
         TEST_COMPARE_ARRAYS( toArray( v_imp ), toArray( v_ref ) );
     }
 
-    template <typename View1, typename View2>
-    static void checkFetch( MPI_Comm comm, View1 const &ranks,
+    template <typename Ranks, typename View1, typename View2>
+    static void checkFetch( MPI_Comm comm, Ranks const &ranks,
                             View1 const &indices, View2 const &v_exp,
                             View2 const &v_ref, bool &success,
                             Teuchos::FancyOStream &out )
@@ -219,6 +219,54 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( DetailsNearestNeighborOperatorImpl, fetch,
                                     out );
 }
 
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( DetailsNearestNeighborOperatorImpl,
+                                   fetch_compressed_ranks, DeviceType )
+{
+    using ExecutionSpace = typename DeviceType::execution_space;
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // Request every value of every rank, several times and out of order.
+    int const n = 3 * comm_size * comm_size;
+    Kokkos::View<int *, DeviceType> indices( "indices", n );
+    Kokkos::View<int *, DeviceType> ranks( "ranks", n );
+    Kokkos::parallel_for( Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+                          KOKKOS_LAMBDA( int i ) {
+                              indices( i ) = ( i / comm_size ) % comm_size;
+                              ranks( i ) = ( comm_rank + 7 * i ) % comm_size;
+                          } );
+    Kokkos::fence();
+
+    auto const compressed =
+        DataTransferKit::Details::CompressedRanks<DeviceType>::compress(
+            comm, ranks );
+    TEST_EQUALITY( compressed.size(), static_cast<std::size_t>( n ) );
+    TEST_ASSERT( compressed.isCompressed() );
+    TEST_ASSERT( compressed.memoryFootprint() <
+                 static_cast<std::size_t>( n ) * sizeof( int ) );
+    auto const decompressed = compressed.decompress();
+    TEST_COMPARE_ARRAYS( toArray( decompressed ), toArray( ranks ) );
+
+    // v(i) <-- k*comm_size+i (index i, rank k)
+    Kokkos::View<int *, DeviceType> v_exp( "v", comm_size );
+    ArborX::iota( v_exp, comm_rank * comm_size );
+
+    Kokkos::View<int *, DeviceType> v_ref( "v_ref", n );
+    Kokkos::parallel_for( Kokkos::RangePolicy<ExecutionSpace>( 0, n ),
+                          KOKKOS_LAMBDA( int i ) {
+                              v_ref( i ) =
+                                  ranks( i ) * comm_size + indices( i );
+                          } );
+    Kokkos::fence();
+
+    Helper<DeviceType>::checkFetch( comm, compressed, indices, v_exp, v_ref,
+                                    success, out );
+}
+
 // Include the test macros.
 #include "DataTransferKit_ETIHelperMacros.h"
 
@@ -229,7 +277,10 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( DetailsNearestNeighborOperatorImpl, fetch,
                                           send_across_network,                 \
                                           DeviceType##NODE )                   \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( DetailsNearestNeighborOperatorImpl,  \
-                                          fetch, DeviceType##NODE )
+                                          fetch, DeviceType##NODE )            \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( DetailsNearestNeighborOperatorImpl,  \
+                                          fetch_compressed_ranks,              \
+                                          DeviceType##NODE )
 
 // Demangle the types
 DTK_ETI_MANGLING_TYPEDEFS()
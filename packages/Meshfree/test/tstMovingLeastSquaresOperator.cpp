@@ -12,10 +12,12 @@
 #include <Teuchos_UnitTestHarness.hpp>
 
 #include <DTK_DBC.hpp> // DataTransferKitException
+#include <DTK_DetailsSetupArena.hpp>
 #include <DTK_MovingLeastSquaresOperator_decl.hpp>
 #include <DTK_MovingLeastSquaresOperator_def.hpp>
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <memory>
@@ -276,6 +278,33 @@ TEUCHOS_UNIT_TEST_TEMPLATE_3_DECL( MovingLeastSquaresOperator, grid, DeviceType,
     Kokkos::deep_copy( target_values_host, target_values );
     TEST_COMPARE_FLOATING_ARRAYS( target_values_host, target_values_ref,
                                   1e-11 );
+
+    // Transfer f and 2f at once
+    Kokkos::View<double **, DeviceType> source_fields( "source_fields",
+                                                       n_source_points, 2 );
+    Kokkos::deep_copy( Kokkos::subview( source_fields, Kokkos::ALL, 0 ),
+                       source_values );
+    Kokkos::deep_copy( Kokkos::subview( source_fields, Kokkos::ALL, 1 ),
+                       source_values );
+    auto source_fields_1 = Kokkos::subview( source_fields, Kokkos::ALL, 1 );
+    Kokkos::parallel_for(
+        Kokkos::RangePolicy<typename DeviceType::execution_space>(
+            0, n_source_points ),
+        KOKKOS_LAMBDA( int i ) { source_fields_1( i ) *= 2.; } );
+    Kokkos::fence();
+    Kokkos::View<double **, DeviceType> target_fields( "target_fields",
+                                                       n_target_points, 2 );
+    mlsop.applyMany( source_fields, target_fields );
+
+    auto target_fields_host = Kokkos::create_mirror_view( target_fields );
+    Kokkos::deep_copy( target_fields_host, target_fields );
+    for ( unsigned int i = 0; i < n_target_points; ++i )
+    {
+        TEST_FLOATING_EQUALITY( target_fields_host( i, 0 ),
+                                target_values_ref[i], 1e-11 );
+        TEST_FLOATING_EQUALITY( target_fields_host( i, 1 ),
+                                2. * target_values_ref[i], 1e-11 );
+    }
 }
 
 TEUCHOS_UNIT_TEST_TEMPLATE_3_DECL( MovingLeastSquaresOperator, line, DeviceType,
@@ -420,6 +449,150 @@ TEUCHOS_UNIT_TEST_TEMPLATE_3_DECL( MovingLeastSquaresOperator,
         TEST_ASSERT( std::isfinite( target_values_host[i] ) );
 }
 
+TEUCHOS_UNIT_TEST_TEMPLATE_3_DECL( MovingLeastSquaresOperator, setup_arena,
+                                   DeviceType, RadialBasisFunction,
+                                   PolynomialBasis )
+{
+    using namespace DataTransferKit;
+    using Arena = Details::SetupArena<DeviceType>;
+
+    // The views are disjoint and aligned, and their memory is released in
+    // the reverse order.
+    std::size_t const size_a = Arena::template requiredSize<double *>( 10 );
+    std::size_t const size_b =
+        Arena::template requiredSize<Coordinate **>( 7, 3 );
+    TEST_EQUALITY( size_a % Arena::alignment, 0u );
+    TEST_ASSERT( size_a >= 10 * sizeof( double ) );
+    TEST_ASSERT( size_b >= 21 * sizeof( Coordinate ) );
+    Arena arena( size_a + size_b );
+    auto a = arena.template allocate<double *>( "a", 10 );
+    std::size_t const mark = arena.size();
+    auto b = arena.template allocate<Coordinate **>( "b", 7, 3 );
+    TEST_EQUALITY( a.extent( 0 ), 10u );
+    TEST_EQUALITY( b.extent( 0 ), 7u );
+    TEST_EQUALITY( b.extent( 1 ), 3u );
+    TEST_EQUALITY( reinterpret_cast<char *>( b.data() ) -
+                       reinterpret_cast<char *>( a.data() ),
+                   static_cast<std::ptrdiff_t>( size_a ) );
+    TEST_EQUALITY( arena.size(), size_a + size_b );
+    TEST_EQUALITY( arena.highWaterMark(), size_a + size_b );
+
+    // The views that do not fit in the arena are allocated on their own.
+    auto c = arena.template allocate<double *>( "c", 5 );
+    TEST_EQUALITY( c.extent( 0 ), 5u );
+    TEST_EQUALITY( arena.size(), size_a + size_b );
+
+    arena.rewind( mark );
+    TEST_EQUALITY( arena.size(), size_a );
+    auto d = arena.template allocate<double *>( "d", 5 );
+    TEST_EQUALITY( reinterpret_cast<char *>( d.data() ),
+                   reinterpret_cast<char *>( b.data() ) );
+    TEST_EQUALITY( arena.highWaterMark(), size_a + size_b );
+
+    // The operator reports the high-water mark of the arena of its setup.
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int const n_target_points = 10;
+    int const n_source_points_in_radius = PolynomialBasis::size;
+    std::vector<std::array<double, DIM>> source_points_arr(
+        n_target_points * n_source_points_in_radius );
+    std::vector<std::array<double, DIM>> target_points_arr( n_target_points );
+    Helper<DeviceType>::makeSourceTargetPoints(
+        source_points_arr, target_points_arr, n_source_points_in_radius, 0.5,
+        comm_rank );
+    auto source_points = Helper<DeviceType>::makePoints( source_points_arr );
+    auto target_points = Helper<DeviceType>::makePoints( target_points_arr );
+
+    MovingLeastSquaresOperator<DeviceType, RadialBasisFunction,
+                               PolynomialBasis>
+        mlsop( comm, source_points, target_points );
+    auto const &statistics = mlsop.statistics();
+    std::size_t const basis = PolynomialBasis::size;
+    std::size_t const n_fetched = n_target_points * basis;
+    TEST_ASSERT( statistics.arena_high_water_mark >=
+                 ( n_fetched * ( 3 + basis + 2 ) +
+                   2 * n_target_points * basis * basis ) *
+                     sizeof( double ) );
+    TEST_EQUALITY( statistics.peak_temporary_memory,
+                   statistics.arena_high_water_mark );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_3_DECL( MovingLeastSquaresOperator,
+                                   single_precision, DeviceType,
+                                   RadialBasisFunction, PolynomialBasis )
+{
+    using namespace DataTransferKit;
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    std::array<int, DIM> n_source_points_grid = {40, 40, 1};
+    std::array<double, DIM> offset = {0., 0., static_cast<double>( comm_rank )};
+    auto source_points_arr =
+        Helper<DeviceType>::makeGridPoints( n_source_points_grid, offset );
+
+    // The targets lie between the source points.
+    std::array<int, DIM> n_target_points_grid = {10, 10, 1};
+    offset = {10.25, 10.75, static_cast<double>( comm_rank )};
+    auto target_points_arr =
+        Helper<DeviceType>::makeGridPoints( n_target_points_grid, offset );
+
+    // Smooth field that is not reproduced exactly by the basis.
+    unsigned int const n_source_points = source_points_arr.size();
+    unsigned int const n_target_points = target_points_arr.size();
+    std::vector<double> source_values_arr( n_source_points );
+    for ( unsigned int i = 0; i < n_source_points; ++i )
+    {
+        auto const &p = source_points_arr[i];
+        source_values_arr[i] = 300. + 20. * std::sin( 0.3 * p[0] ) *
+                                          std::cos( 0.2 * p[1] );
+    }
+
+    auto source_points = Helper<DeviceType>::makePoints( source_points_arr );
+    auto source_values = Helper<DeviceType>::makeValues( source_values_arr );
+    auto target_points = Helper<DeviceType>::makePoints( target_points_arr );
+    Kokkos::View<double *, DeviceType> target_values( "target_values",
+                                                      n_target_points );
+    Kokkos::View<double *, DeviceType> target_values_float(
+        "target_values_float", n_target_points );
+
+    MovingLeastSquaresOperator<DeviceType, RadialBasisFunction,
+                               PolynomialBasis>
+        mlsop( comm, source_points, target_points );
+    mlsop.apply( source_values, target_values );
+    MovingLeastSquaresOperator<DeviceType, RadialBasisFunction,
+                               PolynomialBasis, float>
+        mlsop_float( comm, source_points, target_points );
+    mlsop_float.apply( source_values, target_values_float );
+
+    // The values and the coefficients are rounded to float, whose relative
+    // precision is 6e-8. The error grows with the number of neighbors and
+    // the magnitude of the coefficients, which may be larger than one and of
+    // both signs with a quadratic basis.
+    auto target_values_host = Kokkos::create_mirror_view( target_values );
+    Kokkos::deep_copy( target_values_host, target_values );
+    auto target_values_float_host =
+        Kokkos::create_mirror_view( target_values_float );
+    Kokkos::deep_copy( target_values_float_host, target_values_float );
+    double max_error = 0.;
+    for ( unsigned int i = 0; i < n_target_points; ++i )
+        max_error = std::max(
+            max_error, std::abs( target_values_float_host( i ) -
+                                 target_values_host( i ) ) /
+                           std::abs( target_values_host( i ) ) );
+    out << "maximum relative error with float storage: " << max_error
+        << std::endl;
+    TEST_ASSERT( max_error < 1e-5 );
+
+    // Only the values exchanged by the application are narrowed.
+    auto const &statistics = mlsop.statistics();
+    auto const &statistics_float = mlsop_float.statistics();
+    TEST_ASSERT( statistics_float.bytes_received <
+                 statistics.bytes_received );
+}
+
 // Include the test macros.
 #include "DataTransferKit_ETIHelperMacros.h"
 
@@ -471,7 +644,16 @@ using Quadratic3 =
         Wendland0, Linear3 )                                                   \
     TEUCHOS_UNIT_TEST_TEMPLATE_3_INSTANT(                                      \
         MovingLeastSquaresOperator, single_point_in_radius, DeviceType##NODE,  \
-        Wendland0, Quadratic3 )
+        Wendland0, Quadratic3 )                                                \
+    TEUCHOS_UNIT_TEST_TEMPLATE_3_INSTANT( MovingLeastSquaresOperator,          \
+                                          setup_arena, DeviceType##NODE,       \
+                                          Wendland0, Linear3 )                 \
+    TEUCHOS_UNIT_TEST_TEMPLATE_3_INSTANT( MovingLeastSquaresOperator,          \
+                                          single_precision, DeviceType##NODE,  \
+                                          Wendland0, Linear3 )                 \
+    TEUCHOS_UNIT_TEST_TEMPLATE_3_INSTANT( MovingLeastSquaresOperator,          \
+                                          single_precision, DeviceType##NODE,  \
+                                          Wendland0, Quadratic3 )
 
 // Demangle the types
 DTK_ETI_MANGLING_TYPEDEFS()
@@ -285,6 +285,62 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, one_to_one, Node )
                               success, out );
 }
 
+//---------------------------------------------------------------------------//
+// Partition the grids one-to-one with all ranks reading the files.
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator,
+                                   one_to_one_parallel_read, Node )
+{
+    // Type aliases.
+    using DeviceType = typename Node::device_type;
+    using Scalar = double;
+
+    // Get the communicator.
+    auto comm = Teuchos::DefaultComm<int>::getComm();
+
+    // Create a problem generator. Two tet meshes of a sphere centered at
+    // (0,0,0) with a radius of 10 are used. The source mesh is represented by
+    // a fine tet mesh and the target mesh is represented by a coarse tet mesh.
+    std::string src_exodus_file = "fine_sphere.exo";
+    std::string tgt_exodus_file = "coarse_sphere.exo";
+    DataTransferKit::ExodusProblemGenerator<Scalar, DeviceType, DeviceType>
+        generator(
+            *( Teuchos::rcp_dynamic_cast<Teuchos::MpiComm<int> const>( comm )
+                   ->getRawMpiComm() ),
+            src_exodus_file, tgt_exodus_file, true );
+
+    // Generate a uniquely owned problem.
+    Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft, DeviceType>
+        src_coords;
+    Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft, DeviceType>
+        tgt_coords;
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType> src_field;
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType> tgt_field;
+    generator.createUniquelyOwnedProblem( src_coords, src_field, tgt_coords,
+                                          tgt_field );
+
+    // The partitioning does not depend on which ranks read the files.
+    DataTransferKit::ExodusProblemGenerator<Scalar, DeviceType, DeviceType>
+        serial_generator(
+            *( Teuchos::rcp_dynamic_cast<Teuchos::MpiComm<int> const>( comm )
+                   ->getRawMpiComm() ),
+            src_exodus_file, tgt_exodus_file );
+    Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft, DeviceType>
+        serial_src_coords;
+    Kokkos::View<DataTransferKit::Coordinate **, Kokkos::LayoutLeft, DeviceType>
+        serial_tgt_coords;
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType> serial_src_field;
+    Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType> serial_tgt_field;
+    serial_generator.createUniquelyOwnedProblem(
+        serial_src_coords, serial_src_field, serial_tgt_coords,
+        serial_tgt_field );
+    TEST_EQUALITY( src_coords.extent( 0 ), serial_src_coords.extent( 0 ) );
+    TEST_EQUALITY( tgt_coords.extent( 0 ), serial_tgt_coords.extent( 0 ) );
+
+    // Test the problem.
+    testUniquelyOwnedProblem( src_coords, src_field, tgt_coords, tgt_field,
+                              success, out );
+}
+
 //---------------------------------------------------------------------------//
 // Partition the grids with standard ghosting from connectivity.
 TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, ghosted, Node )
@@ -391,6 +447,8 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( ExodusProblemGenerator, ghosted, Node )
 #define UNIT_TEST_GROUP( NODE )                                                \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( ExodusProblemGenerator, one_to_one,  \
                                           NODE )                               \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( ExodusProblemGenerator,              \
+                                          one_to_one_parallel_read, NODE )     \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( ExodusProblemGenerator, ghosted,     \
                                           NODE )
 
@@ -15,9 +15,12 @@
 #include <DTK_NearestNeighborOperator.hpp>
 #include <Kokkos_Core.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <numeric>
 #include <random>
+#include <string>
 #include <vector>
 
 std::vector<std::array<double, 3>>
@@ -142,6 +145,90 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, unique_source_point,
     Kokkos::deep_copy( target_values_host, target_values );
     std::vector<double> target_values_ref = {255.};
     TEST_COMPARE_ARRAYS( target_values_host, target_values_ref );
+
+    // Every rank requests a single value from rank 0. The request holds three
+    // integers and the reply holds the value and an integer.
+    auto const &statistics = nnop.statistics();
+    TEST_EQUALITY( statistics.num_applications, static_cast<std::size_t>( 1 ) );
+    for ( std::string const phase :
+          {"tree_build", "query", "apply_exchange", "contraction"} )
+        TEST_ASSERT( statistics.phase_times.count( phase ) );
+    std::size_t const served_bytes =
+        ( comm_rank == 0 ) ? comm_size * ( sizeof( double ) + sizeof( int ) )
+                           : 0;
+    TEST_EQUALITY( statistics.bytes_sent, 3 * sizeof( int ) + served_bytes );
+    TEST_EQUALITY( statistics.bytes_received,
+                   sizeof( double ) + sizeof( int ) +
+                       ( comm_rank == 0 ? comm_size * 3 * sizeof( int ) : 0 ) );
+    TEST_EQUALITY( statistics.messages_sent,
+                   3 + ( comm_rank == 0 ? 2 * comm_size : 0 ) );
+    TEST_EQUALITY( statistics.messages_received,
+                   2 + ( comm_rank == 0 ? 3 * comm_size : 0 ) );
+
+    // The operator keeps the index of the nearest neighbor, the table of the
+    // ranks, which only holds rank 0, and the position of rank 0 in the table.
+    TEST_EQUALITY( statistics.memory_footprint,
+                   2 * sizeof( int ) + sizeof( std::uint8_t ) );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, disjoint_groups,
+                                   DeviceType )
+{
+    // The source lives on the even ranks and the target on the odd ranks.
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    if ( comm_size < 2 )
+        return;
+
+    int const space_dim = 3;
+    bool const is_source = ( comm_rank % 2 == 0 );
+    int const n_source_ranks = ( comm_size + 1 ) / 2;
+    auto const role = is_source ? DataTransferKit::PointCloudRole::Source
+                                : DataTransferKit::PointCloudRole::Target;
+
+    // Each source rank holds a single point on the x-axis. Each target rank
+    // holds a point close to every source point, in reverse order.
+    Kokkos::View<double **, DeviceType> source_points(
+        "source", is_source ? 1 : 0, space_dim );
+    Kokkos::View<double **, DeviceType> target_points(
+        "target", is_source ? 0 : n_source_ranks, space_dim );
+    auto source_points_host = Kokkos::create_mirror_view( source_points );
+    for ( int i = 0; i < source_points_host.extent_int( 0 ); ++i )
+    {
+        source_points_host( i, 0 ) = comm_rank / 2;
+        source_points_host( i, 1 ) = 0.;
+        source_points_host( i, 2 ) = 0.;
+    }
+    Kokkos::deep_copy( source_points, source_points_host );
+    auto target_points_host = Kokkos::create_mirror_view( target_points );
+    for ( int i = 0; i < target_points_host.extent_int( 0 ); ++i )
+    {
+        target_points_host( i, 0 ) = n_source_ranks - 1 - i + .1;
+        target_points_host( i, 1 ) = .1;
+        target_points_host( i, 2 ) = .1;
+    }
+    Kokkos::deep_copy( target_points, target_points_host );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> nnop(
+        comm, role, source_points, target_points );
+
+    Kokkos::View<double *, DeviceType> source_values(
+        "in", source_points.extent( 0 ) );
+    Kokkos::View<double *, DeviceType> target_values(
+        "out", target_points.extent( 0 ) );
+    Kokkos::deep_copy( source_values, comm_rank / 2 );
+
+    nnop.apply( source_values, target_values );
+
+    auto target_values_host = Kokkos::create_mirror_view( target_values );
+    Kokkos::deep_copy( target_values_host, target_values );
+    std::vector<double> target_values_ref( target_values.extent( 0 ) );
+    for ( int i = 0; i < target_values.extent_int( 0 ); ++i )
+        target_values_ref[i] = n_source_ranks - 1 - i;
+    TEST_COMPARE_ARRAYS( target_values_host, target_values_ref );
 }
 
 TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, structured_clouds,
@@ -204,6 +291,40 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, structured_clouds,
     for ( unsigned int i = 0; i < n_points; ++i )
         TEST_FLOATING_EQUALITY( target_values_host( i ),
                                 target_points_host( i, 0 ), 1e-14 );
+
+    // Transfer all the coordinates at once
+    Kokkos::View<double **, DeviceType> target_coordinates(
+        "target_coordinates", n_points, 3 );
+    nnop.applyMany( source_points, target_coordinates );
+
+    auto target_coordinates_host =
+        Kokkos::create_mirror_view( target_coordinates );
+    Kokkos::deep_copy( target_coordinates_host, target_coordinates );
+    for ( unsigned int i = 0; i < n_points; ++i )
+        for ( unsigned int d = 0; d < 3; ++d )
+            TEST_FLOATING_EQUALITY( target_coordinates_host( i, d ),
+                                    target_points_host( i, d ), 1e-14 );
+
+    // The coordinates and the values may have any layout. Use blocked
+    // coordinates and transfer the y coordinates of the interleaved points
+    // in place.
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> source_points_left(
+        "source_points_left", n_points, 3 );
+    Kokkos::deep_copy( source_points_left, source_points );
+    Kokkos::View<double **, Kokkos::LayoutLeft, DeviceType> target_points_left(
+        "target_points_left", n_points, 3 );
+    Kokkos::deep_copy( target_points_left, target_points );
+    DataTransferKit::NearestNeighborOperator<DeviceType> nnop_left(
+        comm, source_points_left, target_points_left );
+
+    Kokkos::deep_copy( target_coordinates, 0. );
+    nnop_left.apply( Kokkos::subview( source_points, Kokkos::ALL, 1 ),
+                     Kokkos::subview( target_coordinates, Kokkos::ALL, 1 ) );
+
+    Kokkos::deep_copy( target_coordinates_host, target_coordinates );
+    for ( unsigned int i = 0; i < n_points; ++i )
+        TEST_FLOATING_EQUALITY( target_coordinates_host( i, 1 ),
+                                target_points_host( i, 1 ), 1e-14 );
 }
 
 TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, mixed_clouds,
@@ -268,6 +389,136 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, mixed_clouds,
     }
 }
 
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator,
+                                   repartitioned_search, DeviceType )
+{
+    // The target points of each rank fall into the source points of the next
+    // rank. They are sent there for the search and the values are written in
+    // the ordering of the caller.
+    using ExecutionSpace = typename DeviceType::execution_space;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    double const Lx = 2.;
+    double const Ly = 3.;
+    double const Lz = 5.;
+    unsigned int const nx = 7;
+    unsigned int const ny = 11;
+    unsigned int const nz = 13;
+    Kokkos::View<double **, DeviceType> source_points( "source_points" );
+    copyPointsFromCloud<DeviceType>(
+        makeStructuredCloud( Lx, Ly, Lz, nx, ny, nz, comm_rank * Lx,
+                             comm_rank * Ly, comm_rank * Lz ),
+        source_points );
+
+    // Shuffle the target points so that they are not in the order of the
+    // source points.
+    int const next_rank = ( comm_rank + 1 ) % comm_size;
+    auto target_cloud =
+        makeStructuredCloud( Lx, Ly, Lz, nx, ny, nz, next_rank * Lx,
+                             next_rank * Ly, next_rank * Lz );
+    std::shuffle( target_cloud.begin(), target_cloud.end(),
+                  std::default_random_engine( comm_rank ) );
+    Kokkos::View<double **, DeviceType> target_points( "target_points" );
+    copyPointsFromCloud<DeviceType>( target_cloud, target_points );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> nnop(
+        comm, DataTransferKit::PointCloudRole::SourceAndTarget, source_points,
+        target_points, ExecutionSpace(),
+        DataTransferKit::SearchPartition::Source );
+    TEST_ASSERT( nnop.statistics().phase_times.count( "repartition" ) );
+
+    unsigned int const n_points = target_points.extent( 0 );
+    Kokkos::View<double **, DeviceType> target_coordinates(
+        "target_coordinates", n_points, 3 );
+    nnop.applyMany( source_points, target_coordinates );
+
+    auto target_coordinates_host =
+        Kokkos::create_mirror_view( target_coordinates );
+    Kokkos::deep_copy( target_coordinates_host, target_coordinates );
+    for ( unsigned int i = 0; i < n_points; ++i )
+        for ( unsigned int d = 0; d < 3; ++d )
+            TEST_FLOATING_EQUALITY( target_coordinates_host( i, d ),
+                                    target_cloud[i][d], 1e-14 );
+}
+
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, maximum_distance,
+                                   DeviceType )
+{
+    // Each rank holds a source point on the x-axis and two target points, one
+    // close to its source point and one far from all of them.
+    using ExecutionSpace = typename DeviceType::execution_space;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    Kokkos::View<double **, DeviceType> source_points( "source", 1, 3 );
+    auto source_points_host = Kokkos::create_mirror_view( source_points );
+    source_points_host( 0, 0 ) = comm_rank;
+    source_points_host( 0, 1 ) = 0.;
+    source_points_host( 0, 2 ) = 0.;
+    Kokkos::deep_copy( source_points, source_points_host );
+    Kokkos::View<double **, DeviceType> target_points( "target", 2, 3 );
+    auto target_points_host = Kokkos::create_mirror_view( target_points );
+    target_points_host( 0, 0 ) = comm_rank;
+    target_points_host( 0, 1 ) = 100.;
+    target_points_host( 0, 2 ) = 0.;
+    target_points_host( 1, 0 ) = comm_rank + .1;
+    target_points_host( 1, 1 ) = .1;
+    target_points_host( 1, 2 ) = 0.;
+    Kokkos::deep_copy( target_points, target_points_host );
+
+    DataTransferKit::NearestNeighborOperator<DeviceType> nnop(
+        comm, DataTransferKit::PointCloudRole::SourceAndTarget, source_points,
+        target_points, .5 );
+
+    auto found_query_ids = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), nnop.foundQueryIds() );
+    std::vector<int> found_query_ids_ref = {1, -1};
+    TEST_COMPARE_ARRAYS( found_query_ids, found_query_ids_ref );
+
+    // The flagged target point is left untouched.
+    Kokkos::View<double *, DeviceType> source_values( "in", 1 );
+    Kokkos::deep_copy( source_values, comm_rank );
+    Kokkos::View<double *, DeviceType> target_values( "out", 2 );
+    Kokkos::deep_copy( target_values, -1. );
+    nnop.apply( source_values, target_values );
+
+    auto target_values_host = Kokkos::create_mirror_view( target_values );
+    Kokkos::deep_copy( target_values_host, target_values );
+    std::vector<double> target_values_ref = {-1.,
+                                             static_cast<double>( comm_rank )};
+    TEST_COMPARE_ARRAYS( target_values_host, target_values_ref );
+
+    // Or it is assigned the default value.
+    nnop.setDefaultValue( 42. );
+    Kokkos::View<double **, DeviceType> many_source_values( "in", 1, 2 );
+    Kokkos::deep_copy( many_source_values, comm_rank );
+    Kokkos::View<double **, DeviceType> many_target_values( "out", 2, 2 );
+    nnop.applyMany( many_source_values, many_target_values );
+
+    auto many_target_values_host =
+        Kokkos::create_mirror_view( many_target_values );
+    Kokkos::deep_copy( many_target_values_host, many_target_values );
+    for ( int j = 0; j < 2; ++j )
+    {
+        TEST_EQUALITY( many_target_values_host( 0, j ), 42. );
+        TEST_EQUALITY( many_target_values_host( 1, j ),
+                       static_cast<double>( comm_rank ) );
+    }
+
+    // Without maximum distance, every target point is found.
+    DataTransferKit::NearestNeighborOperator<DeviceType> unbounded_nnop(
+        comm, source_points, target_points, ExecutionSpace() );
+    auto all_query_ids = Kokkos::create_mirror_view_and_copy(
+        Kokkos::HostSpace(), unbounded_nnop.foundQueryIds() );
+    std::vector<int> all_query_ids_ref = {0, 1};
+    TEST_COMPARE_ARRAYS( all_query_ids, all_query_ids_ref );
+}
+
 // Include the test macros.
 #include "DataTransferKit_ETIHelperMacros.h"
 
@@ -276,10 +527,16 @@ TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( NearestNeighborOperator, mixed_clouds,
     using DeviceType##NODE = typename NODE::device_type;                       \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
         NearestNeighborOperator, unique_source_point, DeviceType##NODE )       \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
+        NearestNeighborOperator, disjoint_groups, DeviceType##NODE )           \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
         NearestNeighborOperator, structured_clouds, DeviceType##NODE )         \
     TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( NearestNeighborOperator,             \
-                                          mixed_clouds, DeviceType##NODE )
+                                          mixed_clouds, DeviceType##NODE )     \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
+        NearestNeighborOperator, repartitioned_search, DeviceType##NODE )      \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT(                                      \
+        NearestNeighborOperator, maximum_distance, DeviceType##NODE )
 
 // Demangle the types
 DTK_ETI_MANGLING_TYPEDEFS()
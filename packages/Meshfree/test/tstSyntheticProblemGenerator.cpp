@@ -0,0 +1,218 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include "DTK_ConfigDefs.hpp"
+#include "DTK_Types.h"
+
+#include "PointCloudProblemGenerator/SyntheticProblemGenerator.hpp"
+
+#include <Kokkos_Core.hpp>
+
+#include <Teuchos_CommHelpers.hpp>
+#include <Teuchos_DefaultComm.hpp>
+#include <Teuchos_DefaultMpiComm.hpp>
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <initializer_list>
+#include <set>
+#include <vector>
+
+//---------------------------------------------------------------------------//
+// Each rank generates its share of points in its slab and the problem is the
+// same every time it is generated.
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( SyntheticProblemGenerator, uniquely_owned,
+                                   Node )
+{
+    using DeviceType = typename Node::device_type;
+    using Scalar = double;
+    using Generator =
+        DataTransferKit::SyntheticProblemGenerator<Scalar, DeviceType,
+                                                   DeviceType>;
+    using CoordView = Kokkos::View<DataTransferKit::Coordinate **,
+                                   Kokkos::LayoutLeft, DeviceType>;
+    using FieldView = Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType>;
+
+    auto comm = Teuchos::DefaultComm<int>::getComm();
+    MPI_Comm raw_comm =
+        *( Teuchos::rcp_dynamic_cast<Teuchos::MpiComm<int> const>( comm )
+               ->getRawMpiComm() );
+    int const comm_rank = comm->getRank();
+    int const comm_size = comm->getSize();
+    double const width = 1. / comm_size;
+
+    using DataTransferKit::SyntheticDistribution;
+    for ( auto distribution :
+          {SyntheticDistribution::uniform, SyntheticDistribution::clustered,
+           SyntheticDistribution::surface, SyntheticDistribution::anisotropic} )
+    {
+        DataTransferKit::SyntheticProblemParameters parameters;
+        parameters.num_src_per_rank = 200;
+        parameters.num_tgt_per_rank = 100;
+        parameters.src_distribution = distribution;
+        parameters.tgt_distribution = distribution;
+        parameters.partition_mismatch = 0.;
+        parameters.seed = 3;
+
+        CoordView src_coords;
+        FieldView src_field;
+        CoordView tgt_coords;
+        FieldView tgt_field;
+        Generator generator( raw_comm, parameters );
+        generator.createUniquelyOwnedProblem( src_coords, src_field,
+                                              tgt_coords, tgt_field );
+        TEST_EQUALITY( src_coords.extent( 0 ), 200u );
+        TEST_EQUALITY( src_field.extent( 0 ), 200u );
+        TEST_EQUALITY( tgt_coords.extent( 0 ), 100u );
+        TEST_EQUALITY( tgt_field.extent( 0 ), 100u );
+
+        // Without mismatch, sources and targets are in the slab of the rank
+        // and the fields hold the exact values.
+        auto src_coords_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), src_coords );
+        auto src_field_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), src_field );
+        auto tgt_coords_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), tgt_coords );
+        for ( unsigned int i = 0; i < src_coords_host.extent( 0 ); ++i )
+        {
+            TEST_ASSERT( src_coords_host( i, 0 ) >= comm_rank * width );
+            TEST_ASSERT( src_coords_host( i, 0 ) <=
+                         ( comm_rank + 1 ) * width );
+            for ( int d = 1; d < 3; ++d )
+                TEST_ASSERT( 0. <= src_coords_host( i, d ) &&
+                             src_coords_host( i, d ) <= 1. );
+            TEST_FLOATING_EQUALITY(
+                src_field_host( i, 0 ),
+                Generator::field( src_coords_host( i, 0 ),
+                                  src_coords_host( i, 1 ),
+                                  src_coords_host( i, 2 ) ),
+                1e-14 );
+        }
+        for ( unsigned int i = 0; i < tgt_coords_host.extent( 0 ); ++i )
+        {
+            TEST_ASSERT( tgt_coords_host( i, 0 ) >= comm_rank * width );
+            TEST_ASSERT( tgt_coords_host( i, 0 ) <=
+                         ( comm_rank + 1 ) * width );
+        }
+
+        // The points only depend on the seed.
+        CoordView other_src_coords;
+        FieldView other_src_field;
+        CoordView other_tgt_coords;
+        FieldView other_tgt_field;
+        Generator( raw_comm, parameters )
+            .createUniquelyOwnedProblem( other_src_coords, other_src_field,
+                                         other_tgt_coords, other_tgt_field );
+        auto other_src_coords_host = Kokkos::create_mirror_view_and_copy(
+            Kokkos::HostSpace(), other_src_coords );
+        std::vector<double> expected( src_coords_host.data(),
+                                      src_coords_host.data() +
+                                          src_coords_host.size() );
+        std::vector<double> other( other_src_coords_host.data(),
+                                   other_src_coords_host.data() +
+                                       other_src_coords_host.size() );
+        TEST_COMPARE_ARRAYS( other, expected );
+    }
+}
+
+//---------------------------------------------------------------------------//
+// The ghosts are the points of the neighboring ranks within the ghost layer.
+TEUCHOS_UNIT_TEST_TEMPLATE_1_DECL( SyntheticProblemGenerator, ghosted, Node )
+{
+    using DeviceType = typename Node::device_type;
+    using Scalar = double;
+    using CoordView = Kokkos::View<DataTransferKit::Coordinate **,
+                                   Kokkos::LayoutLeft, DeviceType>;
+    using GidView =
+        Kokkos::View<DataTransferKit::GlobalOrdinal *, Kokkos::LayoutLeft,
+                     DeviceType>;
+    using FieldView = Kokkos::View<Scalar **, Kokkos::LayoutLeft, DeviceType>;
+
+    auto comm = Teuchos::DefaultComm<int>::getComm();
+    MPI_Comm raw_comm =
+        *( Teuchos::rcp_dynamic_cast<Teuchos::MpiComm<int> const>( comm )
+               ->getRawMpiComm() );
+    int const comm_rank = comm->getRank();
+    int const comm_size = comm->getSize();
+    double const width = 1. / comm_size;
+
+    DataTransferKit::SyntheticProblemParameters parameters;
+    parameters.num_src_per_rank = 500;
+    parameters.num_tgt_per_rank = 300;
+    parameters.partition_mismatch = 0.;
+    parameters.ghost_fraction = 0.2;
+    DataTransferKit::SyntheticProblemGenerator<Scalar, DeviceType, DeviceType>
+        generator( raw_comm, parameters );
+
+    CoordView src_coords;
+    GidView src_gids;
+    FieldView src_field;
+    CoordView tgt_coords;
+    GidView tgt_gids;
+    FieldView tgt_field;
+    generator.createGhostedProblem( src_coords, src_gids, src_field,
+                                    tgt_coords, tgt_gids, tgt_field );
+
+    // The local points come first and are followed by the ghosts.
+    auto src_coords_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), src_coords );
+    auto src_gids_host =
+        Kokkos::create_mirror_view_and_copy( Kokkos::HostSpace(), src_gids );
+    int const num_src = src_gids_host.extent( 0 );
+    TEST_ASSERT( num_src >= 500 );
+    if ( comm_size == 1 )
+        TEST_EQUALITY( num_src, 500 );
+    std::set<DataTransferKit::GlobalOrdinal> unique_gids;
+    for ( int i = 0; i < num_src; ++i )
+    {
+        unique_gids.insert( src_gids_host( i ) );
+        double const x = src_coords_host( i, 0 );
+        if ( i < 500 )
+        {
+            TEST_EQUALITY( src_gids_host( i ), comm_rank * 500 + i + 1 );
+        }
+        else
+        {
+            TEST_ASSERT( src_gids_host( i ) <= comm_rank * 500 ||
+                         src_gids_host( i ) > ( comm_rank + 1 ) * 500 );
+            TEST_ASSERT( x >= ( comm_rank - 0.2 ) * width &&
+                         x <= ( comm_rank + 1.2 ) * width );
+        }
+    }
+    TEST_EQUALITY( static_cast<int>( unique_gids.size() ), num_src );
+
+    // Neighboring ranks share points.
+    int num_ghosts = num_src - 500;
+    int global_num_ghosts = 0;
+    Teuchos::reduceAll( *comm, Teuchos::REDUCE_SUM, num_ghosts,
+                        Teuchos::ptrFromRef( global_num_ghosts ) );
+    if ( comm_size > 1 )
+        TEST_ASSERT( global_num_ghosts > 0 );
+    TEST_EQUALITY( tgt_field.extent( 0 ), tgt_coords.extent( 0 ) );
+}
+
+//---------------------------------------------------------------------------//
+
+// Include the test macros.
+#include "DataTransferKit_ETIHelperMacros.h"
+
+// Create the test group
+#define UNIT_TEST_GROUP( NODE )                                                \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( SyntheticProblemGenerator,           \
+                                          uniquely_owned, NODE )               \
+    TEUCHOS_UNIT_TEST_TEMPLATE_1_INSTANT( SyntheticProblemGenerator, ghosted,  \
+                                          NODE )
+
+// Demangle the types
+DTK_ETI_MANGLING_TYPEDEFS()
+
+// Instantiate the tests
+DTK_INSTANTIATE_N( UNIT_TEST_GROUP )
@@ -10,6 +10,9 @@
  ****************************************************************************/
 #include "DTK_Core.hpp"
 #include "DTK_DBC.hpp"
+#include "DTK_Tracing.hpp"
+
+#include <cstdlib>
 
 namespace DataTransferKit
 {
@@ -60,7 +63,11 @@ template <typename... Args>
 void initialize( Args &&... args )
 {
     if ( !dtkIsInitialized )
+    {
         initKokkos( std::forward<Args>( args )... );
+        if ( char const *trace_file = std::getenv( "DTK_TRACE_FILE" ) )
+            enableTracing( trace_file );
+    }
     dtkIsInitialized = true;
 }
 
@@ -71,6 +78,8 @@ void finalize()
     if ( !dtkIsInitialized )
         return;
 
+    Details::finalizeTracing();
+
     // DTK should only finalize Kokkos if it initialized it
     if ( dtkInitializedKokkos )
         Kokkos::finalize();
@@ -25,7 +25,9 @@ namespace DataTransferKit
 
 /*! Initialize DTK
  *
- * Will initialize Kokkos if it was not previously initialized.
+ * Will initialize Kokkos if it was not previously initialized. Will enable
+ * tracing if the environment variable DTK_TRACE_FILE is set (see
+ * enableTracing()).
  */
 template <typename... Args>
 void initialize( Args &&... args );
@@ -35,7 +37,9 @@ bool isInitialized();
 
 /*! Finalize DTK
  *
- * Will finalize Kokkos if it was initialized by DTK.
+ * Will finalize Kokkos if it was initialized by DTK. Will write the trace if
+ * tracing is enabled, in which case this is a collective over
+ * MPI_COMM_WORLD.
  */
 
 void finalize();
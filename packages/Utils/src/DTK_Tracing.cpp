@@ -0,0 +1,271 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+#include "DTK_Tracing.hpp"
+#include "DTK_DBC.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace DataTransferKit
+{
+namespace
+{ // anonymous
+
+struct TraceEvent
+{
+    char name[64];
+    int thread;
+    // Nanoseconds since the tracing was enabled.
+    std::int64_t begin;
+    std::int64_t duration;
+};
+
+// Slot of the ring buffer. Its sequence is one more than the number of the
+// event it holds, zero while it is empty, and busy_slot while an event is
+// being written to it.
+struct TraceSlot
+{
+    std::atomic<std::size_t> sequence;
+    TraceEvent event;
+};
+
+std::size_t constexpr busy_slot = std::numeric_limits<std::size_t>::max();
+
+// The events are numbered in turn and written to the slot of their number
+// modulo the capacity. The buffer is only freed or replaced once the threads
+// writing to it are done.
+std::unique_ptr<TraceSlot[]> trace_slots;
+std::size_t trace_capacity = 0;
+std::atomic<std::size_t> num_trace_events( 0 );
+std::atomic<int> num_trace_writers( 0 );
+std::chrono::steady_clock::time_point trace_epoch;
+std::string trace_filename;
+// Rank in MPI_COMM_WORLD, or process id when MPI was not initialized, when
+// the tracing was enabled.
+int trace_process_id = 0;
+std::atomic<int> num_traced_threads( 0 );
+
+std::int64_t nanoseconds( std::chrono::steady_clock::duration duration )
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>( duration )
+        .count();
+}
+
+// Small identifier of the calling thread.
+int traceThreadId()
+{
+    thread_local int const id = num_traced_threads++;
+    return id;
+}
+
+// Wait for the threads recording a region. Once the tracing is disabled, no
+// other thread starts writing to the buffer.
+void waitForTraceWriters()
+{
+    while ( num_trace_writers.load() > 0 )
+        std::this_thread::yield();
+}
+
+// Events held by the buffer, the oldest first. The events that are being
+// written or that were overwritten while they were read are skipped.
+std::vector<TraceEvent> recordedEvents()
+{
+    std::vector<TraceEvent> events;
+    std::size_t const capacity = trace_capacity;
+    if ( capacity == 0 )
+        return events;
+    std::size_t const n = num_trace_events.load();
+    for ( std::size_t i = ( n > capacity ) ? n - capacity : 0; i < n; ++i )
+    {
+        auto const &slot = trace_slots[i % capacity];
+        if ( slot.sequence.load( std::memory_order_acquire ) != i + 1 )
+            continue;
+        TraceEvent const event = slot.event;
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if ( slot.sequence.load( std::memory_order_relaxed ) == i + 1 )
+            events.push_back( event );
+    }
+    return events;
+}
+
+// Write the events of a rank as comma-separated Chrome trace events. The
+// timestamps are shifted by offset and converted to microseconds.
+std::string formatEvents( std::vector<TraceEvent> const &events, int rank,
+                          std::int64_t offset )
+{
+    std::ostringstream os;
+    os << std::fixed << std::setprecision( 3 );
+    os << R"({"name":"process_name","ph":"M","pid":)" << rank
+       << R"(,"args":{"name":"rank )" << rank << R"("}})";
+    for ( auto const &event : events )
+        os << R"(,{"name":")" << event.name << R"(","ph":"X","pid":)" << rank
+           << R"(,"tid":)" << event.thread << R"(,"ts":)"
+           << ( event.begin - offset ) * 1e-3 << R"(,"dur":)"
+           << event.duration * 1e-3 << '}';
+    return os.str();
+}
+
+void writeTraceFile( std::string const &filename, std::string const &events )
+{
+    std::ofstream file( filename );
+    DTK_INSIST( file.good() );
+    file << R"({"traceEvents":[)" << events << R"(],"displayTimeUnit":"ms"})"
+         << '\n';
+}
+
+} // namespace
+
+std::atomic<bool> Details::tracing_enabled( false );
+
+void enableTracing( std::string const &filename, std::size_t capacity )
+{
+    DTK_REQUIRE( capacity > 0 );
+    Details::tracing_enabled.store( false );
+    waitForTraceWriters();
+    trace_slots.reset( new TraceSlot[capacity] );
+    for ( std::size_t i = 0; i < capacity; ++i )
+        trace_slots[i].sequence.store( 0, std::memory_order_relaxed );
+    trace_capacity = capacity;
+    num_trace_events.store( 0 );
+    trace_epoch = std::chrono::steady_clock::now();
+    trace_filename = filename;
+    int mpi_initialized;
+    MPI_Initialized( &mpi_initialized );
+    int mpi_finalized;
+    MPI_Finalized( &mpi_finalized );
+    if ( mpi_initialized && !mpi_finalized )
+        MPI_Comm_rank( MPI_COMM_WORLD, &trace_process_id );
+    else
+        trace_process_id = getpid();
+    Details::tracing_enabled.store( true, std::memory_order_release );
+}
+
+bool isTracingEnabled() { return Details::tracing_enabled.load(); }
+
+void Details::recordTraceRegion( char const *name,
+                                 std::chrono::steady_clock::time_point begin,
+                                 std::chrono::steady_clock::time_point end )
+{
+    // Register the thread as a writer before checking that the tracing is
+    // still enabled, so that finalizeTracing() either waits for it or is
+    // seen by it. The region is dropped when it began before the trace was
+    // finalized.
+    num_trace_writers.fetch_add( 1 );
+    if ( !isTracingEnabled() )
+    {
+        num_trace_writers.fetch_sub( 1 );
+        return;
+    }
+
+    // Lock the slot of the event. The event is dropped when a thread that
+    // wrapped around the buffer is writing to the same slot or already
+    // wrote a newer event to it.
+    std::size_t const i =
+        num_trace_events.fetch_add( 1, std::memory_order_relaxed );
+    auto &slot = trace_slots[i % trace_capacity];
+    std::size_t sequence = slot.sequence.load( std::memory_order_relaxed );
+    if ( sequence != busy_slot && sequence <= i &&
+         slot.sequence.compare_exchange_strong( sequence, busy_slot,
+                                                std::memory_order_acquire ) )
+    {
+        auto &event = slot.event;
+        std::strncpy( event.name, name, sizeof( event.name ) - 1 );
+        event.name[sizeof( event.name ) - 1] = '\0';
+        event.thread = traceThreadId();
+        event.begin = nanoseconds( begin - trace_epoch );
+        event.duration = nanoseconds( end - begin );
+        slot.sequence.store( i + 1, std::memory_order_release );
+    }
+    num_trace_writers.fetch_sub( 1, std::memory_order_release );
+}
+
+void writeTrace( MPI_Comm comm, std::string const &filename )
+{
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // Take the exit of a barrier as the common time origin, then shift the
+    // timestamps so that the earliest one is zero.
+    auto const events = recordedEvents();
+    MPI_Barrier( comm );
+    std::int64_t const sync =
+        nanoseconds( std::chrono::steady_clock::now() - trace_epoch );
+    std::int64_t earliest = 0;
+    for ( auto const &event : events )
+        earliest = std::min( earliest, event.begin - sync );
+    std::int64_t global_earliest;
+    MPI_Allreduce( &earliest, &global_earliest, 1, MPI_INT64_T, MPI_MIN,
+                   comm );
+    std::string const local_events =
+        formatEvents( events, comm_rank, sync + global_earliest );
+
+    int const size = local_events.size();
+    std::vector<int> sizes( comm_size );
+    MPI_Gather( &size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm );
+    std::vector<int> displs( comm_size + 1, 0 );
+    std::partial_sum( sizes.begin(), sizes.end(), displs.begin() + 1 );
+    std::vector<char> all_events( displs.back() );
+    MPI_Gatherv( const_cast<char *>( local_events.data() ), size, MPI_CHAR,
+                 all_events.data(), sizes.data(), displs.data(), MPI_CHAR, 0,
+                 comm );
+
+    if ( comm_rank == 0 )
+    {
+        std::string joined_events;
+        for ( int r = 0; r < comm_size; ++r )
+        {
+            if ( r > 0 )
+                joined_events += ',';
+            joined_events.append( all_events.data() + displs[r], sizes[r] );
+        }
+        writeTraceFile( filename, joined_events );
+    }
+}
+
+void Details::finalizeTracing()
+{
+    if ( !isTracingEnabled() )
+        return;
+    Details::tracing_enabled.store( false );
+    waitForTraceWriters();
+
+    // The ranks can only be merged while MPI is usable. Otherwise, each
+    // process writes its own regions to a file of its own.
+    int mpi_initialized;
+    MPI_Initialized( &mpi_initialized );
+    int mpi_finalized;
+    MPI_Finalized( &mpi_finalized );
+    if ( mpi_initialized && !mpi_finalized )
+        writeTrace( MPI_COMM_WORLD, trace_filename );
+    else
+        writeTraceFile(
+            trace_filename + '.' + std::to_string( trace_process_id ),
+            formatEvents( recordedEvents(), trace_process_id, 0 ) );
+
+    trace_slots.reset();
+    trace_capacity = 0;
+    num_trace_events.store( 0 );
+}
+
+} // namespace DataTransferKit
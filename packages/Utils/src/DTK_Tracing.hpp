@@ -0,0 +1,117 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+/*!
+ * \file
+ * \brief Timeline of the regions of DTK across ranks.
+ */
+#ifndef DTK_TRACING_HPP
+#define DTK_TRACING_HPP
+
+#include <mpi.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+namespace DataTransferKit
+{
+
+/*! Enable the tracing of the regions of DTK
+ *
+ * The beginning and the duration of the regions are recorded on each rank in
+ * a preallocated ring buffer holding up to \p capacity regions. The oldest
+ * regions are overwritten when it is full. finalize() merges the regions of
+ * all the ranks into a single Chrome trace written to \p filename, which can
+ * be displayed with chrome://tracing or Perfetto. When MPI is already
+ * finalized, each process writes its own regions to \p filename suffixed
+ * with its rank, or with its process id if MPI was not initialized when the
+ * tracing was enabled.
+ *
+ * initialize() enables the tracing when the environment variable
+ * DTK_TRACE_FILE is set, with its value as the file name.
+ */
+void enableTracing( std::string const &filename,
+                    std::size_t capacity = 1 << 16 );
+
+/*! Whether the regions are being recorded */
+bool isTracingEnabled();
+
+/*! Write the regions recorded on the ranks of \p comm to a Chrome trace
+ *
+ * Each rank is shown as a process. The clocks of the ranks are aligned at a
+ * barrier. This is a collective over \p comm and the file is written by its
+ * rank 0.
+ */
+void writeTrace( MPI_Comm comm, std::string const &filename );
+
+namespace Details
+{
+extern std::atomic<bool> tracing_enabled;
+
+void recordTraceRegion( char const *name,
+                        std::chrono::steady_clock::time_point begin,
+                        std::chrono::steady_clock::time_point end );
+
+// Stop recording and write the trace to the file given to enableTracing().
+// Called by finalize().
+void finalizeTracing();
+} // namespace Details
+
+/*! Region recorded from its construction to its destruction
+ *
+ * The region may also be ended earlier with stop(). The name must outlive
+ * the region. When tracing is disabled, the region only costs an atomic load.
+ */
+class TraceRegion
+{
+  public:
+    explicit TraceRegion( char const *name )
+        : _name( name )
+        , _recording(
+              Details::tracing_enabled.load( std::memory_order_acquire ) )
+    {
+        if ( _recording )
+            _begin = std::chrono::steady_clock::now();
+    }
+
+    TraceRegion( TraceRegion const & ) = delete;
+    TraceRegion &operator=( TraceRegion const & ) = delete;
+
+    ~TraceRegion() { stop(); }
+
+    void stop()
+    {
+        if ( !_recording )
+            return;
+        Details::recordTraceRegion( _name, _begin,
+                                    std::chrono::steady_clock::now() );
+        _recording = false;
+    }
+
+  private:
+    char const *_name;
+    bool _recording;
+    std::chrono::steady_clock::time_point _begin;
+};
+
+#define DTK_TRACE_CONCAT_IMPL( x, y ) x##y
+#define DTK_TRACE_CONCAT( x, y ) DTK_TRACE_CONCAT_IMPL( x, y )
+
+// Record the rest of the enclosing scope as a region named after the string
+// literal x, with the same prefix as DTK_MARK_REGION.
+#define DTK_TRACE_REGION( x )                                                  \
+    DataTransferKit::TraceRegion DTK_TRACE_CONCAT( dtk_trace_region_,          \
+                                                   __LINE__ )( "DTK_" x )
+
+} // namespace DataTransferKit
+
+#endif // DTK_TRACING_HPP
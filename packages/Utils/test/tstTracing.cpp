@@ -0,0 +1,132 @@
+/****************************************************************************
+ * Copyright (c) 2012-2019 by the DataTransferKit authors                   *
+ * All rights reserved.                                                     *
+ *                                                                          *
+ * This file is part of the DataTransferKit library. DataTransferKit is     *
+ * distributed under a BSD 3-clause license. For the licensing terms see    *
+ * the LICENSE file in the top-level directory.                             *
+ *                                                                          *
+ * SPDX-License-Identifier: BSD-3-Clause                                    *
+ ****************************************************************************/
+
+#include <DTK_Tracing.hpp>
+
+#include <Teuchos_UnitTestHarness.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+int countOccurrences( std::string const &str, std::string const &pattern )
+{
+    int count = 0;
+    for ( auto pos = str.find( pattern ); pos != std::string::npos;
+          pos = str.find( pattern, pos + pattern.size() ) )
+        ++count;
+    return count;
+}
+} // namespace
+
+TEUCHOS_UNIT_TEST( DataTransferKitTracing, merge_ranks )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+    int comm_size;
+    MPI_Comm_size( comm, &comm_size );
+
+    // Nothing is recorded until tracing is enabled.
+    TEST_ASSERT( !DataTransferKit::isTracingEnabled() );
+    {
+        DTK_TRACE_REGION( "ignored" );
+    }
+
+    // The buffer holds the last four regions.
+    std::string const filename = "tstTracing.json";
+    DataTransferKit::enableTracing( filename, 4 );
+    TEST_ASSERT( DataTransferKit::isTracingEnabled() );
+    for ( char const *name :
+          {"DTK_first", "DTK_second", "DTK_third", "DTK_fourth", "DTK_last"} )
+    {
+        DataTransferKit::TraceRegion region( name );
+    }
+    {
+        DTK_TRACE_REGION( "nested" );
+        DataTransferKit::TraceRegion stopped( "DTK_stopped" );
+        stopped.stop();
+    }
+
+    DataTransferKit::writeTrace( comm, filename );
+    if ( comm_rank == 0 )
+    {
+        std::ifstream file( filename );
+        std::stringstream ss;
+        ss << file.rdbuf();
+        std::string const trace = ss.str();
+        TEST_EQUALITY( trace.find( R"({"traceEvents":[)" ), 0u );
+        TEST_EQUALITY( countOccurrences( trace, R"("ph":"X")" ),
+                       4 * comm_size );
+        TEST_EQUALITY( countOccurrences( trace, R"("name":"process_name")" ),
+                       comm_size );
+        TEST_EQUALITY( countOccurrences( trace, "DTK_last" ), comm_size );
+        TEST_EQUALITY( countOccurrences( trace, "DTK_nested" ), comm_size );
+        TEST_EQUALITY( countOccurrences( trace, "DTK_second" ), 0 );
+        TEST_EQUALITY( countOccurrences( trace, "DTK_ignored" ), 0 );
+        TEST_INEQUALITY(
+            trace.find( "\"rank " + std::to_string( comm_size - 1 ) + "\"" ),
+            std::string::npos );
+    }
+
+    // Finalizing writes the trace again and stops the recording.
+    DataTransferKit::Details::finalizeTracing();
+    TEST_ASSERT( !DataTransferKit::isTracingEnabled() );
+    MPI_Barrier( comm );
+    if ( comm_rank == 0 )
+        std::remove( filename.c_str() );
+}
+
+TEUCHOS_UNIT_TEST( DataTransferKitTracing, concurrent_regions )
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int comm_rank;
+    MPI_Comm_rank( comm, &comm_rank );
+
+    // Several threads wrap around a small buffer while the trace is
+    // finalized. The regions that end after it are dropped.
+    std::string const filename = "tstTracingConcurrent.json";
+    DataTransferKit::enableTracing( filename, 8 );
+    DataTransferKit::TraceRegion open( "DTK_open" );
+    std::vector<std::thread> threads;
+    for ( int t = 0; t < 4; ++t )
+        threads.emplace_back( [] {
+            for ( int i = 0; i < 10000; ++i )
+            {
+                DTK_TRACE_REGION( "concurrent" );
+            }
+        } );
+    DataTransferKit::Details::finalizeTracing();
+    for ( auto &thread : threads )
+        thread.join();
+    open.stop();
+    TEST_ASSERT( !DataTransferKit::isTracingEnabled() );
+
+    if ( comm_rank == 0 )
+    {
+        std::ifstream file( filename );
+        std::stringstream ss;
+        ss << file.rdbuf();
+        std::string const trace = ss.str();
+        TEST_EQUALITY( trace.find( R"({"traceEvents":[)" ), 0u );
+        TEST_COMPARE( countOccurrences( trace, R"("ph":"X")" ), <=,
+                      8 * countOccurrences( trace, "process_name" ) );
+        TEST_EQUALITY( countOccurrences( trace, "DTK_open" ), 0 );
+    }
+    MPI_Barrier( comm );
+    if ( comm_rank == 0 )
+        std::remove( filename.c_str() );
+}